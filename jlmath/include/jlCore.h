@@ -63,10 +63,49 @@
 #	define JL_RESTRICT __restrict__
 #endif
 
+/// Lets literal constants and constructors be evaluated at compile time
+/// on toolchains with C++11 constexpr (VS2015+, gcc in c++11 mode)
+#if (JL_COMPILER == JL_COMPILER_MSVC && _MSC_VER >= 1900) || (JL_COMPILER == JL_COMPILER_GCC && __cplusplus >= 201103L)
+#	define JL_CONSTEXPR_ENABLED 1
+#	define JL_CONSTEXPR constexpr
+#else
+#	define JL_CONSTEXPR_ENABLED 0
+#	define JL_CONSTEXPR
+#endif
+
+/// Atomically sets *ptr to exchange if it equals comparand, returns the old value
+/// Full memory barrier on both compilers, ptr is a volatile int32 * or for
+/// the 64 bit form a volatile uint64 *.  JL_ATOMIC_ADD returns the old value.
+#if (JL_COMPILER == JL_COMPILER_MSVC)
+#	include <intrin.h>
+#	pragma intrinsic(_InterlockedCompareExchange)
+#	pragma intrinsic(_InterlockedCompareExchange64)
+#	pragma intrinsic(_InterlockedExchangeAdd)
+#	define JL_ATOMIC_COMPARE_EXCHANGE(ptr, exchange, comparand) \
+	static_cast<int32>(_InterlockedCompareExchange(reinterpret_cast<volatile long *>(ptr), (exchange), (comparand)))
+#	define JL_ATOMIC_COMPARE_EXCHANGE64(ptr, exchange, comparand) \
+	static_cast<uint64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64 *>(ptr), (exchange), (comparand)))
+#	define JL_ATOMIC_ADD(ptr, value) \
+	static_cast<int32>(_InterlockedExchangeAdd(reinterpret_cast<volatile long *>(ptr), (value)))
+#else
+#	define JL_ATOMIC_COMPARE_EXCHANGE(ptr, exchange, comparand) \
+	__sync_val_compare_and_swap((ptr), (comparand), (exchange))
+#	define JL_ATOMIC_COMPARE_EXCHANGE64(ptr, exchange, comparand) \
+	__sync_val_compare_and_swap((ptr), (comparand), (exchange))
+#	define JL_ATOMIC_ADD(ptr, value) \
+	__sync_fetch_and_add((ptr), (value))
+#endif
+
 // DETERMINE TYPES
 #include "util/jlTypes.h"
 
 // CUSTOM MEMORY ALLOCATORS
+/// Define as 1 for small JL_DECLARE_ALIGNED_ALLOC_OBJECT types to come
+/// from the aligned block cache.  Off by default, runAlignedCacheBenchmark
+/// has it slower than jlAllocAligned on the heaps measured so far.
+#ifndef JL_USE_ALIGNED_BLOCK_CACHE
+#	define JL_USE_ALIGNED_BLOCK_CACHE 0
+#endif
 #include "util/jlMemory.h"
 
 // DEBUG MODE
@@ -8,6 +8,8 @@
 #include "math/jlSimdFloat.h"
 #include <cmath>
 
+class jlVector4;
+
 /// Custom math functions for more control and optimization opportunities
 /// Gives scope to custom math calls and support for our custom typedefs
 /// Gives us the possibility to implement platform specific instructions and 
@@ -15,6 +17,35 @@
 /// Caches frequently used variables (e.g. LOG2) and lookup tables for trig functions
 class jlMath {
 public:
+	/// Accuracy tiers of the lane parallel trig functions, the measured 
+	/// max error of each function is listed with its kernel
+	enum Accuracy {
+		ACCURACY_FULL,		///< about 1 ulp
+		ACCURACY_MEDIUM,	///< about 1e-4
+		ACCURACY_LOW		///< about 1e-2
+	};
+
+	/// Precision of the lane parallel reciprocal and reciprocal square root
+	/// The Newton tiers refine the 12 bit hardware estimate, they return
+	/// NaN for zero and infinite lanes so mask those out if they can occur
+	enum Precision {
+		PRECISION_RAW,			///< hardware estimate, about 12 bits
+		PRECISION_ONE_NEWTON,	///< one Newton-Raphson step, about 22 bits
+		PRECISION_TWO_NEWTON,	///< two steps, within 1.5 ulp
+		PRECISION_IEEE			///< divide and sqrt, correctly rounded
+	};
+
+#if JL_CONSTEXPR_ENABLED
+	static constexpr float32 PI = 3.14159265358979323846f;
+	static constexpr float32 TWO_PI = 6.28318530717958647692f;
+	static constexpr float32 PI_OVER_TWO = 1.57079632679489661923f;
+	static constexpr float32 PI_OVER_FOUR = 0.785398163397448309616f;
+	static constexpr float32 ONE_OVER_PI = 0.318309886183790671538f;
+	static constexpr float32 ONE_OVER_TWO_PI = 0.159154943091895335769f;
+	static constexpr float32 DEG2RAD = 0.0174532925199432957692f;
+	static constexpr float32 RAD2DEG = 57.2957795130823208768f;
+	static constexpr float32 LOG2 = 0.693147180559945309417f;
+#else
 	static const float32 PI;
 	static const float32 TWO_PI;
 	static const float32 PI_OVER_TWO;
@@ -24,6 +55,7 @@ public:
 	static const float32 DEG2RAD;
 	static const float32 RAD2DEG;
 	static const float32 LOG2;
+#endif
 	static const int32 DEFAULT_TRIG_TABLE_SIZE;
 
 	// trig functions
@@ -36,11 +68,48 @@ public:
 	static float32 ACos(float32 x);
 	static float32 ATan(float32 x);
 	static float32 ATan2(float32 y, float32 x);
+	static void SinCos(float32 x, float32 *s, float32 *c);
+
+	// lane parallel trig functions, untemplated versions are ACCURACY_FULL
+	static jlSimdFloat Sin(const jlSimdFloat& x);
+	static jlSimdFloat Cos(const jlSimdFloat& x);
+	static jlSimdFloat Tan(const jlSimdFloat& x);
+	static jlSimdFloat ASin(const jlSimdFloat& x);
+	static jlSimdFloat ACos(const jlSimdFloat& x);
+	static jlSimdFloat ATan(const jlSimdFloat& x);
+	static jlSimdFloat ATan2(const jlSimdFloat& y, const jlSimdFloat& x);
+	static jlVector4 Sin(const jlVector4& x);
+	static jlVector4 Cos(const jlVector4& x);
+	static jlVector4 Tan(const jlVector4& x);
+	static jlVector4 ASin(const jlVector4& x);
+	static jlVector4 ACos(const jlVector4& x);
+	static jlVector4 ATan(const jlVector4& x);
+	static jlVector4 ATan2(const jlVector4& y, const jlVector4& x);
+	/// Sine and cosine of the same angles, sharing one range reduction
+	static void SinCos(const jlSimdFloat& x, jlSimdFloat *s, jlSimdFloat *c);
+	static void SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c);
+	template <Accuracy A> static jlSimdFloat Sin(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Cos(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Tan(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat ASin(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat ACos(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat ATan(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat ATan2(const jlSimdFloat& y, const jlSimdFloat& x);
+	template <Accuracy A> static jlVector4 Sin(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Cos(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Tan(const jlVector4& x);
+	template <Accuracy A> static jlVector4 ASin(const jlVector4& x);
+	template <Accuracy A> static jlVector4 ACos(const jlVector4& x);
+	template <Accuracy A> static jlVector4 ATan(const jlVector4& x);
+	template <Accuracy A> static jlVector4 ATan2(const jlVector4& y, const jlVector4& x);
+	template <Accuracy A> static void SinCos(const jlSimdFloat& x, jlSimdFloat *s, jlSimdFloat *c);
+	template <Accuracy A> static void SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c);
+
 	static float32 DegreesToRadians(float32 deg);
 	static float32 RadiansToDegrees(float32 rad);
 	static float32 WrapAngle(float32 x);
 
-	// trig lookup tables
+	// trig lookup tables, these go through jlTrigTable::GetDefault
 	static jlResult SetupTrigTables(int32 tableSize = DEFAULT_TRIG_TABLE_SIZE);
 	static jlResult UnloadTrigTables();
 	static float32 Cos(float32 x, bool8 useTable);
@@ -62,6 +131,33 @@ public:
 	template<typename T> static T Clamp(T x, T min, T max);
 	static float32 Floor(float32 x);
 	static float32 Ceil(float32 x);
+
+	// lane parallel rounding, Round goes to the nearest even whatever the
+	// MXCSR rounding mode
+	static jlSimdFloat Floor(const jlSimdFloat& x);
+	static jlSimdFloat Ceil(const jlSimdFloat& x);
+	static jlSimdFloat Round(const jlSimdFloat& x);
+	static jlSimdFloat Trunc(const jlSimdFloat& x);
+	static jlSimdFloat Fract(const jlSimdFloat& x);
+	static jlSimdFloat Mod(const jlSimdFloat& x, const jlSimdFloat& y);
+	static jlSimdFloat WrapAngle(const jlSimdFloat& x);
+	static jlVector4 Floor(const jlVector4& x);
+	static jlVector4 Ceil(const jlVector4& x);
+	static jlVector4 Round(const jlVector4& x);
+	static jlVector4 Trunc(const jlVector4& x);
+	static jlVector4 Fract(const jlVector4& x);
+	static jlVector4 Mod(const jlVector4& x, const jlVector4& y);
+	static jlVector4 WrapAngle(const jlVector4& x);
+
+	// float to int conversion, lanes outside the int32 range are undefined
+	static int32 TruncToInt(const jlSimdFloat& x);
+	static int32 RoundToInt(const jlSimdFloat& x);
+	static int32 FloorToInt(const jlSimdFloat& x);
+	static quadint128 TruncToInt(const jlVector4& x);
+	static quadint128 RoundToInt(const jlVector4& x);
+	static quadint128 FloorToInt(const jlVector4& x);
+	static jlVector4 ToFloat(const quadint128& x);
+
 	static float32 Min(float32 x, float32 y);
 	static jlSimdFloat Min(const jlSimdFloat& x, const jlSimdFloat& y);
 	static int32 IMin(int32 x, int32 y);
@@ -78,16 +174,51 @@ public:
 	// pow, sqrt, log
 	static float32 Pow(float32 x, float32 power);
 	static float32 Pow(float32 x, int32 power);
+	template <int32 N, typename T> static T Pow(const T& x);
 	static bool32 IsPowerOf2(int32 x);
 	static int32 NearestPowerOf2(int32 x);
 	static float32 Sqrt(float32 x);
 	static jlSimdFloat Sqrt(const jlSimdFloat& x);
+	static jlVector4 Sqrt(const jlVector4& x);
 	static float32 InvSqrt(float32 x);
-	static jlSimdFloat InvSqrt(const jlSimdFloat& x);
 	static float32 FastInvSqrt(float32 x);
+
+	// lane parallel reciprocal/rsqrt, untemplated versions are PRECISION_IEEE
+	static jlSimdFloat Reciprocal(const jlSimdFloat& x);
+	static jlSimdFloat InvSqrt(const jlSimdFloat& x);
+	static jlVector4 Reciprocal(const jlVector4& x);
+	static jlVector4 InvSqrt(const jlVector4& x);
+	template <Precision P> static jlSimdFloat Reciprocal(const jlSimdFloat& x);
+	template <Precision P> static jlSimdFloat InvSqrt(const jlSimdFloat& x);
+	template <Precision P> static jlVector4 Reciprocal(const jlVector4& x);
+	template <Precision P> static jlVector4 InvSqrt(const jlVector4& x);
 	static float32 Log(float32 x);
 	static float32 Log2(float32 x);
 	static float32 LogN(float32 x, float32 n);
+	static float32 Exp(float32 x);
+	static float32 Exp2(float32 x);
+
+	// lane parallel exp/log/pow, untemplated versions are ACCURACY_FULL
+	static jlSimdFloat Exp(const jlSimdFloat& x);
+	static jlSimdFloat Exp2(const jlSimdFloat& x);
+	static jlSimdFloat Log(const jlSimdFloat& x);
+	static jlSimdFloat Log2(const jlSimdFloat& x);
+	static jlSimdFloat Pow(const jlSimdFloat& x, const jlSimdFloat& y);
+	static jlVector4 Exp(const jlVector4& x);
+	static jlVector4 Exp2(const jlVector4& x);
+	static jlVector4 Log(const jlVector4& x);
+	static jlVector4 Log2(const jlVector4& x);
+	static jlVector4 Pow(const jlVector4& x, const jlVector4& y);
+	template <Accuracy A> static jlSimdFloat Exp(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Exp2(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Log(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Log2(const jlSimdFloat& x);
+	template <Accuracy A> static jlSimdFloat Pow(const jlSimdFloat& x, const jlSimdFloat& y);
+	template <Accuracy A> static jlVector4 Exp(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Exp2(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Log(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Log2(const jlVector4& x);
+	template <Accuracy A> static jlVector4 Pow(const jlVector4& x, const jlVector4& y);
 
 	// interpolation
 	static float32 Saturate(float32 x);
@@ -99,13 +230,44 @@ public:
 	static float32 SmootherStep(float32 a, float32 b, float32 t);
 	static jlSimdFloat SmootherStep(const jlSimdFloat& a, const jlSimdFloat& b, const jlSimdFloat& t);
 
-#if (JL_MATH_TRIG_TABLES)
 private:
-	static float32 *sinTable;
-	static float32 *tanTable;
-	static int32 trigTableSize;
-	static float32 trigTableFactor;
-#endif	
+	// trig kernels shared by the scalar, jlSimdFloat and jlVector4 versions
+	template <Accuracy A> static void SinCosInternal(const jlSimdInternalFloat& x, jlSimdInternalFloat *s, jlSimdInternalFloat *c);
+	template <Accuracy A> static void ASinACosInternal(const jlSimdInternalFloat& x, jlSimdInternalFloat *as, jlSimdInternalFloat *ac);
+	template <Accuracy A> static jlSimdInternalFloat ATanInternal(const jlSimdInternalFloat& x);
+	template <Accuracy A> static jlSimdInternalFloat ATan2Internal(const jlSimdInternalFloat& y, const jlSimdInternalFloat& x);
+	// exp/log kernels
+	template <Accuracy A> static jlSimdInternalFloat ExpInternal(const jlSimdInternalFloat& x);
+	template <Accuracy A> static jlSimdInternalFloat Exp2Internal(const jlSimdInternalFloat& x);
+	template <Accuracy A> static jlSimdInternalFloat LogInternal(const jlSimdInternalFloat& x);
+	template <Accuracy A> static jlSimdInternalFloat Log2Internal(const jlSimdInternalFloat& x);
+	template <Accuracy A> static jlSimdInternalFloat PowInternal(const jlSimdInternalFloat& x, const jlSimdInternalFloat& y);
+	// reciprocal kernels
+	template <Precision P> static jlSimdInternalFloat ReciprocalInternal(const jlSimdInternalFloat& x);
+	template <Precision P> static jlSimdInternalFloat InvSqrtInternal(const jlSimdInternalFloat& x);
+	// rounding kernels
+	static jlSimdInternalFloat FloorInternal(const jlSimdInternalFloat& x);
+	static jlSimdInternalFloat CeilInternal(const jlSimdInternalFloat& x);
+	static jlSimdInternalFloat RoundNearestInternal(const jlSimdInternalFloat& x);
+	static jlSimdInternalFloat TruncInternal(const jlSimdInternalFloat& x);
+	static jlSimdInternalFloat ModInternal(const jlSimdInternalFloat& x, const jlSimdInternalFloat& y);
+	static jlSimdInternalFloat WrapAngleInternal(const jlSimdInternalFloat& x);
+#if (JL_SIMD_ENABLED)
+	static quad128 SinParabolaInternal(const quad128& x);
+	static void SinCosLargeInternal(const quad128& x, const quad128& lanes, quad128 *s, quad128 *c);
+	template <Accuracy A> static quad128 Exp2FractionInternal(const quad128& f);
+	template <Accuracy A> static quad128 Log2FractionInternal(const quad128& f);
+	static quadint128 RoundInternal(const quad128& x, quad128 *rounded);
+	static quad128 Exp2ScaleInternal(const quad128& p, const quadint128& n, const quad128& x, const quad128& overflow, const quad128& underflow);
+	static quad128 LogReduceInternal(const quad128& x, quad128 *e);
+	static quad128 LogPolyInternal(const quad128& f, const quad128& z);
+	static quad128 LogSpecialInternal(const quad128& x, const quad128& r);
+#endif
+
+	// x^N by repeated squaring, unrolled at compile time
+	template <int32 N> struct PowIntInternal {
+		template <typename T> static T Eval(const T& x);
+	};
 };
 
 #include "math/jlMath.inl"
@@ -1,90 +1,128 @@
 JL_FORCE_INLINE float32 jlMath::Cos(float32 x) {
-	return cos(x);
+	return Cos(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::Sin(float32 x) {
-	return sin(x);
-}
-
-JL_FORCE_INLINE float32 jlMath::Cos(float32 x, bool8 useTable) {
-	#if JL_MATH_TRIG_TABLES
-	if (useTable) {
-		TBD_SLOW_ASSERT_MSG(trigTableSize > 0, "Haven't set the trig tables to a valid size!");
-		x += PI_OVER_TWO;
-		if (x >= 0.0f) {
-			return sinTable[((int32)(x * trigTableFactor)) % trigTableSize];
-		} else {
-			return sinTable[(((int32)(-x * trigTableFactor)) % trigTableSize) - 1];
-		}
-	}
-	#else
-	JL_UNREFERENCED(useTable);
-	#endif
-	return Cos(x);
-}
-
-JL_FORCE_INLINE float32 jlMath::Sin(float32 x, bool8 useTable) {
-	#if JL_MATH_TRIG_TABLES
-	if (useTable) {
-		TBD_SLOW_ASSERT_MSG(trigTableSize > 0, "Haven't set the trig tables to a valid size!");
-		if (x >= 0.0f) {
-			return sinTable[((int32)(x * trigTableFactor)) % trigTableSize];
-		} else {
-			return sinTable[(((int32)(-x * trigTableFactor)) % trigTableSize) - 1];
-		}
-	}
-	#else
-	JL_UNREFERENCED(useTable);
-	#endif
-	return Sin(x);
-}
-
-JL_FORCE_INLINE float32 jlMath::Tan(float32 x, bool8 useTable) {
-	#if JL_MATH_TRIG_TABLES
-	if (useTable) {
-		TBD_SLOW_ASSERT_MSG(trigTableSize > 0, "Haven't set the trig tables to a valid size!");
-		return tanTable[((int32)(x * trigTableFactor)) % trigTableSize];
-	}
-	#else
-	JL_UNREFERENCED(useTable);
-	#endif
-	return Tan(x);
+	return Sin(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::Tan(float32 x) {
-	return tan(x);
+	return Tan(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::ASin(float32 x) {
-	if (-1.0f < x) {
-		if (x < 1.0f) {
-			return asin(x);
-		} else {
-			return PI_OVER_TWO;
-		}
-	} else {
-		return -PI_OVER_TWO;
-	}
+	return ASin(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::ACos(float32 x) {
-	if (-1.0f < x) {
-		if (x < 1.0f) {
-			return acos(x);
-		} else {
-			return 0.0f;
-		}
-	} else {
-		return PI;
-	}
+	return ACos(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::ATan(float32 x) {
-	return atan(x);
+	return ATan(jlSimdFloat(x)).getFloat();
 }
 
 JL_FORCE_INLINE float32 jlMath::ATan2(float32 y, float32 x) {
-	return atan2(y, x);
+	return ATan2(jlSimdFloat(y), jlSimdFloat(x)).getFloat();
+}
+
+JL_FORCE_INLINE void jlMath::SinCos(float32 x, float32 *s, float32 *c) {
+	JL_ASSERT(s != JL_NULL && c != JL_NULL);
+	jlSimdFloat ss, cc;
+	SinCos(jlSimdFloat(x), &ss, &cc);
+	*s = ss.getFloat();
+	*c = cc.getFloat();
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Sin(const jlSimdFloat& x) {
+	jlSimdInternalFloat s, c;
+	SinCosInternal<A>(x.f, &s, &c);
+	return jlSimdFloat(s);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Cos(const jlSimdFloat& x) {
+	jlSimdInternalFloat s, c;
+	SinCosInternal<A>(x.f, &s, &c);
+	return jlSimdFloat(c);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Tan(const jlSimdFloat& x) {
+	jlSimdInternalFloat s, c;
+	SinCosInternal<A>(x.f, &s, &c);
+	return jlSimdFloat(s) / jlSimdFloat(c);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::SinCos(const jlSimdFloat& x, jlSimdFloat *s, jlSimdFloat *c) {
+	JL_ASSERT(s != JL_NULL && c != JL_NULL);
+	SinCosInternal<A>(x.f, &s->f, &c->f);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::ASin(const jlSimdFloat& x) {
+	jlSimdInternalFloat as, ac;
+	ASinACosInternal<A>(x.f, &as, &ac);
+	return jlSimdFloat(as);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::ACos(const jlSimdFloat& x) {
+	jlSimdInternalFloat as, ac;
+	ASinACosInternal<A>(x.f, &as, &ac);
+	return jlSimdFloat(ac);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::ATan(const jlSimdFloat& x) {
+	return jlSimdFloat(ATanInternal<A>(x.f));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::ATan2(const jlSimdFloat& y, const jlSimdFloat& x) {
+	return jlSimdFloat(ATan2Internal<A>(y.f, x.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Sin(const jlSimdFloat& x) {
+	return Sin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Cos(const jlSimdFloat& x) {
+	return Cos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Tan(const jlSimdFloat& x) {
+	return Tan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE void jlMath::SinCos(const jlSimdFloat& x, jlSimdFloat *s, jlSimdFloat *c) {
+	SinCos<ACCURACY_FULL>(x, s, c);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::ASin(const jlSimdFloat& x) {
+	return ASin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::ACos(const jlSimdFloat& x) {
+	return ACos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::ATan(const jlSimdFloat& x) {
+	return ATan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::ATan2(const jlSimdFloat& y, const jlSimdFloat& x) {
+	return ATan2<ACCURACY_FULL>(y, x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::FastSin(const jlSimdFloat& x) {
+	return Sin<ACCURACY_LOW>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::FastCos(const jlSimdFloat& x) {
+	return Cos<ACCURACY_LOW>(x);
 }
 
 JL_FORCE_INLINE float32 jlMath::Sqrt(float32 x) {
@@ -94,7 +132,8 @@ JL_FORCE_INLINE float32 jlMath::Sqrt(float32 x) {
 JL_FORCE_INLINE float32 jlMath::InvSqrt(float32 x) {
 	return 1.0f / sqrt(x);
 }
-	
+
+/// Bit hack estimate with one Newton step, max relative error 1.8e-3
 JL_FORCE_INLINE float32 jlMath::FastInvSqrt(float32 x) {
 	float32 xhalf = 0.5f * x;
 	int32 i = *(int32 *) &x;
@@ -142,18 +181,45 @@ JL_FORCE_INLINE float32 jlMath::IsNegative(float32 x) {
 	return (x < 0.0f) ? 1.0f : 0.0f; 
 }
 
+/// True for NaN and both infinities, which all have every exponent bit set
 JL_FORCE_INLINE bool32 jlMath::IsNaN(float32 x) {
-	if (x != x)
-		return true;
-	return x == FLOAT32_INFINITY || x == FLOAT32_NEG_INFINITY;
+	return (*(int32 *) &x & 0x7F800000) == 0x7F800000;
 }
 
 JL_FORCE_INLINE float32 jlMath::Pow(float32 x, float32 power) {
 	return pow(x, power);
 }
 
+/// Repeated squaring, log2(|power|) multiplies
 JL_FORCE_INLINE float32 jlMath::Pow(float32 x, int32 power) {
-	return pow(x, power);
+	uint32 n = (power < 0) ? 0u - static_cast<uint32>(power) : static_cast<uint32>(power);
+	float32 result = 1.0f;
+	while (n) {
+		if (n & 1) result *= x;
+		x *= x;
+		n >>= 1;
+	}
+	return (power < 0) ? 1.0f / result : result;
+}
+
+template <int32 N>
+template <typename T>
+JL_FORCE_INLINE T jlMath::PowIntInternal<N>::Eval(const T& x) {
+	T h = PowIntInternal<N / 2>::Eval(x);
+	return (N & 1) ? h * h * x : h * h;
+}
+
+template <>
+template <typename T>
+JL_FORCE_INLINE T jlMath::PowIntInternal<1>::Eval(const T& x) {
+	return x;
+}
+
+/// x^N for a compile time exponent N > 0, works for float32, jlSimdFloat and jlVector4
+template <int32 N, typename T>
+JL_FORCE_INLINE T jlMath::Pow(const T& x) {
+	JL_STATIC_ASSERT(N > 0);
+	return PowIntInternal<N>::Eval(x);
 }
 
 JL_FORCE_INLINE bool32 jlMath::IsPowerOf2(int32 x) {
@@ -264,9 +330,109 @@ JL_FORCE_INLINE float32 jlMath::LogN(float32 x, float32 n) {
 	return log(x) / log(n);
 }
 
+JL_FORCE_INLINE float32 jlMath::Exp(float32 x) {
+	return exp(x);
+}
+
+JL_FORCE_INLINE float32 jlMath::Exp2(float32 x) {
+	return pow(2.0f, x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Exp(const jlSimdFloat& x) {
+	return jlSimdFloat(ExpInternal<A>(x.f));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Exp2(const jlSimdFloat& x) {
+	return jlSimdFloat(Exp2Internal<A>(x.f));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Log(const jlSimdFloat& x) {
+	return jlSimdFloat(LogInternal<A>(x.f));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Log2(const jlSimdFloat& x) {
+	return jlSimdFloat(Log2Internal<A>(x.f));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlSimdFloat jlMath::Pow(const jlSimdFloat& x, const jlSimdFloat& y) {
+	return jlSimdFloat(PowInternal<A>(x.f, y.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Exp(const jlSimdFloat& x) {
+	return Exp<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Exp2(const jlSimdFloat& x) {
+	return Exp2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Log(const jlSimdFloat& x) {
+	return Log<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Log2(const jlSimdFloat& x) {
+	return Log2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Pow(const jlSimdFloat& x, const jlSimdFloat& y) {
+	return Pow<ACCURACY_FULL>(x, y);
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlSimdFloat jlMath::Reciprocal(const jlSimdFloat& x) {
+	return jlSimdFloat(ReciprocalInternal<P>(x.f));
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlSimdFloat jlMath::InvSqrt(const jlSimdFloat& x) {
+	return jlSimdFloat(InvSqrtInternal<P>(x.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Reciprocal(const jlSimdFloat& x) {
+	return Reciprocal<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::InvSqrt(const jlSimdFloat& x) {
+	return InvSqrt<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Floor(const jlSimdFloat& x) {
+	return jlSimdFloat(FloorInternal(x.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Ceil(const jlSimdFloat& x) {
+	return jlSimdFloat(CeilInternal(x.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Round(const jlSimdFloat& x) {
+	return jlSimdFloat(RoundNearestInternal(x.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Trunc(const jlSimdFloat& x) {
+	return jlSimdFloat(TruncInternal(x.f));
+}
+
+/// x - Floor(x), in [0, 1) for positive and negative x alike
+JL_FORCE_INLINE jlSimdFloat jlMath::Fract(const jlSimdFloat& x) {
+	return x - Floor(x);
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::Mod(const jlSimdFloat& x, const jlSimdFloat& y) {
+	return jlSimdFloat(ModInternal(x.f, y.f));
+}
+
+JL_FORCE_INLINE jlSimdFloat jlMath::WrapAngle(const jlSimdFloat& x) {
+	return jlSimdFloat(WrapAngleInternal(x.f));
+}
+
 JL_FORCE_INLINE float32 jlMath::WrapAngle(float32 x) {
 	x += PI;
-	x -= Floor(x * ONE_OVER_PI) * TWO_PI;
+	x -= Floor(x * ONE_OVER_TWO_PI) * TWO_PI;
 	x -= PI;
 	return x;
 }
\ No newline at end of file
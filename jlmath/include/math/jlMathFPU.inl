@@ -1,10 +1,112 @@
 
-JL_FORCE_INLINE jlSimdFloat jlMath::FastCos(const jlSimdFloat& x) {
-	return jlSimdFloat(0.0f);
+/// Without SIMD every accuracy tier is evaluated by the CRT
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::SinCosInternal(const float32& x, float32 *s, float32 *c) {
+	JL_SLOW_ASSERT(s != JL_NULL && c != JL_NULL);
+	*s = sin(x);
+	*c = cos(x);
 }
 
-JL_FORCE_INLINE jlSimdFloat jlMath::FastSin(const jlSimdFloat& x) {
-	return jlSimdFloat(0.0f);
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::ASinACosInternal(const float32& x, float32 *as, float32 *ac) {
+	JL_SLOW_ASSERT(as != JL_NULL && ac != JL_NULL);
+	float32 clamped = x;
+	if (clamped < -1.0f) clamped = -1.0f;
+	if (clamped > 1.0f) clamped = 1.0f;
+	*as = asin(clamped);
+	*ac = acos(clamped);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::ATanInternal(const float32& x) {
+	return atan(x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::ATan2Internal(const float32& y, const float32& x) {
+	return atan2(y, x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::ExpInternal(const float32& x) {
+	return exp(x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::Exp2Internal(const float32& x) {
+	return pow(2.0f, x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::LogInternal(const float32& x) {
+	return log(x);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::Log2Internal(const float32& x) {
+	return log(x) / LOG2;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE float32 jlMath::PowInternal(const float32& x, const float32& y) {
+	return pow(x, y);
+}
+
+/// Without SIMD there is no estimate to refine so every tier divides
+template <jlMath::Precision P>
+JL_FORCE_INLINE float32 jlMath::ReciprocalInternal(const float32& x) {
+	return 1.0f / x;
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE float32 jlMath::InvSqrtInternal(const float32& x) {
+	return 1.0f / sqrt(x);
+}
+
+JL_FORCE_INLINE float32 jlMath::FloorInternal(const float32& x) {
+	return floor(x);
+}
+
+JL_FORCE_INLINE float32 jlMath::CeilInternal(const float32& x) {
+	return ceil(x);
+}
+
+/// Ties go to the even neighbour to match the SIMD version.  floor and the
+/// steps after it are exact, so the rounding mode never applies.
+JL_FORCE_INLINE float32 jlMath::RoundNearestInternal(const float32& x) {
+	float32 r = floor(x);
+	float32 d = x - r;
+	if (d > 0.5f || (d == 0.5f && fmod(r, 2.0f) != 0.0f)) {
+		r += 1.0f;
+	}
+	// a zero takes the sign of x like the SIMD version, -1 + 1 is +0 and
+	// floor may give -0 when rounding down, x * 0 is exact in every mode
+	return (r == 0.0f) ? x * 0.0f : r;
+}
+
+JL_FORCE_INLINE float32 jlMath::TruncInternal(const float32& x) {
+	return (x < 0.0f) ? ceil(x) : floor(x);
+}
+
+JL_FORCE_INLINE float32 jlMath::ModInternal(const float32& x, const float32& y) {
+	return fmod(x, y);
+}
+
+JL_FORCE_INLINE float32 jlMath::WrapAngleInternal(const float32& x) {
+	float32 k = floor(x * ONE_OVER_TWO_PI + 0.5f);
+	return (x - k * 6.28125f) - k * 1.9353071795864769e-3f;
+}
+
+JL_FORCE_INLINE int32 jlMath::TruncToInt(const jlSimdFloat& x) {
+	return static_cast<int32>(x.f);
+}
+
+JL_FORCE_INLINE int32 jlMath::RoundToInt(const jlSimdFloat& x) {
+	return static_cast<int32>(RoundNearestInternal(x.f));
+}
+
+JL_FORCE_INLINE int32 jlMath::FloorToInt(const jlSimdFloat& x) {
+	return static_cast<int32>(floor(x.f));
 }
 
 JL_FORCE_INLINE jlSimdFloat jlMath::Abs(const jlSimdFloat& x) {
@@ -33,11 +135,6 @@ JL_FORCE_INLINE jlSimdFloat jlMath::Sqrt(const jlSimdFloat& x) {
 	return jlSimdFloat(fsqrt);
 }
 
-JL_FORCE_INLINE jlSimdFloat jlMath::InvSqrt(const jlSimdFloat& x) {
-	float32 invSqrt = 1.0f / sqrt(x.f);
-	return jlSimdFloat(invSqrt);
-}
-
 JL_FORCE_INLINE jlSimdFloat jlMath::Saturate(const jlSimdFloat& x) {
 	float32 fmin = jlMath::Max(x.f, 0.0f);
 	float32 fclamped = jlMath::Min(fmin, 1.0f);
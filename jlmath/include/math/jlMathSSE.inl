@@ -1,36 +1,540 @@
 
-// http://www.unknowncheats.me/forum/c-and-c/57668-fast-sine-and-cosine-simd.html
-JL_FORCE_INLINE jlSimdFloat jlMath::FastCos(const jlSimdFloat& x) {
-	jlSimdFloat halfPi = jlSimdFloat(jlMath::PI_OVER_TWO);
-	jlSimdFloat fourPi = jlSimdFloat(jlMath::TWO_PI * 2.0f);
-	jlSimdFloat v = x + halfPi;
-	quad128 x4 = _mm_sub_ps( v.f, _mm_and_ps( _mm_cmpgt_ps( v.f, fourPi.f ), _mm_mul_ps( _mm_set_ps1( 2.0f ), fourPi.f ) ) );
-	return jlMath::FastSin(x4);
-}
-
-JL_FORCE_INLINE jlSimdFloat jlMath::FastSin(const jlSimdFloat& x) {
-	jlSimdFloat s;
-	quad128 anded = _mm_and_ps(x.f, *(quad128 *)&_mm_set1_epi32(0x7FFFFFFF));
-	quad128 mulAnded = _mm_mul_ps(x.f, anded);
-	quad128 min4 = _mm_set_ps(-4.0f / (jlMath::PI * jlMath::PI), -4.0f / (jlMath::PI * jlMath::PI), -4.0f / (jlMath::PI * jlMath::PI), -4.0f / (jlMath::PI * jlMath::PI));
-	quad128 mulMinAnded = _mm_mul_ps(min4, mulAnded);
-	quad128 fourOverPi = _mm_set_ps(4.0f / jlMath::PI, 4.0f / jlMath::PI, 4.0f / jlMath::PI, 4.0f / jlMath::PI);
-	quad128 xFourPi = _mm_mul_ps(fourOverPi, x.f);
-	quad128 impreciseSin = _mm_add_ps(xFourPi, mulMinAnded);
-	// additional precision
-	quad128 precVal = _mm_set_ps(0.225f, 0.225f, 0.225f, 0.225f);
-	quad128 absImpreciseSin = _mm_and_ps(impreciseSin, *(quad128 *)&_mm_set1_epi32(0x7FFFFFFF));
-	quad128 impreciseSinMulAbsImpreciseSin = _mm_mul_ps(impreciseSin, absImpreciseSin);
-	quad128 mulImpreciseSinMinusImpreciseSin = _mm_sub_ps(impreciseSinMulAbsImpreciseSin, impreciseSin);
-	quad128 modifiedSinMulPrec = _mm_mul_ps(precVal, mulImpreciseSinMinusImpreciseSin);
-	quad128 finalSinSum = _mm_add_ps(modifiedSinMulPrec, impreciseSin);
-	s.f = finalSinSum;
-	return s;
+/// Sin and cos of each lane sharing one range reduction.  Both tiers
+/// above LOW reduce by the nearest multiple of pi/2 with the Cody-Waite 
+/// method and pick the sin or cos polynomial by quadrant (after Cephes).
+/// FULL: Cephes sinf/cosf polynomials, 3 part reduction, lanes beyond 
+///		|x| > 8192 fall back to the CRT. Max error 1.5 ulp for |x| < 100, 
+///		7.7e-8 absolute up to 8192.
+/// MEDIUM: degree 5/4 polynomials, 2 part reduction. Max error 3.7e-5 for |x| < 8192.
+/// LOW: parabolic approximation after wrapping to [-pi, pi]. Max error 1.1e-3 
+///		for |x| < 100, 1.6e-3 up to 8192.
+/// Tan divides the two results, its relative error on [-1.4, 1.4] is 
+/// 3 ulp (FULL), 6e-5 (MEDIUM) and 1.4e-2 (LOW).
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::SinCosInternal(const quad128& x, quad128 *s, quad128 *c) {
+	JL_SLOW_ASSERT(s != JL_NULL && c != JL_NULL);
+	if (A == ACCURACY_LOW) {
+		*s = SinParabolaInternal(x);
+		*c = SinParabolaInternal(_mm_add_ps(x, _mm_set1_ps(PI_OVER_TWO)));
+		return;
+	}
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	quad128 ax = _mm_andnot_ps(signMask, x);
+	quad128 sinSign = _mm_and_ps(x, signMask);
+	// j is the octant rounded up to even, so j * pi/4 is the nearest multiple of pi/2
+	quadint128 j = _mm_cvttps_epi32(_mm_mul_ps(ax, _mm_set1_ps(4.0f / PI)));
+	j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+	quad128 y = _mm_cvtepi32_ps(j);
+	// bit 2 of j flips the sign of sin, bit 1 swaps the sin and cos polynomials
+	quad128 sinFlip = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+	quad128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+	quad128 sinPolyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+	sinSign = _mm_xor_ps(sinSign, sinFlip);
+	// x - j * pi/4, pi/4 is split so the leading products are exact
+	quad128 r = _mm_sub_ps(ax, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+	quad128 z, ps, pc;
+	if (A == ACCURACY_FULL) {
+		r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+		r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+		z = _mm_mul_ps(r, r);
+		ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+		ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+		pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+		pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+	} else {
+		r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(2.41913397e-4f)));
+		z = _mm_mul_ps(r, r);
+		ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(8.3333333e-3f), z), _mm_set1_ps(-1.6666667e-1f));
+		pc = _mm_set1_ps(4.09067e-2f);
+	}
+	ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), r), r);
+	pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+	pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+	quad128 sinPoly = _mm_or_ps(_mm_and_ps(sinPolyMask, ps), _mm_andnot_ps(sinPolyMask, pc));
+	quad128 cosPoly = _mm_or_ps(_mm_and_ps(sinPolyMask, pc), _mm_andnot_ps(sinPolyMask, ps));
+	*s = _mm_xor_ps(sinPoly, sinSign);
+	*c = _mm_xor_ps(cosPoly, cosSign);
+	if (A == ACCURACY_FULL) {
+		quad128 large = _mm_cmpgt_ps(ax, _mm_set1_ps(8192.0f));
+		if (_mm_movemask_ps(large)) {
+			SinCosLargeInternal(x, large, s, c);
+		}
+	}
+}
+
+/// Parabolic sin approximation, 4/pi x - 4/pi^2 x|x| with one refinement
+/// step, wrapped to [-pi, pi] first.  Max error 1.1e-3.
+/// @see http://devmaster.net/posts/9648/fast-and-accurate-sine-cosine
+JL_FORCE_INLINE quad128 jlMath::SinParabolaInternal(const quad128& x) {
+	const quad128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	// round x / 2pi half away from zero without depending on the MXCSR rounding mode
+	quad128 half = _mm_or_ps(_mm_andnot_ps(absMask, x), _mm_set1_ps(0.5f));
+	quad128 k = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(ONE_OVER_TWO_PI)), half)));
+	quad128 w = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TWO_PI)));
+	quad128 y = _mm_mul_ps(w, _mm_set1_ps(4.0f / PI));
+	y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(w, _mm_and_ps(w, absMask)), _mm_set1_ps(-4.0f / (PI * PI))));
+	quad128 refine = _mm_sub_ps(_mm_mul_ps(y, _mm_and_ps(y, absMask)), y);
+	return _mm_add_ps(y, _mm_mul_ps(refine, _mm_set1_ps(0.225f)));
+}
+
+/// Asin and acos of each lane, inputs are clamped to [-1, 1].
+/// FULL: Cephes asinf, using asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)) 
+///		above 0.5. Max error 2.4 ulp (asin), 1.3 ulp (acos).
+/// MEDIUM: acos(x) = sqrt(1 - x) * cubic, Abramowitz and Stegun 4.4.45, asin
+///		below 0.5 is x + x^3 (c0 + c1 x^2). Max error 6.8e-5.
+/// LOW: acos(x) = sqrt(1 - x) * linear, asin below 0.5 is x + c x^3. Max error 3.3e-3.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::ASinACosInternal(const quad128& x, quad128 *as, quad128 *ac) {
+	JL_SLOW_ASSERT(as != JL_NULL && ac != JL_NULL);
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const quad128 one = _mm_set1_ps(1.0f);
+	const quad128 piOverTwo = _mm_set1_ps(PI_OVER_TWO);
+	quad128 sign = _mm_and_ps(x, signMask);
+	quad128 a = _mm_min_ps(one, _mm_andnot_ps(signMask, x)); // keeps NaNs
+	quad128 negative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+	if (A == ACCURACY_FULL) {
+		quad128 big = _mm_cmpgt_ps(a, _mm_set1_ps(0.5f));
+		quad128 zBig = _mm_mul_ps(_mm_sub_ps(one, a), _mm_set1_ps(0.5f));
+		quad128 z = _mm_or_ps(_mm_and_ps(big, zBig), _mm_andnot_ps(big, _mm_mul_ps(a, a)));
+		quad128 r = _mm_or_ps(_mm_and_ps(big, _mm_sqrt_ps(zBig)), _mm_andnot_ps(big, a));
+		quad128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(4.2163199048e-2f), z), _mm_set1_ps(2.4181311049e-2f));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(4.5470025998e-2f));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(7.4953002686e-2f));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.6666752422e-1f));
+		p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), r), r);
+		// below 0.5 p = asin(|x|), above it p = acos(|x|) / 2
+		quad128 twoP = _mm_add_ps(p, p);
+		quad128 asinBig = _mm_sub_ps(piOverTwo, twoP);
+		*as = _mm_or_ps(_mm_or_ps(_mm_and_ps(big, asinBig), _mm_andnot_ps(big, p)), sign);
+		quad128 acosBig = _mm_or_ps(_mm_and_ps(negative, _mm_sub_ps(_mm_set1_ps(PI), twoP)), _mm_andnot_ps(negative, twoP));
+		quad128 acosSmall = _mm_sub_ps(piOverTwo, _mm_or_ps(p, sign));
+		*ac = _mm_or_ps(_mm_and_ps(big, acosBig), _mm_andnot_ps(big, acosSmall));
+	} else {
+		quad128 p;
+		if (A == ACCURACY_MEDIUM) {
+			p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.0187293f), a), _mm_set1_ps(0.0742610f));
+			p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(-0.2121144f));
+			p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(1.5707288f));
+		} else {
+			p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.1682f), a), _mm_set1_ps(1.5675963f));
+		}
+		// t = acos(|x|)
+		quad128 t = _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(one, a)), p);
+		// pi/2 - t cancels towards 0, below 0.5 asin is an odd polynomial so asin(0) is 0
+		quad128 z = _mm_mul_ps(a, a);
+		quad128 q;
+		if (A == ACCURACY_MEDIUM) {
+			q = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.0958902165f), z), _mm_set1_ps(0.164709821f));
+		} else {
+			q = _mm_set1_ps(0.185631573f);
+		}
+		quad128 asinSmall = _mm_add_ps(a, _mm_mul_ps(_mm_mul_ps(a, z), q));
+		quad128 small = _mm_cmplt_ps(a, _mm_set1_ps(0.5f));
+		*as = _mm_or_ps(_mm_or_ps(_mm_and_ps(small, asinSmall), _mm_andnot_ps(small, _mm_sub_ps(piOverTwo, t))), sign);
+		*ac = _mm_or_ps(_mm_and_ps(negative, _mm_sub_ps(_mm_set1_ps(PI), t)), _mm_andnot_ps(negative, t));
+	}
+}
+
+/// Atan of each lane.
+/// FULL: Cephes atanf, reduced by tan(pi/8) and tan(3pi/8). Max error 2.7 ulp.
+/// MEDIUM: atan(x) = pi/2 - atan(1/x) above 1 and a degree 9 polynomial,
+///		Abramowitz and Stegun 4.4.47. Max error 1.2e-5.
+/// LOW: same reduction, pi/4 x - x(|x| - 1)(0.2447 + 0.0663|x|). Max error 1.6e-3.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::ATanInternal(const quad128& x) {
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const quad128 one = _mm_set1_ps(1.0f);
+	quad128 sign = _mm_and_ps(x, signMask);
+	quad128 a = _mm_andnot_ps(signMask, x);
+	quad128 inv = _mm_div_ps(_mm_set1_ps(-1.0f), a);
+	quad128 r, y0, p;
+	if (A == ACCURACY_FULL) {
+		quad128 big = _mm_cmpgt_ps(a, _mm_set1_ps(2.414213562373095f));
+		quad128 mid = _mm_andnot_ps(big, _mm_cmpgt_ps(a, _mm_set1_ps(0.4142135623730950f)));
+		quad128 shifted = _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one));
+		r = _mm_or_ps(_mm_and_ps(big, inv), _mm_andnot_ps(big, a));
+		r = _mm_or_ps(_mm_and_ps(mid, shifted), _mm_andnot_ps(mid, r));
+		y0 = _mm_or_ps(_mm_and_ps(big, _mm_set1_ps(PI_OVER_TWO)), _mm_and_ps(mid, _mm_set1_ps(PI_OVER_FOUR)));
+		quad128 z = _mm_mul_ps(r, r);
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(8.05374449538e-2f), z), _mm_set1_ps(-1.38776856032e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.99777106478e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-3.33329491539e-1f));
+		p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), r), r);
+	} else {
+		quad128 big = _mm_cmpgt_ps(a, one);
+		r = _mm_or_ps(_mm_and_ps(big, inv), _mm_andnot_ps(big, a));
+		y0 = _mm_and_ps(big, _mm_set1_ps(PI_OVER_TWO));
+		if (A == ACCURACY_MEDIUM) {
+			quad128 z = _mm_mul_ps(r, r);
+			p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.0208351f), z), _mm_set1_ps(-0.0851330f));
+			p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.1801410f));
+			p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-0.3302995f));
+			p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.9998660f));
+			p = _mm_mul_ps(p, r);
+		} else {
+			quad128 ar = _mm_andnot_ps(signMask, r);
+			quad128 q = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.0663f), ar), _mm_set1_ps(0.2447f));
+			p = _mm_mul_ps(_mm_set1_ps(PI_OVER_FOUR), r);
+			p = _mm_sub_ps(p, _mm_mul_ps(_mm_mul_ps(r, _mm_sub_ps(ar, one)), q));
+		}
+	}
+	return _mm_or_ps(_mm_add_ps(y0, p), sign);
+}
+
+/// Atan2 of each lane, atan(y / x) moved into the quadrant of (x, y).
+/// Error is that of ATanInternal plus the rounding of y / x (3 ulp for FULL),
+/// atan2(0, 0) is 0.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::ATan2Internal(const quad128& y, const quad128& x) {
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const quad128 zero = _mm_setzero_ps();
+	quad128 r = ATanInternal<A>(_mm_div_ps(y, x));
+	// negative x (including -0) adds pi with the sign of y
+	quad128 xNegative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+	quad128 offset = _mm_or_ps(_mm_set1_ps(PI), _mm_and_ps(y, signMask));
+	r = _mm_add_ps(r, _mm_and_ps(xNegative, offset));
+	quad128 origin = _mm_and_ps(_mm_cmpeq_ps(x, zero), _mm_cmpeq_ps(y, zero));
+	return _mm_andnot_ps(origin, r);
+}
+
+/// 2^x of each lane, x = n + f with n = round(x) and f in [-0.5, 0.5].
+/// 2^f is a polynomial, 2^n is added straight into its exponent bits.
+/// Max relative error 1.6 ulp (FULL), 1.1e-4 (MEDIUM) and 3.2e-3 (LOW).
+/// Results below 2^-126 flush to 0, above 2^128 are infinity.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::Exp2Internal(const quad128& x) {
+	quad128 cx = _mm_max_ps(_mm_set1_ps(-126.0f), _mm_min_ps(_mm_set1_ps(128.0f), x));
+	quad128 fn;
+	quadint128 n = RoundInternal(cx, &fn);
+	quad128 p = Exp2FractionInternal<A>(_mm_sub_ps(cx, fn));
+	return Exp2ScaleInternal(p, n, x, _mm_cmpgt_ps(x, _mm_set1_ps(128.0f)), _mm_cmplt_ps(x, _mm_set1_ps(-126.0f)));
+}
+
+/// 2^f for f in [-0.5, 0.5]
+/// FULL: Cephes exp2f, degree 6.
+/// MEDIUM: degree 3 minimax, max relative error 1.0e-4.
+/// LOW: degree 2 minimax, max relative error 3.1e-3.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::Exp2FractionInternal(const quad128& f) {
+	quad128 p;
+	if (A == ACCURACY_FULL) {
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.535336188319500e-4f), f), _mm_set1_ps(1.339887440266574e-3f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.618437357674640e-3f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.550332471162809e-2f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.402264791363012e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.931472028550421e-1f));
+	} else if (A == ACCURACY_MEDIUM) {
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(5.500893116e-2f), f), _mm_set1_ps(2.422109594e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.932829271e-1f));
+	} else {
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.426406871e-1f), f), _mm_set1_ps(7.071067812e-1f));
+	}
+	return _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+}
+
+/// e^x of each lane.  FULL is Cephes expf, reducing by the nearest multiple 
+/// of ln 2 in two parts, max relative error 1.4 ulp.  MEDIUM and LOW are 
+/// Exp2Internal(x log2(e)), max relative error 1.1e-4 and 3.2e-3.
+/// Results below FLOAT32_MIN flush to 0.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::ExpInternal(const quad128& x) {
+	const quad128 log2e = _mm_set1_ps(1.44269504088896341f);
+	if (A != ACCURACY_FULL) {
+		return Exp2Internal<A>(_mm_mul_ps(x, log2e));
+	}
+	const quad128 maxLog = _mm_set1_ps(88.7228391f);
+	const quad128 minLog = _mm_set1_ps(-87.3365448f);
+	quad128 cx = _mm_max_ps(minLog, _mm_min_ps(maxLog, x));
+	quad128 fn;
+	quadint128 n = RoundInternal(_mm_mul_ps(cx, log2e), &fn);
+	// x - n ln2, ln2 is split so the leading product is exact
+	quad128 r = _mm_sub_ps(cx, _mm_mul_ps(fn, _mm_set1_ps(0.693359375f)));
+	r = _mm_add_ps(r, _mm_mul_ps(fn, _mm_set1_ps(2.12194440e-4f)));
+	quad128 z = _mm_mul_ps(r, r);
+	quad128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.9875691500e-4f), r), _mm_set1_ps(1.3981999507e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(8.3334519073e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(4.1665795894e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.6666665459e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(5.0000001201e-1f));
+	p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, z), r), _mm_set1_ps(1.0f));
+	return Exp2ScaleInternal(p, n, x, _mm_cmpgt_ps(x, maxLog), _mm_cmplt_ps(x, minLog));
+}
+
+/// Rounds half up without depending on the MXCSR rounding mode, 
+/// |x| must fit in an int32
+JL_FORCE_INLINE quadint128 jlMath::RoundInternal(const quad128& x, quad128 *rounded) {
+	JL_SLOW_ASSERT(rounded != JL_NULL);
+	quad128 t = _mm_add_ps(x, _mm_set1_ps(0.5f));
+	quadint128 n = _mm_cvttps_epi32(t);
+	quad128 fn = _mm_cvtepi32_ps(n);
+	// truncation rounds negatives up, step those back down
+	quad128 roundedUp = _mm_cmpgt_ps(fn, t);
+	*rounded = _mm_sub_ps(fn, _mm_and_ps(roundedUp, _mm_set1_ps(1.0f)));
+	return _mm_add_epi32(n, _mm_castps_si128(roundedUp));
+}
+
+/// Multiplies p by 2^n through its exponent bits, n must keep the result 
+/// normal.  Overflow lanes become infinity, underflow lanes 0 and NaN stays NaN.
+JL_FORCE_INLINE quad128 jlMath::Exp2ScaleInternal(const quad128& p, const quadint128& n, const quad128& x, const quad128& overflow, const quad128& underflow) {
+	const quad128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7F800000));
+	quad128 r = _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), _mm_slli_epi32(n, 23)));
+	r = _mm_or_ps(_mm_andnot_ps(overflow, r), _mm_and_ps(overflow, inf));
+	r = _mm_andnot_ps(underflow, r);
+	return _mm_or_ps(r, _mm_cmpunord_ps(x, x));
+}
+
+/// Splits x into 2^e * (1 + f) with 1 + f in [sqrt(0.5), sqrt(2)) by 
+/// reading the exponent bits.  Lanes that are not positive normal numbers 
+/// give garbage, LogSpecialInternal patches them afterwards.
+JL_FORCE_INLINE quad128 jlMath::LogReduceInternal(const quad128& x, quad128 *e) {
+	JL_SLOW_ASSERT(e != JL_NULL);
+	const quad128 one = _mm_set1_ps(1.0f);
+	quadint128 exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(127));
+	quad128 m = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), one);
+	quad128 big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356237309505f));
+	m = _mm_sub_ps(m, _mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))));
+	exponent = _mm_sub_epi32(exponent, _mm_castps_si128(big));
+	*e = _mm_cvtepi32_ps(exponent);
+	return _mm_sub_ps(m, one);
+}
+
+/// log(1 + f) - f + f^2 / 2 for f in [sqrt(0.5) - 1, sqrt(2) - 1], 
+/// the degree 9 polynomial of Cephes logf
+JL_FORCE_INLINE quad128 jlMath::LogPolyInternal(const quad128& f, const quad128& z) {
+	quad128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(7.0376836292e-2f), f), _mm_set1_ps(-1.1514610310e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(1.1676998740e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(-1.2420140846e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(1.4249322787e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(-1.6668057665e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(2.0000714765e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(-2.4999993993e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(3.3333331174e-1f));
+	return _mm_mul_ps(_mm_mul_ps(y, f), z);
+}
+
+/// log2(1 + f) for f in [sqrt(0.5) - 1, sqrt(2) - 1]
+/// FULL: Cephes log2f, log(1 + f) scaled by log2(e) in extra precision.
+/// MEDIUM: f times a degree 4 minimax, max relative error 5e-5.
+/// LOW: f times a degree 2 minimax, max relative error 2.6e-3.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::Log2FractionInternal(const quad128& f) {
+	quad128 p;
+	if (A == ACCURACY_FULL) {
+		const quad128 log2ea = _mm_set1_ps(0.44269504088896340736f); // log2(e) - 1
+		quad128 z = _mm_mul_ps(f, f);
+		quad128 y = _mm_sub_ps(LogPolyInternal(f, z), _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+		// y + f is log(1 + f), multiply by 1 + log2ea keeping the small terms first
+		p = _mm_add_ps(_mm_mul_ps(y, log2ea), _mm_mul_ps(f, log2ea));
+		return _mm_add_ps(_mm_add_ps(p, y), f);
+	} else if (A == ACCURACY_MEDIUM) {
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.547518750e-1f), f), _mm_set1_ps(-3.908924432e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(4.853065144e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(-7.205549723e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.442646251f));
+	} else {
+		p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(4.496096942e-1f), f), _mm_set1_ps(-7.511347318e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.444177047f));
+	}
+	return _mm_mul_ps(p, f);
+}
+
+/// log(0) and log of denormals are -infinity, log(inf) is infinity, 
+/// negative lanes and NaN give NaN
+JL_FORCE_INLINE quad128 jlMath::LogSpecialInternal(const quad128& x, const quad128& r) {
+	const quad128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7F800000));
+	const quad128 negInf = _mm_castsi128_ps(_mm_set1_epi32(0xFF800000));
+	quad128 zero = _mm_cmplt_ps(x, _mm_set1_ps(FLOAT32_MIN));
+	quad128 invalid = _mm_or_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_cmpunord_ps(x, x));
+	quad128 isInf = _mm_cmpeq_ps(x, inf);
+	quad128 result = _mm_or_ps(_mm_andnot_ps(zero, r), _mm_and_ps(zero, negInf));
+	result = _mm_or_ps(_mm_andnot_ps(isInf, result), _mm_and_ps(isInf, inf));
+	return _mm_or_ps(result, invalid);
+}
+
+/// log2 of each lane, e + log2(1 + f) after LogReduceInternal.
+/// Max error 1.3 ulp (FULL), 2.9e-5 (MEDIUM) and 1.3e-3 (LOW) absolute.
+/// Denormals are treated as 0.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::Log2Internal(const quad128& x) {
+	quad128 e;
+	quad128 f = LogReduceInternal(x, &e);
+	return LogSpecialInternal(x, _mm_add_ps(Log2FractionInternal<A>(f), e));
+}
+
+/// Natural log of each lane.  FULL is Cephes logf with ln 2 split in two
+/// parts, max error 0.8 ulp.  MEDIUM and LOW are Log2Internal(x) ln 2, max 
+/// error 2.4e-5 and 9.0e-4 absolute.  Denormals are treated as 0.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::LogInternal(const quad128& x) {
+	if (A != ACCURACY_FULL) {
+		return _mm_mul_ps(Log2Internal<A>(x), _mm_set1_ps(LOG2));
+	}
+	quad128 e;
+	quad128 f = LogReduceInternal(x, &e);
+	quad128 z = _mm_mul_ps(f, f);
+	quad128 y = _mm_sub_ps(LogPolyInternal(f, z), _mm_mul_ps(e, _mm_set1_ps(2.12194440e-4f)));
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	quad128 r = _mm_add_ps(_mm_add_ps(f, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+	return LogSpecialInternal(x, r);
+}
+
+/// x^y of each lane as 2^(y log2(x)).  FULL keeps y * e exact by splitting
+/// y, so only the rounding of y log2(1 + f) scales with y.  Max relative 
+/// error for |y log2(x)| < 30 is 3 ulp (FULL), 1.7e-4 (MEDIUM) and 6.4e-3 
+/// (LOW), growing to 13 ulp, 4.2e-4 and 2e-2 near the float range.
+/// Negative x gives NaN, use the integer Pow for those.  x^0 and 1^y are 1.
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE quad128 jlMath::PowInternal(const quad128& x, const quad128& y) {
+	const quad128 one = _mm_set1_ps(1.0f);
+	quad128 e;
+	quad128 f = LogReduceInternal(x, &e);
+	quad128 t = Log2FractionInternal<A>(f);
+	// the product handles the special cases of log2, NaN and overflow
+	quad128 v = _mm_mul_ps(y, LogSpecialInternal(x, _mm_add_ps(t, e)));
+	quad128 r;
+	if (A == ACCURACY_FULL) {
+		// yh keeps the top 12 bits of y so yh * e and (y - yh) * e are exact
+		quad128 yh = _mm_and_ps(y, _mm_castsi128_ps(_mm_set1_epi32(0xFFFFF000)));
+		quad128 hi = _mm_mul_ps(yh, e);
+		quad128 lo = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(y, yh), e), _mm_mul_ps(y, t));
+		quad128 cv = _mm_max_ps(_mm_set1_ps(-126.0f), _mm_min_ps(_mm_set1_ps(128.0f), v));
+		quad128 fn;
+		quadint128 n = RoundInternal(cv, &fn);
+		quad128 p = Exp2FractionInternal<A>(_mm_add_ps(_mm_sub_ps(hi, fn), lo));
+		r = Exp2ScaleInternal(p, n, v, _mm_cmpgt_ps(v, _mm_set1_ps(128.0f)), _mm_cmplt_ps(v, _mm_set1_ps(-126.0f)));
+	} else {
+		r = Exp2Internal<A>(v);
+	}
+	quad128 isOne = _mm_or_ps(_mm_cmpeq_ps(y, _mm_setzero_ps()), _mm_cmpeq_ps(x, one));
+	return _mm_or_ps(_mm_andnot_ps(isOne, r), _mm_and_ps(isOne, one));
+}
+
+/// Reciprocal from the rcpps estimate, each Newton step r' = r * (2 - x * r)
+/// roughly doubles the correct bits.  Measured over [2^-126, 2^126]:
+/// RAW 3.0e-4 relative, ONE_NEWTON 3.4 ulp, TWO_NEWTON 1.4 ulp
+template <jlMath::Precision P>
+JL_FORCE_INLINE quad128 jlMath::ReciprocalInternal(const quad128& x) {
+	if (P == PRECISION_IEEE) {
+		return _mm_div_ps(QUAD_ONE, x);
+	}
+	quad128 r = _mm_rcp_ps(x);
+	if (P != PRECISION_RAW) {
+		r = _mm_mul_ps(r, _mm_sub_ps(QUAD_TWO, _mm_mul_ps(x, r)));
+	}
+	if (P == PRECISION_TWO_NEWTON) {
+		// r + r * (1 - x * r) keeps the bits the first form rounds away
+		r = _mm_add_ps(r, _mm_mul_ps(r, _mm_sub_ps(QUAD_ONE, _mm_mul_ps(x, r))));
+	}
+	return r;
+}
+
+/// Reciprocal square root from the rsqrtps estimate, refined with
+/// r' = 0.5 * r * (3 - x * r * r).  Measured over [2^-126, 2^126]:
+/// RAW 3.3e-4 relative, ONE_NEWTON 4 ulp, TWO_NEWTON 1.3 ulp
+template <jlMath::Precision P>
+JL_FORCE_INLINE quad128 jlMath::InvSqrtInternal(const quad128& x) {
+	if (P == PRECISION_IEEE) {
+		return _mm_div_ps(QUAD_ONE, _mm_sqrt_ps(x));
+	}
+	quad128 r = _mm_rsqrt_ps(x);
+	if (P != PRECISION_RAW) {
+		r = _mm_mul_ps(_mm_mul_ps(QUAD_INV_TWO, r), _mm_sub_ps(QUAD_THREE, _mm_mul_ps(_mm_mul_ps(x, r), r)));
+	}
+	if (P == PRECISION_TWO_NEWTON) {
+		quad128 e = _mm_sub_ps(QUAD_ONE, _mm_mul_ps(_mm_mul_ps(x, r), r));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(QUAD_INV_TWO, r), e));
+	}
+	return r;
+}
+
+/// Nearest integer with ties to even whatever the MXCSR rounding mode.
+/// SSE4.1 uses roundps with the rounding fixed in the immediate, SSE2
+/// truncates and steps up where the fraction is over a half or exactly a
+/// half on an odd integer, every step exact so the mode never applies.
+/// Lanes at or above 2^23 are already whole and pass through with NaN.
+JL_FORCE_INLINE quad128 jlMath::RoundNearestInternal(const quad128& x) {
+#if (JL_SSE41_ENABLED)
+	return _mm_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const quad128 magic = _mm_set1_ps(8388608.0f);
+	quad128 ax = _mm_andnot_ps(signMask, x);
+	quad128 whole = _mm_cmpnlt_ps(ax, magic);
+	// whole lanes would overflow the conversion, they are selected out below
+	quadint128 n = _mm_cvttps_epi32(_mm_andnot_ps(whole, ax));
+	quad128 r = _mm_cvtepi32_ps(n);
+	quad128 d = _mm_sub_ps(ax, r);
+	quad128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(n, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	quad128 up = _mm_or_ps(_mm_cmpgt_ps(d, QUAD_INV_TWO), _mm_and_ps(_mm_cmpeq_ps(d, QUAD_INV_TWO), odd));
+	r = _mm_or_ps(_mm_add_ps(r, _mm_and_ps(up, QUAD_ONE)), _mm_and_ps(x, signMask));
+	return _mm_or_ps(_mm_and_ps(whole, x), _mm_andnot_ps(whole, r));
+#endif
+}
+
+/// The SSE2 paths round to a neighbouring integer then step towards the 
+/// wanted one, so they are exact whatever the MXCSR rounding mode
+JL_FORCE_INLINE quad128 jlMath::FloorInternal(const quad128& x) {
+#if (JL_SSE41_ENABLED)
+	return _mm_round_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+#else
+	quad128 r = RoundNearestInternal(x);
+	return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, x), QUAD_ONE));
+#endif
+}
+
+JL_FORCE_INLINE quad128 jlMath::CeilInternal(const quad128& x) {
+#if (JL_SSE41_ENABLED)
+	return _mm_round_ps(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+#else
+	// subtracting -1 keeps -0 for (-1, 0], adding 1 would turn it into +0
+	quad128 r = RoundNearestInternal(x);
+	return _mm_sub_ps(r, _mm_and_ps(_mm_cmplt_ps(r, x), _mm_set1_ps(-1.0f)));
+#endif
+}
+
+JL_FORCE_INLINE quad128 jlMath::TruncInternal(const quad128& x) {
+#if (JL_SSE41_ENABLED)
+	return _mm_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+#else
+	// floor of |x| with the sign put back, keeps -0 for (-1, 0]
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	quad128 ax = _mm_andnot_ps(signMask, x);
+	quad128 r = RoundNearestInternal(ax);
+	r = _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, ax), QUAD_ONE));
+	return _mm_or_ps(r, _mm_and_ps(x, signMask));
+#endif
+}
+
+/// x - Trunc(x / y) * y, the sign follows x like fmod.  Not exact like 
+/// fmod, the error grows with the quotient so keep x / y well below 2^23
+JL_FORCE_INLINE quad128 jlMath::ModInternal(const quad128& x, const quad128& y) {
+	return _mm_sub_ps(x, _mm_mul_ps(TruncInternal(_mm_div_ps(x, y)), y));
+}
+
+/// Wraps to [-pi, pi), 2 pi is split so k * 6.28125 is exact for |k| < 2^16
+JL_FORCE_INLINE quad128 jlMath::WrapAngleInternal(const quad128& x) {
+	quad128 k = FloorInternal(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(ONE_OVER_TWO_PI)), QUAD_INV_TWO));
+	quad128 r = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(6.28125f)));
+	return _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(1.9353071795864769e-3f)));
+}
+
+JL_FORCE_INLINE int32 jlMath::TruncToInt(const jlSimdFloat& x) {
+	return _mm_cvtsi128_si32(_mm_cvttps_epi32(x.f));
+}
+
+/// Ties to even like Round, the conversion truncates a whole value so the
+/// MXCSR rounding mode does not apply
+JL_FORCE_INLINE int32 jlMath::RoundToInt(const jlSimdFloat& x) {
+	return _mm_cvtsi128_si32(_mm_cvttps_epi32(RoundNearestInternal(x.f)));
+}
+
+JL_FORCE_INLINE int32 jlMath::FloorToInt(const jlSimdFloat& x) {
+	return _mm_cvtsi128_si32(_mm_cvttps_epi32(FloorInternal(x.f)));
 }
 
 JL_FORCE_INLINE jlSimdFloat jlMath::Abs(const jlSimdFloat& x) {
-	const quad128 absMask = _mm_set1_ps(-1.0f);
-	return jlSimdFloat(_mm_andnot_ps(x.f, absMask));
+	const quad128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	return jlSimdFloat(_mm_andnot_ps(signMask, x.f));
 }
 
 JL_FORCE_INLINE jlSimdFloat jlMath::Clamp(const jlSimdFloat& x, const jlSimdFloat& min, const jlSimdFloat& max) {
@@ -51,10 +555,6 @@ JL_FORCE_INLINE jlSimdFloat jlMath::Sqrt(const jlSimdFloat& x) {
 	return jlSimdFloat(_mm_sqrt_ps(x.f));
 }
 
-JL_FORCE_INLINE jlSimdFloat jlMath::InvSqrt(const jlSimdFloat& x) {
-	return jlSimdFloat(_mm_rsqrt_ps(x.f));
-}
-
 JL_FORCE_INLINE jlSimdFloat jlMath::Saturate(const jlSimdFloat& x) {
 	const quad128 zero = _mm_set1_ps(0.0f);
 	quad128 lowerBound = _mm_max_ps(x.f, zero);
@@ -18,8 +18,8 @@
 class jlMatrix4 {
 public:
 	jlMatrix4();
-	jlMatrix4(const jlVector4& c0, const jlVector4& c1, const jlVector4& c2, const jlVector4& c3);
-	jlMatrix4(float32 m11, float32 m12, float32 m13, float32 m14, float32 m21, float32 m22, float32 m23, float32 m24, 
+	JL_CONSTEXPR jlMatrix4(const jlVector4& c0, const jlVector4& c1, const jlVector4& c2, const jlVector4& c3);
+	JL_CONSTEXPR jlMatrix4(float32 m11, float32 m12, float32 m13, float32 m14, float32 m21, float32 m22, float32 m23, float32 m24, 
 		float32 m31, float32 m32, float32 m33, float32 m34, float32 m41, float32 m42, float32 m43, float32 m44);
 	jlMatrix4& operator =(const jlMatrix4& m);
 
@@ -83,6 +83,8 @@ public:
 	void transpose();
 	jlMatrix4 inverse() const;
 	void invert();
+	template <jlMath::Precision P> jlMatrix4 inverse() const;
+	template <jlMath::Precision P> void invert();
 	bool32 equals(const jlMatrix4& m) const;
 	bool32 operator ==(const jlMatrix4& m) const;
 	bool32 operator !=(const jlMatrix4& m) const;
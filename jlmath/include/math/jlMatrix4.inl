@@ -2,18 +2,16 @@
 
 JL_FORCE_INLINE jlMatrix4::jlMatrix4() { }
 
-JL_FORCE_INLINE jlMatrix4::jlMatrix4(const jlVector4& c0, const jlVector4& c1, const jlVector4& c2, 
+JL_FORCE_INLINE JL_CONSTEXPR jlMatrix4::jlMatrix4(const jlVector4& c0, const jlVector4& c1, const jlVector4& c2, 
 	const jlVector4& c3) : col0(c0), col1(c1), col2(c2), col3(c3) {
 
 }
 
-JL_FORCE_INLINE jlMatrix4::jlMatrix4(float m11, float32 m12, float32 m13, float32 m14, float32 m21, float32 m22, float32 m23, float32 m24, 
+JL_FORCE_INLINE JL_CONSTEXPR jlMatrix4::jlMatrix4(float32 m11, float32 m12, float32 m13, float32 m14, float32 m21, float32 m22, float32 m23, float32 m24, 
 									 float32 m31, float32 m32, float32 m33, float32 m34, float32 m41, float32 m42, float32 m43, float32 m44) 
+	: col0(m11, m21, m31, m41), col1(m12, m22, m32, m42), col2(m13, m23, m33, m43), col3(m14, m24, m34, m44)
 {
-	col0.set(m11, m21, m31, m41);
-	col1.set(m12, m22, m32, m42);
-	col2.set(m13, m23, m33, m43);
-	col3.set(m14, m24, m34, m44);
+
 }
 
 JL_FORCE_INLINE jlMatrix4& jlMatrix4::operator =(const jlMatrix4& m) {
@@ -36,8 +34,13 @@ JL_FORCE_INLINE const float32& jlMatrix4::operator()(int32 row, int32 col) const
 	return getColumn(col)(row);
 }
 
+/// Combines the four column masks so there is a single branch
 JL_FORCE_INLINE bool32 jlMatrix4::isOk() const {
-	return col0.isOk() && col1.isOk() && col2.isOk() && col3.isOk();
+	jlComp c01, c23, all;
+	c01.setAnd(col0.compFinite(), col1.compFinite());
+	c23.setAnd(col2.compFinite(), col3.compFinite());
+	all.setAnd(c01, c23);
+	return all.allAreSet(jlComp::MASK_XYZW);
 }
 
 JL_FORCE_INLINE void jlMatrix4::storeColMajor(float32 *cm) const {
@@ -412,6 +415,8 @@ JL_FORCE_INLINE void jlMatrix4::transpose() {
 }
 
 // using OGRE 3D's method of inverting matrices
+// P picks how the determinant is inverted, the untemplated version is PRECISION_IEEE
+template <jlMath::Precision P>
 JL_FORCE_INLINE jlMatrix4 jlMatrix4::inverse() const {
 	jlSimdFloat m00 = getElem<0, 0>(); jlSimdFloat m01 = getElem<0, 1>(); jlSimdFloat m02 = getElem<0, 2>(); jlSimdFloat m03 = getElem<0, 3>();
 	jlSimdFloat m10 = getElem<1, 0>(); jlSimdFloat m11 = getElem<1, 1>(); jlSimdFloat m12 = getElem<1, 2>(); jlSimdFloat m13 = getElem<1, 3>();
@@ -432,7 +437,7 @@ JL_FORCE_INLINE jlMatrix4 jlMatrix4::inverse() const {
 	jlSimdFloat t20 = + (v4 * m10 - v2 * m11 + v0 * m13);
 	jlSimdFloat t30 = - (v3 * m10 - v1 * m11 + v0 * m12);
 
-	jlSimdFloat invDet = 1 / (t00 * m00 + t10 * m01 + t20 * m02 + t30 * m03);
+	jlSimdFloat invDet = jlMath::Reciprocal<P>(t00 * m00 + t10 * m01 + t20 * m02 + t30 * m03);
 
     jlSimdFloat d00 = t00 * invDet;
     jlSimdFloat d10 = t10 * invDet;
@@ -471,6 +476,15 @@ JL_FORCE_INLINE jlMatrix4 jlMatrix4::inverse() const {
 	return jlMatrix4(d00, d01, d02, d03, d10, d11, d12, d13, d20, d21, d22, d23, d30, d31, d32, d33);
 }
 
+JL_FORCE_INLINE jlMatrix4 jlMatrix4::inverse() const {
+	return inverse<jlMath::PRECISION_IEEE>();
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlMatrix4::invert() {
+	*this = this->inverse<P>();
+}
+
 JL_FORCE_INLINE void jlMatrix4::invert() {
 	*this = this->inverse();
 }
@@ -505,37 +519,30 @@ JL_FORCE_INLINE void jlMatrix4::makeScale(const jlVector4& sv) {
 }
 
 JL_FORCE_INLINE void jlMatrix4::makeRotationX(const jlSimdFloat& rad) {
-	setZero();
-	float32 cos = jlMath::Cos(rad);
-	float32 sin = jlMath::Sin(rad);
-	(*this)(0, 0) = 1.0f; 
-	(*this)(1, 1) = cos;
-	(*this)(2, 1) = sin; 
-	(*this)(1, 2) = -sin;
-	(*this)(2, 2) = cos;
-	(*this)(3, 3) = 1.0f;
+	jlSimdFloat sin, cos, zero = jlSimdFloat(0.0f);
+	jlMath::SinCos(rad, &sin, &cos);
+	col0 = jlVector4::UNIT_X;
+	col1.set(zero, cos, sin, zero);
+	col2.set(zero, -sin, cos, zero);
+	col3 = jlVector4::UNIT_W;
 }
 
 JL_FORCE_INLINE void jlMatrix4::makeRotationY(const jlSimdFloat& rad) {
-	setZero();
-	float32 cos = jlMath::Cos(rad);
-	float32 sin = jlMath::Sin(rad);
-	(*this)(0, 0) = cos; 
-	(*this)(0, 2) = sin;
-	(*this)(2, 0) = -sin; 
-	(*this)(2, 2) = cos;
-	(*this)(2, 2) = 1.0f;
-	(*this)(3, 3) = 1.0f;
+	jlSimdFloat sin, cos, zero = jlSimdFloat(0.0f);
+	jlMath::SinCos(rad, &sin, &cos);
+	col0.set(cos, zero, -sin, zero);
+	col1 = jlVector4::UNIT_Y;
+	col2.set(sin, zero, cos, zero);
+	col3 = jlVector4::UNIT_W;
 }
 
 JL_FORCE_INLINE void jlMatrix4::makeRotationZ(const jlSimdFloat& rad) {
-	setZero();
-	float32 cos = jlMath::Cos(rad);
-	float32 sin = jlMath::Sin(rad);
-	(*this)(0, 0) = cos; (*this)(0, 1) = -sin;
-	(*this)(1, 0) = sin; (*this)(1, 1) = cos;
-	(*this)(2, 2) = 1.0f;
-	(*this)(3, 3) = 1.0f;
+	jlSimdFloat sin, cos, zero = jlSimdFloat(0.0f);
+	jlMath::SinCos(rad, &sin, &cos);
+	col0.set(cos, sin, zero, zero);
+	col1.set(-sin, cos, zero, zero);
+	col2 = jlVector4::UNIT_Z;
+	col3 = jlVector4::UNIT_W;
 }
 
 JL_FORCE_INLINE void jlMatrix4::fromQuaternion(const jlQuaternion& q) {
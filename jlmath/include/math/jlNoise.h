@@ -0,0 +1,62 @@
+/// @file jlNoise.h
+/// @author Jeff Lansing
+
+#ifndef JL_NOISE_H
+#define JL_NOISE_H
+
+#include "jlCore.h"
+#include "math/jlVector4.h"
+
+class jlRandom;
+
+/// Gradient (improved Perlin) and simplex noise in 2, 3 and 4 dimensions
+/// Every call evaluates four points, lane i of x, y, z and w is the i-th
+/// point, so positions are passed struct of arrays.  The lattice hashing
+/// is done per lane from a 256 entry permutation table, the fade, gradient
+/// and blending math runs on all four lanes at once.  With AVX2 the grid
+/// fills evaluate 2D and 3D noise eight points at a time and give the
+/// same values.  Output is roughly in [-1, 1].
+class jlNoise {
+public:
+	enum Type {
+		TYPE_PERLIN,
+		TYPE_SIMPLEX
+	};
+
+	/// Seeded with jlRandom::DEFAULT_SEED
+	jlNoise();
+
+	/// Shuffles the permutation table with numbers drawn from random
+	void seed(jlRandom& random);
+	void seed(uint32 seed);
+
+	jlVector4 perlin(const jlVector4& x, const jlVector4& y) const;
+	jlVector4 perlin(const jlVector4& x, const jlVector4& y, const jlVector4& z) const;
+	jlVector4 perlin(const jlVector4& x, const jlVector4& y, const jlVector4& z, const jlVector4& w) const;
+	jlVector4 simplex(const jlVector4& x, const jlVector4& y) const;
+	jlVector4 simplex(const jlVector4& x, const jlVector4& y, const jlVector4& z) const;
+	jlVector4 simplex(const jlVector4& x, const jlVector4& y, const jlVector4& z, const jlVector4& w) const;
+
+	/// Fractal sum of octaves, each octave scales the frequency by
+	/// lacunarity and the amplitude by gain.  Turbulence sums |noise|.
+	jlVector4 fbm(Type type, const jlVector4& x, const jlVector4& y, int32 octaves, float32 lacunarity = 2.0f, float32 gain = 0.5f) const;
+	jlVector4 fbm(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z, int32 octaves, float32 lacunarity = 2.0f, float32 gain = 0.5f) const;
+	jlVector4 turbulence(Type type, const jlVector4& x, const jlVector4& y, int32 octaves, float32 lacunarity = 2.0f, float32 gain = 0.5f) const;
+	jlVector4 turbulence(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z, int32 octaves, float32 lacunarity = 2.0f, float32 gain = 0.5f) const;
+
+	/// Samples fbm on a regular grid into out, x varies fastest.
+	/// out must be 16 byte aligned and hold nx * ny (* nz) floats,
+	/// point (i, j, k) is at origin + (i, j, k) * spacing.
+	void fillGrid2(float32 *out, int32 nx, int32 ny, const jlVector4& origin, const jlVector4& spacing, Type type, int32 octaves = 1) const;
+	void fillGrid3(float32 *out, int32 nx, int32 ny, int32 nz, const jlVector4& origin, const jlVector4& spacing, Type type, int32 octaves = 1) const;
+private:
+	jlVector4 sample(Type type, const jlVector4& x, const jlVector4& y) const;
+	jlVector4 sample(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z) const;
+
+	// doubled so hash chains can index past 255 without wrapping, plus
+	// 3 bytes so the AVX2 path's 4 byte gathers at 511 stay inside
+	static const int32 PERM_SIZE = 512 + 3;
+	uint8 perm[PERM_SIZE];
+};
+
+#endif // JL_NOISE_H
@@ -0,0 +1,52 @@
+/// @file jlPolynomial.h
+/// @author Jeff Lansing
+
+#ifndef JL_POLYNOMIAL_H
+#define JL_POLYNOMIAL_H
+
+#include "jlCore.h"
+#include "math/jlVector4.h"
+
+/// Real roots of four polynomials, lane l of every member belongs to
+/// polynomial l.  Roots are ascending in each lane, repeated roots are
+/// listed once per multiplicity, and unused slots hold FLOAT32_MAX so
+/// they sort last.
+struct jlPolynomialRoots {
+	jlVector4 roots[4];
+	// lane l of valid[k] is set when polynomial l has more than k real roots
+	jlComp valid[4];
+};
+
+/// Lane parallel quadratic, cubic and quartic solvers
+/// Coefficients are passed struct of arrays, highest degree first, so one
+/// call solves four independent polynomials with no per lane branches.
+/// Lanes whose leading coefficient is zero drop to the lower degree,
+/// lanes with every coefficient zero report no roots.
+/// Close roots are ill conditioned in float, a pair a few thousandths
+/// apart may come back merged.
+class jlPolynomial {
+public:
+	/// a x^2 + b x + c, the root of larger magnitude comes from
+	/// -(b + sign(b) sqrt(disc)) / 2a and the other from c over that, so
+	/// neither subtracts nearly equal values
+	static jlPolynomialRoots SolveQuadratic(const jlVector4& a, const jlVector4& b, const jlVector4& c);
+
+	/// a x^3 + b x^2 + c x + d, Cardano on the depressed cubic when there is
+	/// one real root and the trigonometric form when there are three,
+	/// each root is then polished by a Newton step
+	static jlPolynomialRoots SolveCubic(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& d);
+
+	/// a x^4 + b x^3 + c x^2 + d x + e, Ferrari: the largest root of the
+	/// resolvent cubic splits the depressed quartic into two quadratics.
+	/// The depressed coefficients and the Newton polish run in double-float
+	/// on all four lanes.  A close pair that comes out complex or stuck by
+	/// its extremum is rebuilt from the quadratic model of f there, or
+	/// merged into a double root when the extremum is a root to within
+	/// rounding of the coefficients, all by jlComp select.
+	static jlPolynomialRoots SolveQuartic(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& d, const jlVector4& e);
+
+	/// Horner evaluation, coefficients highest degree first
+	static jlVector4 Evaluate(const jlVector4 *coeffs, int32 degree, const jlVector4& x);
+};
+
+#endif // JL_POLYNOMIAL_H
@@ -13,9 +13,9 @@ public:
 	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
 
 	jlQuaternion();
-	jlQuaternion(const jlVector4& qvec);
-	jlQuaternion(float32 x, float32 y, float32 z, float32 w);
-	jlQuaternion(const jlQuaternion& cpy);
+	JL_CONSTEXPR jlQuaternion(const jlVector4& qvec);
+	JL_CONSTEXPR jlQuaternion(float32 x, float32 y, float32 z, float32 w);
+	JL_CONSTEXPR jlQuaternion(const jlQuaternion& cpy);
 	jlQuaternion& operator =(const jlQuaternion& rhs);
 	
 	// accessors/setters
@@ -33,13 +33,9 @@ public:
 	void setAll(const jlSimdFloat& v);
 	void setZero();
 	void setAxisAngle(const jlVector4& axis, const jlSimdFloat &angle);
+	void setEuler(const jlVector4& angles);
 	void setIdentity();
 	
-	// set from euler
-	// setRotationX
-	// setRotationY
-	// setRotationZ
-	
 	// operators
 	jlQuaternion operator +(const jlQuaternion& rhs) const;
 	jlQuaternion operator -(const jlQuaternion& rhs) const;
@@ -73,6 +69,10 @@ public:
 	static jlQuaternion Slerp(const jlQuaternion& q0, const jlQuaternion& q1, const jlSimdFloat& t);
 	static jlQuaternion Nlerp(const jlQuaternion& q0, const jlQuaternion& q1, const jlSimdFloat& t);
 
+	// batch creation, four angles share each SinCos
+	static void FromAxisAngles(const jlVector4 *axes, const float32 *angles, jlQuaternion *out, int32 count);
+	static void FromEulers(const jlVector4 *angles, jlQuaternion *out, int32 count);
+
 	static const jlQuaternion ZERO;
 	static const jlQuaternion IDENTITY;
 };
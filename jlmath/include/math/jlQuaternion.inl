@@ -3,16 +3,16 @@ JL_FORCE_INLINE jlQuaternion::jlQuaternion() {
 		
 }
 
-JL_FORCE_INLINE jlQuaternion::jlQuaternion(const jlVector4& qvec) {
-	vec = qvec;
+JL_FORCE_INLINE JL_CONSTEXPR jlQuaternion::jlQuaternion(const jlVector4& qvec) : vec(qvec) {
+
 }
 
-JL_FORCE_INLINE jlQuaternion::jlQuaternion(float32 x, float32 y, float32 z, float32 w) {
-	vec.set(x, y, z, w);
+JL_FORCE_INLINE JL_CONSTEXPR jlQuaternion::jlQuaternion(float32 x, float32 y, float32 z, float32 w) : vec(x, y, z, w) {
+
 }
 
-JL_FORCE_INLINE jlQuaternion::jlQuaternion(const jlQuaternion& cpy) {
-	vec = cpy.vec;
+JL_FORCE_INLINE JL_CONSTEXPR jlQuaternion::jlQuaternion(const jlQuaternion& cpy) : vec(cpy.vec) {
+
 }
 
 JL_FORCE_INLINE jlQuaternion& jlQuaternion::operator=(const jlQuaternion& rhs) {
@@ -55,7 +55,7 @@ JL_FORCE_INLINE jlSimdFloat jlQuaternion::getElem() const {
 
 template <int32 i> 
 JL_FORCE_INLINE void jlQuaternion::setElem(const jlSimdFloat& s) {
-	vec.setElem(s);
+	vec.setElem<i>(s);
 }
 
 JL_FORCE_INLINE void jlQuaternion::setIdentity() {
@@ -77,12 +77,23 @@ JL_FORCE_INLINE void jlQuaternion::setZero() {
 JL_FORCE_INLINE void jlQuaternion::setAxisAngle(const jlVector4& axis, const jlSimdFloat& theta) {
 	jlSimdFloat half = jlSimdFloat(0.5f);
 	jlSimdFloat halfTheta = theta * half;
-	jlSimdFloat halfSinTheta = jlMath::Sin(halfTheta);
-	jlSimdFloat halfCosTheta = jlMath::Cos(halfTheta);
+	jlSimdFloat halfSinTheta, halfCosTheta;
+	jlMath::SinCos(halfTheta, &halfSinTheta, &halfCosTheta);
 	vec.setMul(axis, halfSinTheta);
 	vec.setElem<3>(halfCosTheta);
 }
 
+/// Angles are radians about x, y and z, applied in that order (q = qz * qy * qx)
+JL_FORCE_INLINE void jlQuaternion::setEuler(const jlVector4& angles) {
+	jlVector4 s, c;
+	jlMath::SinCos(angles * jlSimdFloat(0.5f), &s, &c);
+	jlSimdFloat sx = s.getElem<0>(), sy = s.getElem<1>(), sz = s.getElem<2>();
+	jlSimdFloat cx = c.getElem<0>(), cy = c.getElem<1>(), cz = c.getElem<2>();
+	jlSimdFloat cycz = cy * cz, sysz = sy * sz;
+	jlSimdFloat sycz = sy * cz, cysz = cy * sz;
+	vec.set(sx * cycz - cx * sysz, cx * sycz + sx * cysz, cx * cysz - sx * sycz, cx * cycz + sx * sysz);
+}
+
 JL_FORCE_INLINE jlQuaternion jlQuaternion::operator +(const jlQuaternion& rhs) const {
 	jlQuaternion sum;
 	sum.vec.setAdd(vec, rhs.vec);
@@ -131,7 +142,7 @@ JL_FORCE_INLINE void jlQuaternion::setAdd(const jlQuaternion& a, const jlQuatern
 
 JL_FORCE_INLINE void jlQuaternion::setMul(const jlQuaternion& q0, const jlQuaternion& q1) {
 	jlSimdFloat q0w = q0.getElem<3>();
-	jlSimdFloat q1w = q0.getElem<3>();
+	jlSimdFloat q1w = q1.getElem<3>();
 	jlVector4 cross, tmp;
 	cross.setCross(q0.vec, q1.vec);
 	tmp.setMul(q1.vec, q0w);
@@ -191,6 +202,7 @@ JL_FORCE_INLINE jlQuaternion jlQuaternion::inverse() const {
 JL_FORCE_INLINE jlQuaternion jlQuaternion::unitInverse() const {
 	jlQuaternion ui;
 	ui.vec.setNegation(vec);
+	ui.vec.setElem<3>(vec.getElem<3>());
 	return ui;
 }
 
@@ -222,9 +234,9 @@ JL_FORCE_INLINE jlQuaternion jlQuaternion::Slerp(const jlQuaternion& q0, const j
 		jlSimdFloat sin = jlMath::Sqrt(one - cos * cos);
 		jlSimdFloat ang = jlMath::ATan2(sin, cos);
 		jlSimdFloat invSin = one / sin;
-		jlSimdFloat k0 = jlMath::Sin((one - clampedT) * ang) * invSin;
-		jlSimdFloat k1 = jlMath::Sin(clampedT * ang) * invSin;
-		return q0 * k1 + r * k1;
+		jlVector4 k; k.set((one - clampedT) * ang, clampedT * ang, zero, zero);
+		k = jlMath::Sin(k);
+		return q0 * (k.getElem<0>() * invSin) + r * (k.getElem<1>() * invSin);
 	} else {
 		jlQuaternion lrp = q0 * (one - clampedT) + r * clampedT;
 		lrp.normalize();
@@ -16,9 +16,9 @@
 class jlSimdFloat {
 public:
 	jlSimdFloat();
-	jlSimdFloat(float32 fl);
-	jlSimdFloat(const quad128& qf);
-	jlSimdFloat(const jlSimdFloat& sf);
+	JL_CONSTEXPR jlSimdFloat(float32 fl);
+	JL_CONSTEXPR jlSimdFloat(const quad128& qf);
+	JL_CONSTEXPR jlSimdFloat(const jlSimdFloat& sf);
 	jlSimdFloat& operator =(const jlSimdFloat& sf);
 	operator float32() const;
 	float32 getFloat() const;
@@ -3,17 +3,11 @@ JL_FORCE_INLINE jlSimdFloat::jlSimdFloat() {
 	
 }
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(float32 fl) : f(fl) {
-	
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlSimdFloat::jlSimdFloat(float32 fl) : f(fl) { }
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(const quad128& qf) {
-	f = qf.v[0];
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlSimdFloat::jlSimdFloat(const quad128& qf) : f(qf.v[0]) { }
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(const jlSimdFloat& sf) {
-	f = sf.f;
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlSimdFloat::jlSimdFloat(const jlSimdFloat& sf) : f(sf.f) { }
 
 JL_FORCE_INLINE jlSimdFloat& jlSimdFloat::operator =(const jlSimdFloat& sf) {
 	f = sf.f;
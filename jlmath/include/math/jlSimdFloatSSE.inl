@@ -3,17 +3,15 @@ JL_FORCE_INLINE jlSimdFloat::jlSimdFloat() {
 	
 }
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(float32 fl) {
-	f = _mm_set1_ps(fl);
-}
+#if JL_CONSTEXPR_ENABLED
+JL_FORCE_INLINE constexpr jlSimdFloat::jlSimdFloat(float32 fl) : f{ fl, fl, fl, fl } { }
+#else
+JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(float32 fl) : f(_mm_set1_ps(fl)) { }
+#endif
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(const quad128& qf) {
-	f = qf;
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlSimdFloat::jlSimdFloat(const quad128& qf) : f(qf) { }
 
-JL_FORCE_INLINE jlSimdFloat::jlSimdFloat(const jlSimdFloat& sf) {
-	f = sf.f;
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlSimdFloat::jlSimdFloat(const jlSimdFloat& sf) : f(sf.f) { }
 
 JL_FORCE_INLINE jlSimdFloat& jlSimdFloat::operator =(const jlSimdFloat& sf) {
 	f = sf.f;
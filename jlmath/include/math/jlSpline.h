@@ -0,0 +1,132 @@
+/// @file jlSpline.h
+/// @author Jeff Lansing
+
+#ifndef JL_SPLINE_H
+#define JL_SPLINE_H
+
+#include "jlCore.h"
+#include "math/jlVector4.h"
+#include "math/jlQuaternion.h"
+
+/// One cubic segment stored in power basis, p(t) = ((c3 t + c2) t + c1) t + c0
+/// Every basis is converted to the same four coefficients when the segment
+/// is set, so evaluation does not depend on the basis and a point costs
+/// three multiplies and three adds on a whole jlVector4.
+/// t runs over [0, 1] for the segment.
+class jlCubicSegment {
+public:
+	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
+
+	enum Basis {
+		BASIS_BEZIER,		///< p0, p1, p2, p3 control points, passes through p0 and p3
+		BASIS_HERMITE,		///< p0, m0, p1, m1 end points and tangents
+		BASIS_CATMULL_ROM,	///< p0, p1, p2, p3, passes through p1 and p2
+		BASIS_BSPLINE		///< p0, p1, p2, p3 uniform cubic B-spline, C2 but approximating
+	};
+
+	jlCubicSegment();
+	jlCubicSegment(Basis basis, const jlVector4& g0, const jlVector4& g1, const jlVector4& g2, const jlVector4& g3);
+
+	void set(Basis basis, const jlVector4& g0, const jlVector4& g1, const jlVector4& g2, const jlVector4& g3);
+
+	// single point, Horner in t
+	jlVector4 evaluate(const jlSimdFloat& t) const;
+	jlVector4 derivative(const jlSimdFloat& t) const;
+	jlVector4 secondDerivative(const jlSimdFloat& t) const;
+
+	// many points at arbitrary t
+	void evaluate(const float32 *t, jlVector4 *out, int32 count) const;
+	void derivative(const float32 *t, jlVector4 *out, int32 count) const;
+
+	/// count evenly spaced points from t0 to t1 inclusive by forward
+	/// differencing, three adds per point.  The differences are restarted
+	/// from Horner every FORWARD_DIFFERENCE_RUN points so rounding does
+	/// not build up over long runs.
+	void evaluateUniform(jlVector4 *out, int32 count, float32 t0 = 0.0f, float32 t1 = 1.0f) const;
+
+	/// Splits a control point array into segments, returns the number written
+	/// Catmull-Rom and B-spline advance one point per segment (count - 3),
+	/// Bezier shares end points (count - 1) / 3 and Hermite reads
+	/// point/tangent pairs (count / 2 - 1)
+	static int32 Build(Basis basis, const jlVector4 *points, int32 count, jlCubicSegment *out);
+	static int32 GetSegmentCount(Basis basis, int32 pointCount);
+
+	static const int32 FORWARD_DIFFERENCE_RUN = 64;
+
+	// power basis coefficients, coeff[i] multiplies t^i
+	jlVector4 coeff[4];
+};
+
+/// Cumulative chord length of a segment sampled at uniform t, used to
+/// reparameterize by distance so points can be placed at even spacing
+class jlArcLengthTable {
+public:
+	static const int32 DEFAULT_SAMPLES = 64;
+
+	jlArcLengthTable();
+	~jlArcLengthTable();
+
+	jlResult init(const jlCubicSegment& segment, int32 samples = DEFAULT_SAMPLES);
+	void release();
+	bool32 isInit() const;
+	int32 getSamples() const;
+	float32 getLength() const;
+
+	/// t at which the curve has covered distance, clamped to [0, length]
+	float32 getParameter(float32 distance) const;
+	void getParameters(const float32 *distances, float32 *out, int32 count) const;
+	/// count points spaced evenly by distance along the segment, both ends included
+	void evaluateEvenly(const jlCubicSegment& segment, jlVector4 *out, int32 count) const;
+private:
+	JL_DISALLOW_COPY_AND_ASSIGN(jlArcLengthTable);
+
+	// samples + 1 cumulative lengths, lengths[0] is 0
+	float32 *lengths;
+	int32 samples;
+};
+
+/// Rotation segment between q0 and q1
+/// Squad blends slerp(q0, q1) and slerp(a0, a1) by 2t(1 - t), with the
+/// inner quaternions chosen from the neighbouring keys so consecutive
+/// segments join with continuous angular velocity.  Bezier evaluates the
+/// four control quaternions by De Casteljau with slerp in place of lerp.
+/// The batch evaluations slerp four t values at a time with one set of
+/// lane parallel trig calls.
+class jlQuaternionSegment {
+public:
+	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
+
+	enum Type {
+		TYPE_SQUAD,
+		TYPE_BEZIER
+	};
+
+	jlQuaternionSegment();
+
+	/// Squad from q0 to q1, prev and next are the keys either side
+	void setSquad(const jlQuaternion& prev, const jlQuaternion& q0, const jlQuaternion& q1, const jlQuaternion& next);
+	void setBezier(const jlQuaternion& q0, const jlQuaternion& q1, const jlQuaternion& q2, const jlQuaternion& q3);
+
+	jlQuaternion evaluate(const jlSimdFloat& t) const;
+	void evaluate(const float32 *t, jlQuaternion *out, int32 count) const;
+	void evaluateUniform(jlQuaternion *out, int32 count, float32 t0 = 0.0f, float32 t1 = 1.0f) const;
+
+	Type getType() const;
+
+	/// Inner squad control point of q given its neighbours
+	static jlQuaternion SquadTangent(const jlQuaternion& prev, const jlQuaternion& q, const jlQuaternion& next);
+	static jlQuaternion Squad(const jlQuaternion& q0, const jlQuaternion& a0, const jlQuaternion& a1, const jlQuaternion& q1, const jlSimdFloat& t);
+	// unit quaternion log and exp, the rotation vector is half angle times axis
+	static jlVector4 Log(const jlQuaternion& q);
+	static jlQuaternion Exp(const jlVector4& v);
+private:
+	void evaluate4(const jlVector4& t, jlQuaternion *out) const;
+
+	// squad: q0, a0, a1, q1, bezier: q0, q1, q2, q3, all in one hemisphere
+	jlQuaternion control[4];
+	Type type;
+};
+
+#include "math/jlSpline.inl"
+
+#endif // JL_SPLINE_H
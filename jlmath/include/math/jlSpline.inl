@@ -0,0 +1,37 @@
+JL_FORCE_INLINE jlCubicSegment::jlCubicSegment() {
+
+}
+
+JL_FORCE_INLINE jlCubicSegment::jlCubicSegment(Basis basis, const jlVector4& g0, const jlVector4& g1, const jlVector4& g2, const jlVector4& g3) {
+	set(basis, g0, g1, g2, g3);
+}
+
+JL_FORCE_INLINE jlVector4 jlCubicSegment::evaluate(const jlSimdFloat& t) const {
+	return ((coeff[3] * t + coeff[2]) * t + coeff[1]) * t + coeff[0];
+}
+
+/// 3 c3 t^2 + 2 c2 t + c1
+JL_FORCE_INLINE jlVector4 jlCubicSegment::derivative(const jlSimdFloat& t) const {
+	return (coeff[3] * (jlSimdFloat(3.0f) * t) + coeff[2] * jlSimdFloat(2.0f)) * t + coeff[1];
+}
+
+JL_FORCE_INLINE jlVector4 jlCubicSegment::secondDerivative(const jlSimdFloat& t) const {
+	return coeff[3] * (jlSimdFloat(6.0f) * t) + coeff[2] * jlSimdFloat(2.0f);
+}
+
+JL_FORCE_INLINE bool32 jlArcLengthTable::isInit() const {
+	return lengths != JL_NULL;
+}
+
+JL_FORCE_INLINE int32 jlArcLengthTable::getSamples() const {
+	return samples;
+}
+
+JL_FORCE_INLINE float32 jlArcLengthTable::getLength() const {
+	JL_SLOW_ASSERT_MSG(isInit(), "Arc length table used before init!");
+	return lengths[samples];
+}
+
+JL_FORCE_INLINE jlQuaternionSegment::Type jlQuaternionSegment::getType() const {
+	return type;
+}
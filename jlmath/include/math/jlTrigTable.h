@@ -0,0 +1,75 @@
+/// @file jlTrigTable.h
+/// @author Jeff Lansing
+
+#ifndef JL_TRIG_TABLE_H
+#define JL_TRIG_TABLE_H
+
+#include "jlCore.h"
+#include "math/jlVector4.h"
+
+/// A sine lookup table over one period, cosine reads it a quarter period ahead
+/// The size is a power of two so indices wrap with a mask instead of a modulo
+/// An extra guard entry lets linear filtering read index + 1 without wrapping
+/// Accurate while x * size / TWO_PI fits comfortably in a float, so keep |x| small
+class jlTrigTable {
+public:
+	enum Filter {
+		FILTER_NEAREST,	///< closest entry, max error about PI / size (7.7e-4 at 4096)
+		FILTER_LINEAR	///< blends the two closest entries, about 5 / size^2 plus the
+						///< float rounding of the index (8.3e-7 at 4096 for |x| < 2 PI)
+	};
+
+	/// 4096 entries is 16KB, small enough to stay in L1 next to the working set
+	static const int32 DEFAULT_SIZE = 4096;
+
+	jlTrigTable();
+	~jlTrigTable();
+
+	// size must be a power of two
+	jlResult init(int32 size = DEFAULT_SIZE);
+	void release();
+	bool32 isInit() const;
+	int32 getSize() const;
+
+	// nearest lookups
+	float32 sin(float32 x) const;
+	float32 cos(float32 x) const;
+	jlVector4 sin(const jlVector4& x) const;
+	jlVector4 cos(const jlVector4& x) const;
+	void sin(const float32 *x, float32 *out, int32 count) const;
+	void cos(const float32 *x, float32 *out, int32 count) const;
+
+	// filtered lookups
+	template <Filter F> float32 sin(float32 x) const;
+	template <Filter F> float32 cos(float32 x) const;
+	template <Filter F> jlVector4 sin(const jlVector4& x) const;
+	template <Filter F> jlVector4 cos(const jlVector4& x) const;
+	template <Filter F> void sin(const float32 *x, float32 *out, int32 count) const;
+	template <Filter F> void cos(const float32 *x, float32 *out, int32 count) const;
+
+	/// Shared table built on first use, safe to call from any thread
+	/// The first caller picks the size, the table lives until exit
+	static const jlTrigTable& GetDefault(int32 size = DEFAULT_SIZE);
+private:
+	JL_DISALLOW_COPY_AND_ASSIGN(jlTrigTable);
+
+	// offset is in table entries, 0 for sine and size / 4 for cosine
+	template <Filter F> float32 lookup(float32 x, float32 offset) const;
+	template <Filter F> quad128 lookup(const quad128& x, float32 offset) const;
+	template <Filter F> void lookup(const float32 *x, float32 *out, int32 count, float32 offset) const;
+
+	float32 *table;
+	int32 size;
+	int32 mask;
+	float32 scale; // entries per radian
+};
+
+#include "math/jlTrigTable.inl"
+
+#if (JL_SIMD_ENABLED)
+	#include "math/jlTrigTableSSE.inl"
+#else
+	#include "math/jlTrigTableFPU.inl"
+#endif
+
+#endif // JL_TRIG_TABLE_H
@@ -0,0 +1,86 @@
+
+JL_FORCE_INLINE bool32 jlTrigTable::isInit() const {
+	return table != JL_NULL;
+}
+
+JL_FORCE_INLINE int32 jlTrigTable::getSize() const {
+	return size;
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE float32 jlTrigTable::lookup(float32 x, float32 offset) const {
+	JL_SLOW_ASSERT_MSG(isInit(), "Trig table used before init!");
+	float32 t = x * scale + offset;
+	if (F == FILTER_NEAREST) {
+		t += 0.5f;
+	}
+	// floor, the mask then wraps negative indices too
+	int32 i = static_cast<int32>(t);
+	if (static_cast<float32>(i) > t) {
+		--i;
+	}
+	if (F == FILTER_NEAREST) {
+		return table[i & mask];
+	}
+	float32 f = t - static_cast<float32>(i);
+	const float32 *entry = table + (i & mask);
+	return entry[0] + (entry[1] - entry[0]) * f;
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE float32 jlTrigTable::sin(float32 x) const {
+	return lookup<F>(x, 0.0f);
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE float32 jlTrigTable::cos(float32 x) const {
+	return lookup<F>(x, static_cast<float32>(size >> 2));
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE jlVector4 jlTrigTable::sin(const jlVector4& x) const {
+	jlVector4 r;
+	r.quad = lookup<F>(x.quad, 0.0f);
+	return r;
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE jlVector4 jlTrigTable::cos(const jlVector4& x) const {
+	jlVector4 r;
+	r.quad = lookup<F>(x.quad, static_cast<float32>(size >> 2));
+	return r;
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE void jlTrigTable::sin(const float32 *x, float32 *out, int32 count) const {
+	lookup<F>(x, out, count, 0.0f);
+}
+
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE void jlTrigTable::cos(const float32 *x, float32 *out, int32 count) const {
+	lookup<F>(x, out, count, static_cast<float32>(size >> 2));
+}
+
+JL_FORCE_INLINE float32 jlTrigTable::sin(float32 x) const {
+	return sin<FILTER_NEAREST>(x);
+}
+
+JL_FORCE_INLINE float32 jlTrigTable::cos(float32 x) const {
+	return cos<FILTER_NEAREST>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlTrigTable::sin(const jlVector4& x) const {
+	return sin<FILTER_NEAREST>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlTrigTable::cos(const jlVector4& x) const {
+	return cos<FILTER_NEAREST>(x);
+}
+
+JL_FORCE_INLINE void jlTrigTable::sin(const float32 *x, float32 *out, int32 count) const {
+	sin<FILTER_NEAREST>(x, out, count);
+}
+
+JL_FORCE_INLINE void jlTrigTable::cos(const float32 *x, float32 *out, int32 count) const {
+	cos<FILTER_NEAREST>(x, out, count);
+}
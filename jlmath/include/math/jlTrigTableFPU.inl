@@ -0,0 +1,25 @@
+/// @file jlTrigTableFPU.inl
+/// @author Jeff Lansing
+
+#if JL_SIMD_ENABLED
+#error "Cannot include jlTrigTableFPU.inl with this configuration"
+#endif
+
+/// Without SIMD each lane is a scalar lookup
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE quad128 jlTrigTable::lookup(const quad128& x, float32 offset) const {
+	quad128 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.v[i] = lookup<F>(x.v[i], offset);
+	}
+	return r;
+}
+
+template <jlTrigTable::Filter F>
+JL_INLINE void jlTrigTable::lookup(const float32 *x, float32 *out, int32 count, float32 offset) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (x != JL_NULL && out != JL_NULL));
+	for (int32 i = 0; i < count; ++i) {
+		out[i] = lookup<F>(x[i], offset);
+	}
+}
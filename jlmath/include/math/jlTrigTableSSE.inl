@@ -0,0 +1,65 @@
+/// @file jlTrigTableSSE.inl
+/// @author Jeff Lansing
+
+#if !JL_SIMD_ENABLED
+#error "Cannot include jlTrigTableSSE.inl with this configuration"
+#endif
+
+/// Four lookups from one set of index math, AVX2 gathers the entries
+/// and plain SSE2 reads them back through a stored index array
+template <jlTrigTable::Filter F>
+JL_FORCE_INLINE quad128 jlTrigTable::lookup(const quad128& x, float32 offset) const {
+	JL_SLOW_ASSERT_MSG(isInit(), "Trig table used before init!");
+	quad128 t = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(scale)), _mm_set1_ps(F == FILTER_NEAREST ? offset + 0.5f : offset));
+	// floor, truncation rounds negative lanes up so step those back by one
+	quadint128 i = _mm_cvttps_epi32(t);
+	i = _mm_add_epi32(i, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(i), t)));
+	quadint128 idx = _mm_and_si128(i, _mm_set1_epi32(mask));
+#if JL_AVX2_ENABLED
+	quad128 a = _mm_i32gather_ps(table, idx, 4);
+	if (F == FILTER_NEAREST) {
+		return a;
+	}
+	quad128 b = _mm_i32gather_ps(table + 1, idx, 4);
+#else
+	JL_ALIGN_16 int32 iv[4];
+	_mm_store_si128(reinterpret_cast<quadint128 *>(iv), idx);
+	quad128 a = _mm_setr_ps(table[iv[0]], table[iv[1]], table[iv[2]], table[iv[3]]);
+	if (F == FILTER_NEAREST) {
+		return a;
+	}
+	quad128 b = _mm_setr_ps(table[iv[0] + 1], table[iv[1] + 1], table[iv[2] + 1], table[iv[3] + 1]);
+#endif
+	quad128 f = _mm_sub_ps(t, _mm_cvtepi32_ps(i));
+	return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f));
+}
+
+/// Eight lanes at a time with AVX2, then four, then the scalar tail
+template <jlTrigTable::Filter F>
+JL_INLINE void jlTrigTable::lookup(const float32 *x, float32 *out, int32 count, float32 offset) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (x != JL_NULL && out != JL_NULL));
+	int32 i = 0;
+#if JL_AVX2_ENABLED
+	const quad256 scale8 = _mm256_set1_ps(scale);
+	const quad256 offset8 = _mm256_set1_ps(F == FILTER_NEAREST ? offset + 0.5f : offset);
+	const quadint256 mask8 = _mm256_set1_epi32(mask);
+	for (; i + 8 <= count; i += 8) {
+		quad256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), scale8), offset8);
+		quad256 fl = _mm256_floor_ps(t);
+		quadint256 idx = _mm256_and_si256(_mm256_cvttps_epi32(fl), mask8);
+		quad256 a = _mm256_i32gather_ps(table, idx, 4);
+		if (F == FILTER_LINEAR) {
+			quad256 b = _mm256_i32gather_ps(table + 1, idx, 4);
+			a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), _mm256_sub_ps(t, fl)));
+		}
+		_mm256_storeu_ps(out + i, a);
+	}
+#endif
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(out + i, lookup<F>(_mm_loadu_ps(x + i), offset));
+	}
+	for (; i < count; ++i) {
+		out[i] = lookup<F>(x[i], offset);
+	}
+}
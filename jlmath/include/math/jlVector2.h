@@ -11,8 +11,8 @@
 class jlVector2 {
 public:
 	jlVector2();
-	jlVector2(float32 fx, float32 fy);
-	jlVector2(const jlVector2& cpy);
+	JL_CONSTEXPR jlVector2(float32 fx, float32 fy);
+	JL_CONSTEXPR jlVector2(const jlVector2& cpy);
 	jlVector2& operator =(const jlVector2& vec);
 
 	// accessors/setters
@@ -2,11 +2,11 @@ JL_FORCE_INLINE jlVector2::jlVector2() : x(0.0f), y(0.0f) {
 		
 }
 
-JL_FORCE_INLINE jlVector2::jlVector2(float32 fx, float32 fy) : x(fx), y(fy) {
+JL_FORCE_INLINE JL_CONSTEXPR jlVector2::jlVector2(float32 fx, float32 fy) : x(fx), y(fy) {
 		
 }
 
-JL_FORCE_INLINE jlVector2::jlVector2(const jlVector2& cpy) : x(cpy.x), y(cpy.y) {
+JL_FORCE_INLINE JL_CONSTEXPR jlVector2::jlVector2(const jlVector2& cpy) : x(cpy.x), y(cpy.y) {
 	
 }
 
@@ -17,9 +17,9 @@ public:
 	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
 
 	jlVector4();
-	jlVector4(float32 x, float32 y, float32 z, float32 w = 0.0f);
-	explicit jlVector4(const quad128& q);
-	jlVector4(const jlVector4& vec);
+	JL_CONSTEXPR jlVector4(float32 x, float32 y, float32 z, float32 w = 0.0f);
+	JL_CONSTEXPR explicit jlVector4(const quad128& q);
+	JL_CONSTEXPR jlVector4(const jlVector4& vec);
 	jlVector4& operator =(const jlVector4& rhs);
 	
 	// accessors/setters
@@ -41,6 +41,8 @@ public:
 	void setZero3();
 	void setZero4();
 	void splice(const jlCompMask& mask);
+	// lanes set in comp take trueValue, the others falseValue
+	void setSelect(const jlComp& comp, const jlVector4& trueValue, const jlVector4& falseValue);
 
 	// operators
 	jlVector4 operator +(const jlVector4& rhs) const;
@@ -64,6 +66,8 @@ public:
 	void setMul(const jlVector4& v, const jlSimdFloat& s);
 	void setDiv(const jlVector4& v, const jlSimdFloat& s);
 	void setDiv(const jlVector4& v, const jlVector4& d);
+	template <jlMath::Precision P> void setDiv(const jlVector4& v, const jlSimdFloat& s);
+	template <jlMath::Precision P> void setDiv(const jlVector4& v, const jlVector4& d);
 	void setCross(const jlVector4& lhs, const jlVector4& rhs);
 	void setMin(const jlVector4& lhs, const jlVector4& rhs);
 	void setMax(const jlVector4& lhs, const jlVector4& rhs);
@@ -85,9 +89,13 @@ public:
 	jlSimdFloat length4() const;
 	jlSimdFloat lengthSquared4() const;
 	jlVector4 cross(const jlVector4& rhs) const;
+	// untemplated normalizes are PRECISION_ONE_NEWTON (4.2 ulp, TWO_NEWTON and FPU within 2.2), zero vectors stay zero
 	void normalize3();
 	void normalize4();
 	jlSimdFloat normalize3WithLength();
+	template <jlMath::Precision P> void normalize3();
+	template <jlMath::Precision P> void normalize4();
+	template <jlMath::Precision P> jlSimdFloat normalize3WithLength();
 
 	// comparison operations
 	jlComp compEqual(const jlVector4& vec) const;
@@ -96,6 +104,8 @@ public:
 	jlComp compGreater(const jlVector4& vec) const;
 	jlComp compLessEqual(const jlVector4& vec) const;
 	jlComp compGreaterEqual(const jlVector4& vec) const;
+	// set for lanes that are neither NaN nor infinite
+	jlComp compFinite() const;
 	bool32 isZero3() const;
 	bool32 isZero4() const;
 	bool32 equals3(const jlVector4& vec) const;
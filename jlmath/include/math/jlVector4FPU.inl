@@ -8,26 +8,11 @@
 /// Wrapped that adheres to the jlVector4 interface using a simple array of floats
 JL_FORCE_INLINE jlVector4::jlVector4() { }
 
-JL_FORCE_INLINE jlVector4::jlVector4(const quad128& q) {
-	quad.v[0] = q.v[0];
-	quad.v[1] = q.v[1];
-	quad.v[2] = q.v[2];
-	quad.v[3] = q.v[3];
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlVector4::jlVector4(const quad128& q) : quad(q) { }
 
-JL_FORCE_INLINE jlVector4::jlVector4(float32 x, float32 y, float32 z, float32 w) {
-	quad.v[0] = x;
-	quad.v[1] = y;
-	quad.v[2] = z;
-	quad.v[3] = w;
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlVector4::jlVector4(float32 x, float32 y, float32 z, float32 w) : quad(x, y, z, w) { }
 
-JL_FORCE_INLINE jlVector4::jlVector4(const jlVector4& vec) {
-	quad.v[0] = vec.quad.v[0];
-	quad.v[1] = vec.quad.v[1];
-	quad.v[2] = vec.quad.v[2];
-	quad.v[3] = vec.quad.v[3];
-}
+JL_FORCE_INLINE JL_CONSTEXPR jlVector4::jlVector4(const jlVector4& vec) : quad(vec.quad) { }
 
 JL_FORCE_INLINE jlVector4& jlVector4::operator =(const jlVector4& vec) {
 	quad.v[0] = vec.quad.v[0];
@@ -48,8 +33,7 @@ JL_FORCE_INLINE float32& jlVector4::operator()(int32 i) {
 }
 
 JL_FORCE_INLINE bool32 jlVector4::isOk() const {
-	return (!jlMath::IsNaN(quad.v[0]) && !jlMath::IsNaN(quad.v[1]) &&
-		!jlMath::IsNaN(quad.v[2]) && !jlMath::IsNaN(quad.v[3]));
+	return compFinite().allAreSet(jlComp::MASK_XYZW);
 }
 
 JL_FORCE_INLINE void jlVector4::store(float32 *ptr) const {
@@ -185,6 +169,13 @@ JL_FORCE_INLINE void jlVector4::splice(const jlCompMask& mask) {
 	quad.v[3] = (mask & jlComp::MASK_W) ? quad.v[3] : 0.0f;
 }
 
+JL_FORCE_INLINE void jlVector4::setSelect(const jlComp& comp, const jlVector4& trueValue, const jlVector4& falseValue) {
+	quad.v[0] = (comp.mask & jlComp::MASK_X) ? trueValue.quad.v[0] : falseValue.quad.v[0];
+	quad.v[1] = (comp.mask & jlComp::MASK_Y) ? trueValue.quad.v[1] : falseValue.quad.v[1];
+	quad.v[2] = (comp.mask & jlComp::MASK_Z) ? trueValue.quad.v[2] : falseValue.quad.v[2];
+	quad.v[3] = (comp.mask & jlComp::MASK_W) ? trueValue.quad.v[3] : falseValue.quad.v[3];
+}
+
 JL_FORCE_INLINE jlVector4 jlVector4::operator +(const jlVector4& rhs) const {
 	jlVector4 sum;
 	sum.quad.v[0] = quad.v[0] + rhs.quad.v[0];
@@ -223,6 +214,15 @@ JL_FORCE_INLINE jlVector4 operator*(const jlSimdFloat& s, const jlVector4& vec)
 	return sv;
 }
 
+JL_FORCE_INLINE jlVector4 jlVector4::operator *(const jlVector4& rhs) const {
+	jlVector4 p;
+	p.quad.v[0] = quad.v[0] * rhs.quad.v[0];
+	p.quad.v[1] = quad.v[1] * rhs.quad.v[1];
+	p.quad.v[2] = quad.v[2] * rhs.quad.v[2];
+	p.quad.v[3] = quad.v[3] * rhs.quad.v[3];
+	return p;
+}
+
 JL_FORCE_INLINE jlVector4 jlVector4::operator /(const jlSimdFloat& d) const {
 	float32 val = d.f;
 	jlVector4 div;
@@ -335,8 +335,24 @@ JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& a, const jlSimdFloat& s)
 	quad.v[3] = a.quad.v[3] / s.f;
 }
 
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& a, const jlVector4& b) {
+	setDiv(a, b);
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& a, const jlSimdFloat& s) {
+	setDiv(a, s);
+}
+
 JL_FORCE_INLINE void jlVector4::setCross(const jlVector4& lhs, const jlVector4& rhs) {
-	// IMPLEMENT ME!
+	float32 x = lhs.quad.v[1] * rhs.quad.v[2] - lhs.quad.v[2] * rhs.quad.v[1];
+	float32 y = lhs.quad.v[2] * rhs.quad.v[0] - lhs.quad.v[0] * rhs.quad.v[2];
+	float32 z = lhs.quad.v[0] * rhs.quad.v[1] - lhs.quad.v[1] * rhs.quad.v[0];
+	quad.v[0] = x;
+	quad.v[1] = y;
+	quad.v[2] = z;
+	quad.v[3] = 0.0f;
 }
 
 JL_FORCE_INLINE void jlVector4::setMin(const jlVector4& lhs, const jlVector4& rhs) {
@@ -472,9 +488,8 @@ JL_FORCE_INLINE void jlVector4::normalize4() {
 
 JL_FORCE_INLINE jlSimdFloat jlVector4::normalize3WithLength() {
 	float32 lenSq3 = quad.v[0]*quad.v[0] + quad.v[1]*quad.v[1] + quad.v[2]*quad.v[2];
-	float32 len3 = lenSq3;
+	float32 len3 = jlMath::Sqrt(lenSq3);
 	if (lenSq3 > FLOAT32_EPSILON) {
-		len3 = jlMath::Sqrt(lenSq3);
 		float32 invLen3 = 1.0f / len3;
 		quad.v[0] *= invLen3;
 		quad.v[1] *= invLen3;
@@ -483,6 +498,22 @@ JL_FORCE_INLINE jlSimdFloat jlVector4::normalize3WithLength() {
 	return len3;
 }
 
+/// Without SIMD every precision divides
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::normalize3() {
+	normalize3();
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::normalize4() {
+	normalize4();
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlSimdFloat jlVector4::normalize3WithLength() {
+	return normalize3WithLength();
+}
+
 
 JL_FORCE_INLINE jlComp jlVector4::compEqual(const jlVector4& vec) const {
 	jlComp ce;
@@ -538,6 +569,15 @@ JL_FORCE_INLINE jlComp jlVector4::compGreaterEqual(const jlVector4& vec) const {
 	return cge;
 }
 
+JL_FORCE_INLINE jlComp jlVector4::compFinite() const {
+	jlComp cf;
+	cf.mask = (!jlMath::IsNaN(quad.v[0]) ? jlComp::MASK_X : jlComp::MASK_NONE) |
+			  (!jlMath::IsNaN(quad.v[1]) ? jlComp::MASK_Y : jlComp::MASK_NONE) |
+			  (!jlMath::IsNaN(quad.v[2]) ? jlComp::MASK_Z : jlComp::MASK_NONE) |
+			  (!jlMath::IsNaN(quad.v[3]) ? jlComp::MASK_W : jlComp::MASK_NONE);
+	return cf;
+}
+
 JL_FORCE_INLINE bool32 jlVector4::isZero3() const {
 	return (quad.v[0] == 0.0f && quad.v[1] == 0.0f && quad.v[2] == 0.0f);
 }
@@ -599,8 +639,8 @@ JL_FORCE_INLINE jlVector4 jlVector4::Slerp(const jlVector4& a, const jlVector4&
 	jlSimdFloat dot = a.dot3(b);
 	jlSimdFloat theta = jlMath::ACos(dot) * t; // clamps to -1 to 1 in ACos for you
 	jlVector4 relativeVec = b - a * dot;
-	jlSimdFloat cos = jlMath::Cos(theta);
-	jlSimdFloat sin = jlMath::Sin(theta);
+	jlSimdFloat sin, cos;
+	jlMath::SinCos(theta, &sin, &cos);
 	relativeVec.normalize3();
 	return a * cos + relativeVec * sin;
 }
@@ -623,3 +663,302 @@ JL_FORCE_INLINE jlVector4 jlVector4::Reflect(const jlVector4& v, const jlVector4
 	jlSimdFloat two = jlSimdFloat(2.0f);
 	return v - two * (v.dot3(n) * n);
 }
+
+// jlMath trig overloads for jlVector4, these need the complete class
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Sin(const jlVector4& x) {
+	jlVector4 r;
+	float32 c;
+	for (int32 i = 0; i < 4; ++i) {
+		SinCosInternal<A>(x.quad.v[i], &r.quad.v[i], &c);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Cos(const jlVector4& x) {
+	jlVector4 r;
+	float32 s;
+	for (int32 i = 0; i < 4; ++i) {
+		SinCosInternal<A>(x.quad.v[i], &s, &r.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Tan(const jlVector4& x) {
+	jlVector4 r;
+	float32 s, c;
+	for (int32 i = 0; i < 4; ++i) {
+		SinCosInternal<A>(x.quad.v[i], &s, &c);
+		r.quad.v[i] = s / c;
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c) {
+	JL_ASSERT(s != JL_NULL && c != JL_NULL);
+	for (int32 i = 0; i < 4; ++i) {
+		SinCosInternal<A>(x.quad.v[i], &s->quad.v[i], &c->quad.v[i]);
+	}
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ASin(const jlVector4& x) {
+	jlVector4 r;
+	float32 ac;
+	for (int32 i = 0; i < 4; ++i) {
+		ASinACosInternal<A>(x.quad.v[i], &r.quad.v[i], &ac);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ACos(const jlVector4& x) {
+	jlVector4 r;
+	float32 as;
+	for (int32 i = 0; i < 4; ++i) {
+		ASinACosInternal<A>(x.quad.v[i], &as, &r.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ATan(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = ATanInternal<A>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ATan2(const jlVector4& y, const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = ATan2Internal<A>(y.quad.v[i], x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Sin(const jlVector4& x) {
+	return Sin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Cos(const jlVector4& x) {
+	return Cos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Tan(const jlVector4& x) {
+	return Tan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE void jlMath::SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c) {
+	SinCos<ACCURACY_FULL>(x, s, c);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ASin(const jlVector4& x) {
+	return ASin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ACos(const jlVector4& x) {
+	return ACos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ATan(const jlVector4& x) {
+	return ATan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ATan2(const jlVector4& y, const jlVector4& x) {
+	return ATan2<ACCURACY_FULL>(y, x);
+}
+
+// jlMath exp/log overloads for jlVector4
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Exp(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = ExpInternal<A>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Exp2(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = Exp2Internal<A>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Log(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = LogInternal<A>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Log2(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = Log2Internal<A>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Pow(const jlVector4& x, const jlVector4& y) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = PowInternal<A>(x.quad.v[i], y.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Exp(const jlVector4& x) {
+	return Exp<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Exp2(const jlVector4& x) {
+	return Exp2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Log(const jlVector4& x) {
+	return Log<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Log2(const jlVector4& x) {
+	return Log2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Pow(const jlVector4& x, const jlVector4& y) {
+	return Pow<ACCURACY_FULL>(x, y);
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlVector4 jlMath::Reciprocal(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = ReciprocalInternal<P>(x.quad.v[i]);
+	}
+	return r;
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlVector4 jlMath::InvSqrt(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = InvSqrtInternal<P>(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Reciprocal(const jlVector4& x) {
+	return Reciprocal<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::InvSqrt(const jlVector4& x) {
+	return InvSqrt<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Sqrt(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = jlMath::Sqrt(x.quad.v[i]);
+	}
+	return r;
+}
+
+// jlMath rounding overloads for jlVector4
+JL_FORCE_INLINE jlVector4 jlMath::Floor(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = FloorInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Ceil(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = CeilInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Round(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = RoundNearestInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Trunc(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = TruncInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Fract(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = x.quad.v[i] - FloorInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Mod(const jlVector4& x, const jlVector4& y) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = ModInternal(x.quad.v[i], y.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::WrapAngle(const jlVector4& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = WrapAngleInternal(x.quad.v[i]);
+	}
+	return r;
+}
+
+JL_FORCE_INLINE quadint128 jlMath::TruncToInt(const jlVector4& x) {
+	quadint128 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.v[i] = static_cast<uint32>(static_cast<int32>(x.quad.v[i]));
+	}
+	return r;
+}
+
+JL_FORCE_INLINE quadint128 jlMath::RoundToInt(const jlVector4& x) {
+	quadint128 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.v[i] = static_cast<uint32>(static_cast<int32>(RoundNearestInternal(x.quad.v[i])));
+	}
+	return r;
+}
+
+JL_FORCE_INLINE quadint128 jlMath::FloorToInt(const jlVector4& x) {
+	quadint128 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.v[i] = static_cast<uint32>(static_cast<int32>(FloorInternal(x.quad.v[i])));
+	}
+	return r;
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ToFloat(const quadint128& x) {
+	jlVector4 r;
+	for (int32 i = 0; i < 4; ++i) {
+		r.quad.v[i] = static_cast<float32>(static_cast<int32>(x.v[i]));
+	}
+	return r;
+}
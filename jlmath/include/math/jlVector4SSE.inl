@@ -11,11 +11,15 @@
 /// Other: // http://www.cs.uaf.edu/2006/fall/cs301/lecture/11_17_sse.html
 JL_FORCE_INLINE jlVector4::jlVector4() { }
 
-JL_FORCE_INLINE jlVector4::jlVector4(const quad128& q) : quad(q) {  }
+JL_FORCE_INLINE JL_CONSTEXPR jlVector4::jlVector4(const quad128& q) : quad(q) {  }
 
+#if JL_CONSTEXPR_ENABLED
+JL_FORCE_INLINE constexpr jlVector4::jlVector4(float32 x, float32 y, float32 z, float32 w) : quad{ x, y, z, w } { }
+#else
 JL_FORCE_INLINE jlVector4::jlVector4(float32 x, float32 y, float32 z, float32 w) : quad(_mm_setr_ps(x, y, z, w)) { }
+#endif
 
-JL_FORCE_INLINE jlVector4::jlVector4(const jlVector4& vec) : quad(vec.quad) { }
+JL_FORCE_INLINE JL_CONSTEXPR jlVector4::jlVector4(const jlVector4& vec) : quad(vec.quad) { }
 
 JL_FORCE_INLINE jlVector4& jlVector4::operator =(const jlVector4& vec) {
 	quad = vec.quad;
@@ -33,9 +37,7 @@ JL_FORCE_INLINE float32& jlVector4::operator()(int32 i) {
 }
 
 JL_FORCE_INLINE bool32 jlVector4::isOk() const {
-	// todo check out cmpord
-	return (!jlMath::IsNaN(quad.m128_f32[0]) && !jlMath::IsNaN(quad.m128_f32[1]) &&
-		!jlMath::IsNaN(quad.m128_f32[2]) && !jlMath::IsNaN(quad.m128_f32[3]));
+	return compFinite().allAreSet(jlComp::MASK_XYZW);
 }
 
 JL_FORCE_INLINE void jlVector4::store(float32 *vec) const {
@@ -91,7 +93,7 @@ JL_FORCE_INLINE jlSimdFloat jlVector4::getElem(int32 i) const {
 	JL_ASSERT_MSG(i >= 0 && i <= 3, "Invalid index for jlVector4");
 	switch (i) {
 		case 0:
-			return jlSimdFloat(quad);
+			return jlSimdFloat(_mm_shuffle_ps(quad, quad, _MM_SHUFFLE(0, 0, 0, 0)));
 		case 1:
 			return jlSimdFloat(_mm_shuffle_ps(quad, quad, _MM_SHUFFLE(1, 1, 1, 1)));
 		case 2:
@@ -153,6 +155,10 @@ JL_FORCE_INLINE void jlVector4::splice(const jlCompMask& mask) {
 	quad = _mm_and_ps(quad, mask);
 }
 
+JL_FORCE_INLINE void jlVector4::setSelect(const jlComp& comp, const jlVector4& trueValue, const jlVector4& falseValue) {
+	quad = _mm_or_ps(_mm_and_ps(comp.mask, trueValue.quad), _mm_andnot_ps(comp.mask, falseValue.quad));
+}
+
 JL_FORCE_INLINE bool32 jlVector4::isZero3() const {
 	int32 maskXYZ = 7;
 	return _mm_movemask_ps(_mm_cmpeq_ps(quad, QUAD_ZERO)) & maskXYZ; 
@@ -186,6 +192,12 @@ JL_FORCE_INLINE jlVector4 operator*(const jlSimdFloat& s, const jlVector4& v) {
 	return p;
 }
 
+JL_FORCE_INLINE jlVector4 jlVector4::operator*(const jlVector4& rhs) const {
+	jlVector4 p;
+	p.quad = _mm_mul_ps(quad, rhs.quad);
+	return p;
+}
+
 JL_FORCE_INLINE jlVector4 jlVector4::operator/(const jlSimdFloat& s) const {
 	jlVector4 d;
 	d.quad = _mm_div_ps(quad, s.f);
@@ -255,6 +267,25 @@ JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& v, const jlVector4& d) {
 	quad = _mm_div_ps(v.quad, d.quad);
 }
 
+/// Below PRECISION_IEEE this multiplies by the refined reciprocal
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& v, const jlSimdFloat& s) {
+	if (P == jlMath::PRECISION_IEEE) {
+		quad = _mm_div_ps(v.quad, s.f);
+	} else {
+		quad = _mm_mul_ps(v.quad, jlMath::Reciprocal<P>(s).f);
+	}
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE void jlVector4::setDiv(const jlVector4& v, const jlVector4& d) {
+	if (P == jlMath::PRECISION_IEEE) {
+		quad = _mm_div_ps(v.quad, d.quad);
+	} else {
+		quad = _mm_mul_ps(v.quad, jlMath::Reciprocal<P>(d).quad);
+	}
+}
+
 JL_FORCE_INLINE void jlVector4::setCross(const jlVector4& lhs, const jlVector4& rhs) {
 	quad128 cross0;
 	quad128 cross1;
@@ -376,62 +407,52 @@ JL_FORCE_INLINE jlVector4 jlVector4::cross(const jlVector4& rhs) const {
 	return jlVector4(_mm_sub_ps(cross0, cross1));
 }
 
+template <jlMath::Precision P>
 JL_FORCE_INLINE void jlVector4::normalize3() {
-	// find the lenSq first
+	// find the lenSq first, replicated to every lane
 	quad128 mult = _mm_mul_ps(quad, quad);
 	quad128 xySum = _mm_add_ss(_mm_shuffle_ps(mult, mult, _MM_SHUFFLE(1,1,1,1)), mult);
 	quad128 lenSq = _mm_add_ss(_mm_shuffle_ps(mult, mult, _MM_SHUFFLE(2,2,2,2)), xySum);
-	// if it is zero, the actual scalar adjustment is different
-	quad128 lenSqCmpZero = _mm_cmpeq_ss(lenSq, QUAD_SINGLE_ZERO);
-	quad128 invMag = _mm_rsqrt_ss(lenSq);
-	quad128 refined = _mm_mul_ss(
-		_mm_mul_ss(QUAD_SINGLE_INV_TWO, invMag),
-		_mm_sub_ss(QUAD_SINGLE_THREE, _mm_mul_ss( _mm_mul_ss(lenSq, invMag), invMag))
-	);
+	lenSq = _mm_shuffle_ps(lenSq, lenSq, _MM_SHUFFLE(0,0,0,0));
 	// multiplier is 0 if the lenSq is zero
-	quad128 multiplier = _mm_andnot_ps(lenSqCmpZero, refined);
-	quad128 replicatedMultiplier = _mm_shuffle_ps(multiplier, multiplier, _MM_SHUFFLE(0, 0, 0, 0));
-	quad = _mm_mul_ps(quad, replicatedMultiplier);
+	quad128 invMag = jlMath::InvSqrt<P>(jlSimdFloat(lenSq)).f;
+	quad = _mm_mul_ps(quad, _mm_andnot_ps(_mm_cmpeq_ps(lenSq, QUAD_ZERO), invMag));
 }
 
+template <jlMath::Precision P>
 JL_FORCE_INLINE void jlVector4::normalize4() {
 	// same as above, but for all four components
 	quad128 mult = _mm_mul_ps(quad, quad);
 	quad128 sum0 = _mm_add_ps(_mm_shuffle_ps(mult, mult, _MM_SHUFFLE(1,0,3,2)), mult);
 	quad128 sum1 = _mm_shuffle_ps(sum0, sum0, _MM_SHUFFLE(2,3,0,1));
 	quad128 lenSq = _mm_add_ps(sum0, sum1);
-	quad128 lenSqCmpZero = _mm_cmpeq_ss(lenSq, QUAD_SINGLE_ZERO);
-	quad128 invMag = _mm_rsqrt_ss(lenSq);
-	const quad128 refined = _mm_mul_ss(
-		_mm_mul_ss(QUAD_INV_TWO, invMag),
-		_mm_sub_ss(QUAD_THREE, _mm_mul_ss(_mm_mul_ss(lenSq, invMag), invMag))
-	);
 	// Ensures that we return 0 if the length is 0
-	quad128 multiplier = _mm_andnot_ps(lenSqCmpZero, refined);
-	quad128 replicatedMultiplier = _mm_shuffle_ps(multiplier, multiplier, _MM_SHUFFLE(0, 0, 0, 0));
-	quad = _mm_mul_ps(quad, replicatedMultiplier);
+	quad128 invMag = jlMath::InvSqrt<P>(jlSimdFloat(lenSq)).f;
+	quad = _mm_mul_ps(quad, _mm_andnot_ps(_mm_cmpeq_ps(lenSq, QUAD_ZERO), invMag));
 }
 
+/// The length is always an exact sqrt, P only picks how it is inverted
+template <jlMath::Precision P>
 JL_FORCE_INLINE jlSimdFloat jlVector4::normalize3WithLength() {
-	// find the lenSq first
-	jlSimdFloat lensf;
 	quad128 mult = _mm_mul_ps(quad, quad);
 	quad128 xySum = _mm_add_ss(_mm_shuffle_ps(mult, mult, _MM_SHUFFLE(1,1,1,1)), mult);
 	quad128 lenSq = _mm_add_ss(_mm_shuffle_ps(mult, mult, _MM_SHUFFLE(2,2,2,2)), xySum);
-	// if it is zero, the actual scalar adjustment is different
-	quad128 len = _mm_sqrt_ss(lenSq);
-	lensf.f = len;
-	quad128 lenSqCmpZero = _mm_cmpeq_ss(lenSq, QUAD_SINGLE_ZERO);
-	quad128 invMag = _mm_div_ss(QUAD_SINGLE_ZERO, len);//_mm_rsqrt_ss(lenSq);
-	quad128 refined = _mm_mul_ss(
-		_mm_mul_ss(QUAD_SINGLE_INV_TWO, invMag),
-		_mm_sub_ss(QUAD_SINGLE_THREE, _mm_mul_ss( _mm_mul_ss(lenSq, invMag), invMag))
-	);
-	// multiplier is 0 if the lenSq is zero
-	quad128 multiplier = _mm_andnot_ps(lenSqCmpZero, refined);
-	quad128 replicatedMultiplier = _mm_shuffle_ps(multiplier, multiplier, _MM_SHUFFLE(0, 0, 0, 0));
-	quad = _mm_mul_ps(quad, replicatedMultiplier);
-	return lensf;
+	quad128 len = _mm_sqrt_ps(_mm_shuffle_ps(lenSq, lenSq, _MM_SHUFFLE(0,0,0,0)));
+	quad128 invMag = jlMath::Reciprocal<P>(jlSimdFloat(len)).f;
+	quad = _mm_mul_ps(quad, _mm_andnot_ps(_mm_cmpeq_ps(len, QUAD_ZERO), invMag));
+	return jlSimdFloat(len);
+}
+
+JL_FORCE_INLINE void jlVector4::normalize3() {
+	normalize3<jlMath::PRECISION_ONE_NEWTON>();
+}
+
+JL_FORCE_INLINE void jlVector4::normalize4() {
+	normalize4<jlMath::PRECISION_ONE_NEWTON>();
+}
+
+JL_FORCE_INLINE jlSimdFloat jlVector4::normalize3WithLength() {
+	return normalize3WithLength<jlMath::PRECISION_ONE_NEWTON>();
 }
 
 JL_FORCE_INLINE bool32 jlVector4::equals3(const jlVector4& vec) const {
@@ -488,6 +509,15 @@ JL_FORCE_INLINE jlComp jlVector4::compGreaterEqual(const jlVector4& vec) const {
 	return ce;
 }
 
+/// NaN and infinity are the only values with every exponent bit set, 
+/// with the sign masked off a signed compare against that finds them
+JL_FORCE_INLINE jlComp jlVector4::compFinite() const {
+	const quadint128 exponentMask = _mm_set1_epi32(0x7F800000);
+	jlComp cf;
+	cf.mask = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_and_si128(_mm_castps_si128(quad), exponentMask), exponentMask));
+	return cf;
+}
+
 JL_FORCE_INLINE jlSimdFloat jlVector4::Dot3(const jlVector4& lhs, const jlVector4& rhs) {
 	quad128 p = _mm_mul_ps(lhs.quad, rhs.quad);
 	quad128 xySum = _mm_add_ss(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1,1,1,1)), p);
@@ -538,8 +568,8 @@ JL_FORCE_INLINE jlVector4 jlVector4::Slerp(const jlVector4& a, const jlVector4&
 	jlSimdFloat dot = a.dot3(b);
 	jlSimdFloat theta = jlMath::ACos(dot) * t; // clamps to -1 to 1 in ACos for you
 	jlVector4 relativeVec = b - a * dot;
-	jlSimdFloat cos = jlMath::Cos(theta);
-	jlSimdFloat sin = jlMath::Sin(theta);
+	jlSimdFloat sin, cos;
+	jlMath::SinCos(theta, &sin, &cos);
 	relativeVec.normalize3();
 	return a * cos + relativeVec * sin;
 }
@@ -564,3 +594,202 @@ JL_FORCE_INLINE jlVector4 jlVector4::Reflect(const jlVector4& v, const jlVector4
 	jlSimdFloat s = jlSimdFloat(2.0f);
 	return v - (s * v.dot3(n) * n);
 }
+
+// jlMath trig overloads for jlVector4, these need the complete class
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Sin(const jlVector4& x) {
+	quad128 s, c;
+	SinCosInternal<A>(x.quad, &s, &c);
+	return jlVector4(s);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Cos(const jlVector4& x) {
+	quad128 s, c;
+	SinCosInternal<A>(x.quad, &s, &c);
+	return jlVector4(c);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Tan(const jlVector4& x) {
+	quad128 s, c;
+	SinCosInternal<A>(x.quad, &s, &c);
+	return jlVector4(_mm_div_ps(s, c));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE void jlMath::SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c) {
+	JL_ASSERT(s != JL_NULL && c != JL_NULL);
+	SinCosInternal<A>(x.quad, &s->quad, &c->quad);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ASin(const jlVector4& x) {
+	quad128 as, ac;
+	ASinACosInternal<A>(x.quad, &as, &ac);
+	return jlVector4(as);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ACos(const jlVector4& x) {
+	quad128 as, ac;
+	ASinACosInternal<A>(x.quad, &as, &ac);
+	return jlVector4(ac);
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ATan(const jlVector4& x) {
+	return jlVector4(ATanInternal<A>(x.quad));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::ATan2(const jlVector4& y, const jlVector4& x) {
+	return jlVector4(ATan2Internal<A>(y.quad, x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Sin(const jlVector4& x) {
+	return Sin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Cos(const jlVector4& x) {
+	return Cos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Tan(const jlVector4& x) {
+	return Tan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE void jlMath::SinCos(const jlVector4& x, jlVector4 *s, jlVector4 *c) {
+	SinCos<ACCURACY_FULL>(x, s, c);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ASin(const jlVector4& x) {
+	return ASin<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ACos(const jlVector4& x) {
+	return ACos<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ATan(const jlVector4& x) {
+	return ATan<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ATan2(const jlVector4& y, const jlVector4& x) {
+	return ATan2<ACCURACY_FULL>(y, x);
+}
+
+// jlMath exp/log overloads for jlVector4
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Exp(const jlVector4& x) {
+	return jlVector4(ExpInternal<A>(x.quad));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Exp2(const jlVector4& x) {
+	return jlVector4(Exp2Internal<A>(x.quad));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Log(const jlVector4& x) {
+	return jlVector4(LogInternal<A>(x.quad));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Log2(const jlVector4& x) {
+	return jlVector4(Log2Internal<A>(x.quad));
+}
+
+template <jlMath::Accuracy A>
+JL_FORCE_INLINE jlVector4 jlMath::Pow(const jlVector4& x, const jlVector4& y) {
+	return jlVector4(PowInternal<A>(x.quad, y.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Exp(const jlVector4& x) {
+	return Exp<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Exp2(const jlVector4& x) {
+	return Exp2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Log(const jlVector4& x) {
+	return Log<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Log2(const jlVector4& x) {
+	return Log2<ACCURACY_FULL>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Pow(const jlVector4& x, const jlVector4& y) {
+	return Pow<ACCURACY_FULL>(x, y);
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlVector4 jlMath::Reciprocal(const jlVector4& x) {
+	return jlVector4(ReciprocalInternal<P>(x.quad));
+}
+
+template <jlMath::Precision P>
+JL_FORCE_INLINE jlVector4 jlMath::InvSqrt(const jlVector4& x) {
+	return jlVector4(InvSqrtInternal<P>(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Reciprocal(const jlVector4& x) {
+	return Reciprocal<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::InvSqrt(const jlVector4& x) {
+	return InvSqrt<PRECISION_IEEE>(x);
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Sqrt(const jlVector4& x) {
+	return jlVector4(_mm_sqrt_ps(x.quad));
+}
+
+// jlMath rounding overloads for jlVector4
+JL_FORCE_INLINE jlVector4 jlMath::Floor(const jlVector4& x) {
+	return jlVector4(FloorInternal(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Ceil(const jlVector4& x) {
+	return jlVector4(CeilInternal(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Round(const jlVector4& x) {
+	return jlVector4(RoundNearestInternal(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Trunc(const jlVector4& x) {
+	return jlVector4(TruncInternal(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Fract(const jlVector4& x) {
+	return jlVector4(_mm_sub_ps(x.quad, FloorInternal(x.quad)));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::Mod(const jlVector4& x, const jlVector4& y) {
+	return jlVector4(ModInternal(x.quad, y.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::WrapAngle(const jlVector4& x) {
+	return jlVector4(WrapAngleInternal(x.quad));
+}
+
+JL_FORCE_INLINE quadint128 jlMath::TruncToInt(const jlVector4& x) {
+	return _mm_cvttps_epi32(x.quad);
+}
+
+/// Ties to even like Round, the conversion truncates a whole value so the
+/// MXCSR rounding mode does not apply
+JL_FORCE_INLINE quadint128 jlMath::RoundToInt(const jlVector4& x) {
+	return _mm_cvttps_epi32(RoundNearestInternal(x.quad));
+}
+
+JL_FORCE_INLINE quadint128 jlMath::FloorToInt(const jlVector4& x) {
+	return _mm_cvttps_epi32(FloorInternal(x.quad));
+}
+
+JL_FORCE_INLINE jlVector4 jlMath::ToFloat(const quadint128& x) {
+	return jlVector4(_mm_cvtepi32_ps(x));
+}
@@ -0,0 +1,127 @@
+/// @file jlVector4Stream.h
+/// @author Jeff Lansing
+
+#ifndef JL_VECTOR4_STREAM_H
+#define JL_VECTOR4_STREAM_H
+
+#include "jlCore.h"
+#include "math/jlSimdFloat.h"
+#include "math/jlVector4.h"
+
+/// Base of every lazily evaluated stream expression.  Arithmetic on
+/// streams only builds small expression objects, nothing is computed
+/// until the expression is assigned to a jlVector4Stream.  At that point
+/// the whole expression is evaluated element by element in a single
+/// unrolled pass, so pos += (vel + acc * dt) * dt reads each array once
+/// and writes pos once instead of streaming temporaries through memory.
+template <typename E>
+class jlStreamExpr {
+public:
+	const E& getExpr() const;
+};
+
+/// Element wise operations used by the expression nodes
+struct jlStreamAssign {
+	static const jlVector4& Apply(const jlVector4& a, const jlVector4& b);
+};
+
+struct jlStreamAdd {
+	static jlVector4 Apply(const jlVector4& a, const jlVector4& b);
+};
+
+struct jlStreamSub {
+	static jlVector4 Apply(const jlVector4& a, const jlVector4& b);
+};
+
+struct jlStreamMul {
+	static jlVector4 Apply(const jlVector4& a, const jlVector4& b);
+};
+
+struct jlStreamDiv {
+	static jlVector4 Apply(const jlVector4& a, const jlVector4& b);
+};
+
+/// Node combining two sub expressions with one of the ops above
+template <typename L, typename R, typename Op>
+class jlStreamBinary : public jlStreamExpr< jlStreamBinary<L, R, Op> > {
+public:
+	jlStreamBinary(const L& l, const R& r);
+	jlVector4 evaluate(int32 i) const;
+	int32 getCount() const;
+private:
+	const L lhs;
+	const R rhs;
+};
+
+/// Leaf broadcasting a jlSimdFloat/jlVector4 to every element.
+/// Leaves without storage report a count of -1.
+class jlStreamConstant : public jlStreamExpr<jlStreamConstant> {
+public:
+	explicit jlStreamConstant(const jlSimdFloat& s);
+	explicit jlStreamConstant(const jlVector4& v);
+	const jlVector4& evaluate(int32 i) const;
+	int32 getCount() const;
+private:
+	jlVector4 value;
+};
+
+/// Node writing the value of its sub expression into a stream as it is
+/// evaluated, then passing it on.  This lets one pass update several
+/// arrays, the stored stream must not also be read by a sibling of this node.
+template <typename E>
+class jlStreamStore : public jlStreamExpr< jlStreamStore<E> > {
+public:
+	jlStreamStore(jlVector4 *dst, const E& e);
+	jlVector4 evaluate(int32 i) const;
+	int32 getCount() const;
+private:
+	jlVector4 *dst;
+	const E expr;
+};
+
+/// A non owning view over a contiguous jlVector4 array (e.g. one array
+/// of a struct of arrays).  Copying a stream copies the view, assigning
+/// an expression (or another stream) to it writes the elements, the same
+/// way std::valarray behaves.  All streams in an expression must have
+/// the same count.
+class jlVector4Stream : public jlStreamExpr<jlVector4Stream> {
+public:
+	jlVector4Stream(jlVector4 *data, int32 count);
+	jlVector4Stream(const jlVector4Stream& stream);
+	jlVector4Stream& operator =(const jlVector4Stream& rhs);
+	template <typename E> jlVector4Stream& operator =(const jlStreamExpr<E>& rhs);
+	template <typename E> jlVector4Stream& operator +=(const jlStreamExpr<E>& rhs);
+	template <typename E> jlVector4Stream& operator -=(const jlStreamExpr<E>& rhs);
+	template <typename E> jlVector4Stream& operator *=(const jlStreamExpr<E>& rhs);
+	jlVector4Stream& operator *=(const jlSimdFloat& s);
+	jlVector4Stream& operator /=(const jlSimdFloat& s);
+	template <typename E> jlStreamStore<E> store(const jlStreamExpr<E>& e) const;
+
+	const jlVector4& evaluate(int32 i) const;
+	int32 getCount() const;
+	jlVector4 * getData() const;
+private:
+	template <typename Op, typename E> void apply(const E& e);
+
+	jlVector4 *data;
+	int32 count;
+};
+
+// stream/stream operators
+template <typename L, typename R> jlStreamBinary<L, R, jlStreamAdd> operator +(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r);
+template <typename L, typename R> jlStreamBinary<L, R, jlStreamSub> operator -(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r);
+template <typename L, typename R> jlStreamBinary<L, R, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r);
+
+// stream/scalar operators
+template <typename L> jlStreamBinary<L, jlStreamConstant, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlSimdFloat& s);
+template <typename R> jlStreamBinary<jlStreamConstant, R, jlStreamMul> operator *(const jlSimdFloat& s, const jlStreamExpr<R>& r);
+template <typename L> jlStreamBinary<L, jlStreamConstant, jlStreamDiv> operator /(const jlStreamExpr<L>& l, const jlSimdFloat& s);
+
+// stream/vector operators, the vector is added to every element
+template <typename L> jlStreamBinary<L, jlStreamConstant, jlStreamAdd> operator +(const jlStreamExpr<L>& l, const jlVector4& v);
+template <typename L> jlStreamBinary<L, jlStreamConstant, jlStreamSub> operator -(const jlStreamExpr<L>& l, const jlVector4& v);
+template <typename L> jlStreamBinary<L, jlStreamConstant, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlVector4& v);
+
+#include "math/jlVector4Stream.inl"
+
+#endif // JL_VECTOR4_STREAM_H
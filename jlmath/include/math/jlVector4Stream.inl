@@ -0,0 +1,206 @@
+template <typename E>
+JL_FORCE_INLINE const E& jlStreamExpr<E>::getExpr() const {
+	return static_cast<const E&>(*this);
+}
+
+JL_FORCE_INLINE const jlVector4& jlStreamAssign::Apply(const jlVector4& a, const jlVector4& b) {
+	JL_UNREFERENCED(a);
+	return b;
+}
+
+JL_FORCE_INLINE jlVector4 jlStreamAdd::Apply(const jlVector4& a, const jlVector4& b) {
+	return a + b;
+}
+
+JL_FORCE_INLINE jlVector4 jlStreamSub::Apply(const jlVector4& a, const jlVector4& b) {
+	return a - b;
+}
+
+JL_FORCE_INLINE jlVector4 jlStreamMul::Apply(const jlVector4& a, const jlVector4& b) {
+	return a * b;
+}
+
+JL_FORCE_INLINE jlVector4 jlStreamDiv::Apply(const jlVector4& a, const jlVector4& b) {
+	return a / b;
+}
+
+template <typename L, typename R, typename Op>
+JL_FORCE_INLINE jlStreamBinary<L, R, Op>::jlStreamBinary(const L& l, const R& r) : lhs(l), rhs(r) {
+	JL_ASSERT_MSG(l.getCount() < 0 || r.getCount() < 0 || l.getCount() == r.getCount(),
+		"Stream counts %d and %d do not match", l.getCount(), r.getCount());
+}
+
+template <typename L, typename R, typename Op>
+JL_FORCE_INLINE jlVector4 jlStreamBinary<L, R, Op>::evaluate(int32 i) const {
+	return Op::Apply(lhs.evaluate(i), rhs.evaluate(i));
+}
+
+template <typename L, typename R, typename Op>
+JL_FORCE_INLINE int32 jlStreamBinary<L, R, Op>::getCount() const {
+	return lhs.getCount() >= 0 ? lhs.getCount() : rhs.getCount();
+}
+
+JL_FORCE_INLINE jlStreamConstant::jlStreamConstant(const jlSimdFloat& s) {
+	value.setAll(s);
+}
+
+JL_FORCE_INLINE jlStreamConstant::jlStreamConstant(const jlVector4& v) : value(v) { }
+
+JL_FORCE_INLINE const jlVector4& jlStreamConstant::evaluate(int32 i) const {
+	JL_UNREFERENCED(i);
+	return value;
+}
+
+JL_FORCE_INLINE int32 jlStreamConstant::getCount() const {
+	return -1;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlStreamStore<E>::jlStreamStore(jlVector4 *ptr, const E& e) : dst(ptr), expr(e) { }
+
+template <typename E>
+JL_FORCE_INLINE jlVector4 jlStreamStore<E>::evaluate(int32 i) const {
+	jlVector4 v = expr.evaluate(i);
+	dst[i] = v;
+	return v;
+}
+
+template <typename E>
+JL_FORCE_INLINE int32 jlStreamStore<E>::getCount() const {
+	return expr.getCount();
+}
+
+JL_FORCE_INLINE jlVector4Stream::jlVector4Stream(jlVector4 *ptr, int32 n) : data(ptr), count(n) {
+	JL_ASSERT(ptr != JL_NULL || n == 0);
+	JL_ASSERT(n >= 0);
+}
+
+JL_FORCE_INLINE jlVector4Stream::jlVector4Stream(const jlVector4Stream& stream) : data(stream.data), count(stream.count) { }
+
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator =(const jlVector4Stream& rhs) {
+	apply<jlStreamAssign>(rhs);
+	return *this;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator =(const jlStreamExpr<E>& rhs) {
+	apply<jlStreamAssign>(rhs.getExpr());
+	return *this;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator +=(const jlStreamExpr<E>& rhs) {
+	apply<jlStreamAdd>(rhs.getExpr());
+	return *this;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator -=(const jlStreamExpr<E>& rhs) {
+	apply<jlStreamSub>(rhs.getExpr());
+	return *this;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator *=(const jlStreamExpr<E>& rhs) {
+	apply<jlStreamMul>(rhs.getExpr());
+	return *this;
+}
+
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator *=(const jlSimdFloat& s) {
+	apply<jlStreamMul>(jlStreamConstant(s));
+	return *this;
+}
+
+JL_FORCE_INLINE jlVector4Stream& jlVector4Stream::operator /=(const jlSimdFloat& s) {
+	apply<jlStreamDiv>(jlStreamConstant(s));
+	return *this;
+}
+
+template <typename E>
+JL_FORCE_INLINE jlStreamStore<E> jlVector4Stream::store(const jlStreamExpr<E>& e) const {
+	JL_ASSERT_MSG(e.getExpr().getCount() < 0 || e.getExpr().getCount() == count,
+		"Stream of %d elements stored to a stream of %d", e.getExpr().getCount(), count);
+	return jlStreamStore<E>(data, e.getExpr());
+}
+
+JL_FORCE_INLINE const jlVector4& jlVector4Stream::evaluate(int32 i) const {
+	JL_SLOW_ASSERT(i >= 0 && i < count);
+	return data[i];
+}
+
+JL_FORCE_INLINE int32 jlVector4Stream::getCount() const {
+	return count;
+}
+
+JL_FORCE_INLINE jlVector4 * jlVector4Stream::getData() const {
+	return data;
+}
+
+/// Evaluates the expression into this stream, 4 elements per iteration.
+/// Each element only depends on the same index of its inputs so the
+/// destination may also appear inside the expression
+template <typename Op, typename E>
+JL_FORCE_INLINE void jlVector4Stream::apply(const E& e) {
+	JL_ASSERT_MSG(e.getCount() < 0 || e.getCount() == count,
+		"Stream of %d elements assigned to a stream of %d", e.getCount(), count);
+	jlVector4 *dst = data;
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		jlVector4 r0 = Op::Apply(dst[i], e.evaluate(i));
+		jlVector4 r1 = Op::Apply(dst[i + 1], e.evaluate(i + 1));
+		jlVector4 r2 = Op::Apply(dst[i + 2], e.evaluate(i + 2));
+		jlVector4 r3 = Op::Apply(dst[i + 3], e.evaluate(i + 3));
+		dst[i] = r0;
+		dst[i + 1] = r1;
+		dst[i + 2] = r2;
+		dst[i + 3] = r3;
+	}
+	for (; i < count; ++i) {
+		dst[i] = Op::Apply(dst[i], e.evaluate(i));
+	}
+}
+
+template <typename L, typename R>
+JL_FORCE_INLINE jlStreamBinary<L, R, jlStreamAdd> operator +(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r) {
+	return jlStreamBinary<L, R, jlStreamAdd>(l.getExpr(), r.getExpr());
+}
+
+template <typename L, typename R>
+JL_FORCE_INLINE jlStreamBinary<L, R, jlStreamSub> operator -(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r) {
+	return jlStreamBinary<L, R, jlStreamSub>(l.getExpr(), r.getExpr());
+}
+
+template <typename L, typename R>
+JL_FORCE_INLINE jlStreamBinary<L, R, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlStreamExpr<R>& r) {
+	return jlStreamBinary<L, R, jlStreamMul>(l.getExpr(), r.getExpr());
+}
+
+template <typename L>
+JL_FORCE_INLINE jlStreamBinary<L, jlStreamConstant, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlSimdFloat& s) {
+	return jlStreamBinary<L, jlStreamConstant, jlStreamMul>(l.getExpr(), jlStreamConstant(s));
+}
+
+template <typename R>
+JL_FORCE_INLINE jlStreamBinary<jlStreamConstant, R, jlStreamMul> operator *(const jlSimdFloat& s, const jlStreamExpr<R>& r) {
+	return jlStreamBinary<jlStreamConstant, R, jlStreamMul>(jlStreamConstant(s), r.getExpr());
+}
+
+template <typename L>
+JL_FORCE_INLINE jlStreamBinary<L, jlStreamConstant, jlStreamDiv> operator /(const jlStreamExpr<L>& l, const jlSimdFloat& s) {
+	return jlStreamBinary<L, jlStreamConstant, jlStreamDiv>(l.getExpr(), jlStreamConstant(s));
+}
+
+template <typename L>
+JL_FORCE_INLINE jlStreamBinary<L, jlStreamConstant, jlStreamAdd> operator +(const jlStreamExpr<L>& l, const jlVector4& v) {
+	return jlStreamBinary<L, jlStreamConstant, jlStreamAdd>(l.getExpr(), jlStreamConstant(v));
+}
+
+template <typename L>
+JL_FORCE_INLINE jlStreamBinary<L, jlStreamConstant, jlStreamSub> operator -(const jlStreamExpr<L>& l, const jlVector4& v) {
+	return jlStreamBinary<L, jlStreamConstant, jlStreamSub>(l.getExpr(), jlStreamConstant(v));
+}
+
+template <typename L>
+JL_FORCE_INLINE jlStreamBinary<L, jlStreamConstant, jlStreamMul> operator *(const jlStreamExpr<L>& l, const jlVector4& v) {
+	return jlStreamBinary<L, jlStreamConstant, jlStreamMul>(l.getExpr(), jlStreamConstant(v));
+}
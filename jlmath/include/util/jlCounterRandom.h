@@ -0,0 +1,62 @@
+/// @file jlCounterRandom.h
+/// @author Jeff Lansing
+
+#ifndef JL_COUNTER_RANDOM_H
+#define JL_COUNTER_RANDOM_H
+
+#include "jlCore.h"
+
+/// Philox4x32-10 counter based random numbers
+/// Each 64 bit counter value is encrypted with the 64 bit key into one
+/// quadint128 of four uint32s, so the only state is the key and counter.
+/// Element i of a key's sequence is lane i % 4 of block i / 4 and can be
+/// read directly with Uint32At, which lets a parallel loop draw element
+/// i's numbers from (key, i) with no shared generator.  Use a different
+/// key per stream, entity or frame rather than spacing counters apart.
+class jlCounterRandom {
+public:
+	jlCounterRandom();
+	explicit jlCounterRandom(uint64 key, uint64 counter = 0);
+
+	// sets the key and restarts the sequence at counter 0
+	void seed(uint64 key = jlCounterRandom::DEFAULT_SEED);
+	uint64 getKey() const;
+	// the next block to be generated, values left in the current one are dropped
+	void setCounter(uint64 counter);
+	uint64 getCounter() const;
+
+	// get a random uint/int/float, the same conversions as jlRandom
+	uint32 randUint32();
+	uint32 randUint32(uint32 max);
+	uint32 randUint32(uint32 min, uint32 max);
+	int32 randInt32();
+	int32 randInt32(int32 max);
+	int32 randInt32(int32 min, int32 max);
+	float32 randFloat32();
+	float32 randFloat32(float32 max);
+	float32 randFloat32(float32 min, float32 max);
+
+	/// Bulk draws, the same values as count calls to randUint32, four
+	/// blocks are encrypted together to hide the multiply latency
+	void fillUint32(uint32 *out, int32 count);
+	void fillUint32(uint32 *out, int32 count, uint32 max);
+	void fillFloat32(float32 *out, int32 count, float32 min = 0.0f, float32 max = 1.0f);
+
+	// the four uint32s of block counter under key
+	static quadint128 Generate(uint64 key, uint64 counter);
+	// element index of key's sequence
+	static uint32 Uint32At(uint64 key, uint64 index);
+	static float32 Float32At(uint64 key, uint64 index);
+
+	static const uint64 DEFAULT_SEED = 1234;
+	// uint32s per counter value
+	static const int32 BLOCK_SIZE = 4;
+private:
+	// the current block, idx is the next unread value
+	uint32 block[BLOCK_SIZE];
+	uint64 key;
+	uint64 counter;
+	int32 idx;
+};
+
+#endif // JL_COUNTER_RANDOM_H
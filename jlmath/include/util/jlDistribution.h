@@ -0,0 +1,56 @@
+/// @file jlDistribution.h
+/// @author Jeff Lansing
+
+#ifndef JL_DISTRIBUTION_H
+#define JL_DISTRIBUTION_H
+
+#include "jlCore.h"
+#include "math/jlVector4.h"
+#include "math/jlMatrix4.h"
+#include "util/jlRandom.h"
+
+/// Bulk non-uniform samples built from a generator's fillFloat32
+/// R is jlRandom, jlCounterRandom or anything else with
+/// fillFloat32(float32 *out, int32 count, float32 min, float32 max).
+/// Every sampler transforms four uniforms per lane parallel step with no
+/// rejection loop, so the cost per sample is fixed.
+class jlDistribution {
+public:
+	/// Box-Muller, each pair of uniforms gives a sine and a cosine sample.
+	/// Uniforms step by 2^-23 so samples stop at about 5.6 deviations.
+	template <class R> static void FillNormal(R& random, float32 *out, int32 count, float32 mean = 0.0f, float32 stddev = 1.0f);
+	/// -log(u) / rate, the gaps between events arriving at rate per unit time
+	template <class R> static void FillExponential(R& random, float32 *out, int32 count, float32 rate = 1.0f);
+	/// Uniform directions, z uniform in [-1, 1) and an angle around it
+	template <class R> static void FillUnitSphere(R& random, jlVector4 *out, int32 count);
+	/// Uniform points in the unit disk in x and y, radius sqrt(u) keeps
+	/// the density even, z and w are 0
+	template <class R> static void FillUnitDisk(R& random, jlVector4 *out, int32 count);
+	/// Directions with density cos(theta) / PI about normal, which must be
+	/// unit length.  Disk points are lifted onto the hemisphere (Malley)
+	/// and rotated by a branchless basis built around normal, w is 0.
+	template <class R> static void FillCosineHemisphere(R& random, jlVector4 *out, int32 count, const jlVector4& normal);
+
+	/// Fisher-Yates with Lemire bounded indices, the raw draws for each
+	/// run of BATCH_SIZE swaps come from one fillUint32
+	template <class R, class T> static void Shuffle(R& random, T *items, int32 count);
+	/// Stops Fisher-Yates after k swaps, the first k items are then a
+	/// uniform sample without replacement in random order
+	template <class R, class T> static void PartialShuffle(R& random, T *items, int32 count, int32 k);
+	/// k distinct indices from [0, n) in ascending order by selection
+	/// sampling, one draw per index considered and no extra memory.
+	/// For k much smaller than n PartialShuffle of an index array draws less.
+	template <class R> static void SampleIndices(R& random, int32 *out, int32 k, int32 n);
+private:
+	// vectors or indices per call to the generator's bulk fill
+	static const int32 BATCH_SIZE = 64;
+
+	// 4 * groups disk points from 8 * groups uniforms, lane l of group g is point 4g + l
+	static void UniformToDisk(const float32 *u, int32 group, jlVector4 *x, jlVector4 *y, jlVector4 *rSquared);
+	// writes the first count of the four points whose coordinates are the lanes of x, y and z
+	static void StoreTransposed(const jlVector4& x, const jlVector4& y, const jlVector4& z, jlVector4 *out, int32 count);
+};
+
+#include "util/jlDistribution.inl"
+
+#endif // JL_DISTRIBUTION_H
@@ -0,0 +1,178 @@
+template <class R>
+JL_INLINE void jlDistribution::FillNormal(R& random, float32 *out, int32 count, float32 mean, float32 stddev) {
+	JL_ASSERT(count >= 0 && stddev >= 0.0f);
+	const jlVector4 meanV(mean, mean, mean, mean);
+	const jlSimdFloat stddevS(stddev);
+	int32 i = 0;
+	// eight uniforms become eight samples in place
+	random.fillFloat32(out, count & ~7, 0.0f, 1.0f);
+	for (; i + 8 <= count; i += 8) {
+		jlVector4 u1, u2, s, c;
+		u1.load(out + i);
+		u2.load(out + i + 4);
+		// 1 - u is in (0, 1] so the log stays finite
+		jlVector4 r = jlMath::Sqrt(jlMath::Log(jlVector4::ONE - u1) * jlSimdFloat(-2.0f)) * stddevS;
+		jlMath::SinCos(u2 * jlSimdFloat(2.0f * jlMath::PI), &s, &c);
+		(r * c + meanV).store(out + i);
+		(r * s + meanV).store(out + i + 4);
+	}
+	if (i < count) {
+		JL_ALIGN_16 float32 tail[8];
+		FillNormal(random, tail, 8, mean, stddev);
+		for (int32 j = 0; i < count; ++i, ++j) {
+			out[i] = tail[j];
+		}
+	}
+}
+
+template <class R>
+JL_INLINE void jlDistribution::FillExponential(R& random, float32 *out, int32 count, float32 rate) {
+	JL_ASSERT(count >= 0 && rate > 0.0f);
+	random.fillFloat32(out, count, 0.0f, 1.0f);
+	const jlSimdFloat scale(-1.0f / rate);
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		jlVector4 u;
+		u.load(out + i);
+		(jlMath::Log(jlVector4::ONE - u) * scale).store(out + i);
+	}
+	for (; i < count; ++i) {
+		out[i] = jlMath::Log(1.0f - out[i]) * (-1.0f / rate);
+	}
+}
+
+template <class R>
+JL_INLINE void jlDistribution::FillUnitSphere(R& random, jlVector4 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ALIGN_16 float32 u[2 * BATCH_SIZE];
+	for (int32 first = 0; first < count; first += BATCH_SIZE) {
+		const int32 n = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+		const int32 groups = (n + 3) / 4;
+		random.fillFloat32(u, 8 * groups, -1.0f, 1.0f);
+		for (int32 g = 0; g < groups; ++g) {
+			jlVector4 z, phi, s, c;
+			z.loadAligned(u + 8 * g);
+			phi.loadAligned(u + 8 * g + 4);
+			jlMath::SinCos(phi * jlSimdFloat(jlMath::PI), &s, &c);
+			jlVector4 r = jlMath::Sqrt(jlVector4::ONE - z * z);
+			r.setMax(r, jlVector4::ZERO);
+			StoreTransposed(r * c, r * s, z, out + first + 4 * g, n - 4 * g);
+		}
+	}
+}
+
+template <class R>
+JL_INLINE void jlDistribution::FillUnitDisk(R& random, jlVector4 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ALIGN_16 float32 u[2 * BATCH_SIZE];
+	for (int32 first = 0; first < count; first += BATCH_SIZE) {
+		const int32 n = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+		const int32 groups = (n + 3) / 4;
+		random.fillFloat32(u, 8 * groups, 0.0f, 1.0f);
+		for (int32 g = 0; g < groups; ++g) {
+			jlVector4 x, y, rSquared;
+			UniformToDisk(u, g, &x, &y, &rSquared);
+			StoreTransposed(x, y, jlVector4::ZERO, out + first + 4 * g, n - 4 * g);
+		}
+	}
+}
+
+/// Basis from Duff et al., Building an Orthonormal Basis, Revisited
+template <class R>
+JL_INLINE void jlDistribution::FillCosineHemisphere(R& random, jlVector4 *out, int32 count, const jlVector4& normal) {
+	JL_ASSERT(count >= 0);
+	const float32 nx = normal(0), ny = normal(1), nz = normal(2);
+	const float32 sign = (nz >= 0.0f) ? 1.0f : -1.0f;
+	const float32 a = -1.0f / (sign + nz);
+	const float32 b = nx * ny * a;
+	const jlVector4 tangent(1.0f + sign * nx * nx * a, sign * b, -sign * nx, 0.0f);
+	const jlVector4 bitangent(b, sign + ny * ny * a, -ny, 0.0f);
+	const jlMatrix4 basis(tangent, bitangent, jlVector4(nx, ny, nz, 0.0f), jlVector4::ZERO);
+	JL_ALIGN_16 float32 u[2 * BATCH_SIZE];
+	for (int32 first = 0; first < count; first += BATCH_SIZE) {
+		const int32 n = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+		const int32 groups = (n + 3) / 4;
+		random.fillFloat32(u, 8 * groups, 0.0f, 1.0f);
+		for (int32 g = 0; g < groups; ++g) {
+			jlVector4 x, y, rSquared, z;
+			UniformToDisk(u, g, &x, &y, &rSquared);
+			z = jlVector4::ONE - rSquared;
+			z.setMax(z, jlVector4::ZERO);
+			jlVector4 *dst = out + first + 4 * g;
+			const int32 lanes = (n - 4 * g < 4) ? n - 4 * g : 4;
+			StoreTransposed(x, y, jlMath::Sqrt(z), dst, lanes);
+			for (int32 l = 0; l < lanes; ++l) {
+				dst[l] = basis * dst[l];
+			}
+		}
+	}
+}
+
+template <class R, class T>
+JL_INLINE void jlDistribution::Shuffle(R& random, T *items, int32 count) {
+	PartialShuffle(random, items, count, count);
+}
+
+template <class R, class T>
+JL_INLINE void jlDistribution::PartialShuffle(R& random, T *items, int32 count, int32 k) {
+	JL_ASSERT(k >= 0 && k <= count);
+	uint32 bits[BATCH_SIZE];
+	// the last item has nowhere left to go
+	const int32 swaps = (k < count) ? k : count - 1;
+	for (int32 first = 0; first < swaps; first += BATCH_SIZE) {
+		const int32 n = (swaps - first < BATCH_SIZE) ? swaps - first : BATCH_SIZE;
+		random.fillUint32(bits, n);
+		for (int32 j = 0; j < n; ++j) {
+			const int32 i = first + j;
+			const uint32 range = static_cast<uint32>(count - i);
+			uint32 offset;
+			if (!jlRandom::Bounded(bits[j], range, &offset)) {
+				offset = random.randUint32(range);
+			}
+			T swap = items[i];
+			items[i] = items[i + offset];
+			items[i + offset] = swap;
+		}
+	}
+}
+
+/// Index i is taken with probability needed / remaining, Knuth's algorithm S
+template <class R>
+JL_INLINE void jlDistribution::SampleIndices(R& random, int32 *out, int32 k, int32 n) {
+	JL_ASSERT(k >= 0 && k <= n);
+	uint32 bits[BATCH_SIZE];
+	int32 taken = 0;
+	for (int32 first = 0; taken < k; first += BATCH_SIZE) {
+		const int32 batch = (n - first < BATCH_SIZE) ? n - first : BATCH_SIZE;
+		random.fillUint32(bits, batch);
+		for (int32 j = 0; j < batch && taken < k; ++j) {
+			const int32 i = first + j;
+			const uint32 remaining = static_cast<uint32>(n - i);
+			uint32 r;
+			if (!jlRandom::Bounded(bits[j], remaining, &r)) {
+				r = random.randUint32(remaining);
+			}
+			if (r < static_cast<uint32>(k - taken)) {
+				out[taken++] = i;
+			}
+		}
+	}
+}
+
+JL_FORCE_INLINE void jlDistribution::UniformToDisk(const float32 *u, int32 group, jlVector4 *x, jlVector4 *y, jlVector4 *rSquared) {
+	jlVector4 phi, s, c;
+	rSquared->loadAligned(u + 8 * group);
+	phi.loadAligned(u + 8 * group + 4);
+	jlMath::SinCos(phi * jlSimdFloat(2.0f * jlMath::PI), &s, &c);
+	jlVector4 r = jlMath::Sqrt(*rSquared);
+	*x = r * c;
+	*y = r * s;
+}
+
+JL_FORCE_INLINE void jlDistribution::StoreTransposed(const jlVector4& x, const jlVector4& y, const jlVector4& z, jlVector4 *out, int32 count) {
+	const jlMatrix4 m(x, y, z, jlVector4::ZERO);
+	const int32 lanes = (count < 4) ? count : 4;
+	for (int32 l = 0; l < lanes; ++l) {
+		out[l] = m.getRow(l);
+	}
+}
@@ -0,0 +1,71 @@
+/// @file jlFPEnvironment.h
+/// @author Jeff Lansing
+
+#ifndef JL_FP_ENVIRONMENT_H
+#define JL_FP_ENVIRONMENT_H
+
+#include "jlCore.h"
+
+/// Scoped control of the SSE floating point environment (MXCSR)
+/// Sets flush to zero/denormals are zero and the rounding mode on
+/// construction and restores the previous control bits on destruction.
+/// MXCSR is per thread so a guard only affects the thread it lives on,
+/// and since each guard restores what it saved, guards nest.
+/// Exception flags raised inside the scope are kept on restore so a
+/// sample taken after the guard still sees them.
+/// Only SSE math is affected, x87 code in FPU builds keeps its own state.
+class jlFPEnvironment {
+public:
+	enum Rounding {
+		ROUNDING_NEAREST,
+		ROUNDING_DOWN,
+		ROUNDING_UP,
+		ROUNDING_TOWARD_ZERO
+	};
+
+	/// Sticky exception flags, the same bits as the low 6 of MXCSR
+	enum Exception {
+		EXCEPTION_INVALID = 0x01,
+		EXCEPTION_DENORMAL = 0x02,
+		EXCEPTION_DIVIDE_BY_ZERO = 0x04,
+		EXCEPTION_OVERFLOW = 0x08,
+		EXCEPTION_UNDERFLOW = 0x10,
+		EXCEPTION_INEXACT = 0x20,
+		EXCEPTION_ALL = 0x3F,
+		// what Sample reports, inexact is raised by nearly every op
+		EXCEPTION_REPORTED = EXCEPTION_ALL & ~EXCEPTION_INEXACT
+	};
+
+	typedef void (*ReportHandler)(const char8 *tag, uint32 exceptions, const char8 *file, int32 line);
+
+	explicit jlFPEnvironment(bool32 flushDenormals = true, Rounding rounding = ROUNDING_NEAREST);
+	~jlFPEnvironment();
+
+	static bool32 IsFlushingDenormals();
+	static Rounding GetRounding();
+
+	// sticky exception flags of the calling thread
+	static uint32 GetExceptions();
+	static void ClearExceptions();
+
+	/// Reports the EXCEPTION_REPORTED flags raised since the last sample
+	/// to the report handler, then clears them so the next sample only
+	/// sees its own kernel.  Returns the reported flags.
+	static uint32 Sample(const char8 *tag, const char8 *file, int32 line);
+	static void SetReportHandler(ReportHandler handler);
+	static ReportHandler GetReportHandler();
+private:
+	JL_DISALLOW_COPY_AND_ASSIGN(jlFPEnvironment);
+
+	uint32 savedControl;
+};
+
+/// Tags a kernel for the floating point diagnostics, define
+/// JL_FP_DIAGNOSTICS to sample the exception flags at each tag
+#ifdef JL_FP_DIAGNOSTICS
+#	define JL_FP_SAMPLE(tag) jlFPEnvironment::Sample((tag), __FILE__, __LINE__)
+#else
+#	define JL_FP_SAMPLE(tag) JL_UNUSED(tag)
+#endif
+
+#endif // JL_FP_ENVIRONMENT_H
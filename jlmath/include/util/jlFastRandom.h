@@ -0,0 +1,67 @@
+/// @file jlFastRandom.h
+/// @author Jeff Lansing
+
+#ifndef JL_FAST_RANDOM_H
+#define JL_FAST_RANDOM_H
+
+#include "jlCore.h"
+
+class jlVector4;
+
+/// Four xoshiro128++ generators side by side
+/// Word k of every lane's state is kept in state[k], so one step of the
+/// recursion is a handful of SSE2 shifts and xors and gives four uint32s.
+/// The whole generator is 96 bytes and needs no init, which makes it
+/// cheap enough to embed one per emitter, agent or entity.  Seeds are
+/// expanded by splitmix64, so nearby seeds give unrelated streams.
+/// Period is 2^128 - 1 per lane, the jlDistribution samplers accept it
+/// like jlRandom.
+class jlFastRandom {
+public:
+	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
+
+	jlFastRandom();
+	explicit jlFastRandom(uint64 seed);
+
+	// sets all four lanes from seed, values left in the current block are dropped
+	void seed(uint64 seed = jlFastRandom::DEFAULT_SEED);
+	/// Advances every lane by 2^64 steps, so generators jumped 0, 1, 2...
+	/// times from one seed never overlap
+	void jump();
+
+	// get a random uint/int/float, the same conversions as jlRandom
+	uint32 randUint32();
+	uint32 randUint32(uint32 max);
+	uint32 randUint32(uint32 min, uint32 max);
+	int32 randInt32();
+	int32 randInt32(int32 max);
+	int32 randInt32(int32 min, int32 max);
+	float32 randFloat32();
+	float32 randFloat32(float32 max);
+	float32 randFloat32(float32 min, float32 max);
+	/// One fresh step of the four lanes as floats in [min, max), top 23
+	/// bits like fillFloat32, the current block is left for randUint32
+	jlVector4 randVector4();
+	jlVector4 randVector4(const jlVector4& min, const jlVector4& max);
+
+	/// Bulk draws, the same values as count calls to randUint32
+	void fillUint32(uint32 *out, int32 count);
+	void fillUint32(uint32 *out, int32 count, uint32 max);
+	void fillFloat32(float32 *out, int32 count, float32 min = 0.0f, float32 max = 1.0f);
+	void fillVector4(jlVector4 *out, int32 count, const jlVector4& min, const jlVector4& max);
+
+	static const uint64 DEFAULT_SEED = 1234;
+	// uint32s per step
+	static const int32 BLOCK_SIZE = 4;
+private:
+	// the next four outputs, lane l's in out[l]
+	void step(uint32 *out);
+
+	// word k of the four lanes
+	JL_ALIGN_16 quadint128 state[4];
+	// the current step's outputs, idx is the next unread value
+	uint32 block[BLOCK_SIZE];
+	int32 idx;
+};
+
+#endif // JL_FAST_RANDOM_H
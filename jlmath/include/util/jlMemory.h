@@ -24,13 +24,67 @@ bool8 jlMemoryIsAligned(void *ptr, size_t sz, size_t alignment);
 
 /// Ensures a memory alignment which new/malloc do not guarantee
 /// Use for SIMD types and others that require aligned access
+/// _aligned_malloc on MSVC and MinGW, posix_memalign elsewhere
 void * jlAllocAligned(size_t sz, size_t alignment);
 
 /// Frees a block of memory aligned with jlAllocAligned
 void jlFreeAligned(void *ptr);
 
+/// Size class cache for small aligned blocks
+/// Blocks of up to MAX_CACHED_SIZE bytes aligned to at most 64 come from
+/// per size class free lists carved out of 16KB chunks, so a new/delete
+/// pair of a jlVector4 or jlMatrix4 is a lock free pop and push.  Free
+/// needs the size and alignment the block was allocated with, anything
+/// larger or more aligned falls through to jlAllocAligned.
+void * jlAllocAlignedCached(size_t sz, size_t alignment);
+void jlFreeAlignedCached(void *ptr, size_t sz, size_t alignment);
+
+/// Returns every cached chunk to the heap.  Only call at shutdown, once
+/// all cached blocks are freed and no other thread is allocating.
+void jlMemoryReleaseCache();
+
+/// Counters of the cached allocators since the last reset
+/// cacheHits and cacheFrees are only counted in debug builds
+struct jlMemoryStats {
+	// allocations popped straight off a free list
+	int32 cacheHits;
+	// allocations that had to carve a new chunk
+	int32 cacheMisses;
+	int32 cacheFrees;
+	// chunks currently held by the cache
+	int32 cacheChunks;
+	// allocations too large or too aligned for a size class
+	int32 uncachedAllocs;
+};
+
+void jlMemoryGetStats(jlMemoryStats *stats);
+// zeroes the counters, cacheChunks is kept
+void jlMemoryResetStats();
+
+static const size_t JL_MEMORY_MAX_CACHED_SIZE = 256;
+
 /// A simple macro that easily lets classes override new/delete 
 /// to work with AllocAligned and FreeAligned to a given alignment
+/// With JL_USE_ALIGNED_BLOCK_CACHE small objects use the cached versions,
+/// the sized deletes give the size the cache needs to find the free list
+#if (JL_USE_ALIGNED_BLOCK_CACHE)
+#define JL_DECLARE_ALIGNED_ALLOC_OBJECT(ALIGNMENT) \
+	static void * operator new(size_t sz) { \
+		return jlAllocAlignedCached(sz, (ALIGNMENT)); \
+	} \
+	\
+	static void * operator new[](size_t sz) { \
+		return jlAllocAlignedCached(sz, (ALIGNMENT)); \
+	} \
+	\
+	static void operator delete(void *ptr, size_t sz) { \
+		jlFreeAlignedCached(ptr, sz, (ALIGNMENT)); \
+	} \
+	\
+	static void operator delete[](void *ptr, size_t sz) { \
+		jlFreeAlignedCached(ptr, sz, (ALIGNMENT)); \
+	}
+#else
 #define JL_DECLARE_ALIGNED_ALLOC_OBJECT(ALIGNMENT) \
 	static void * operator new(size_t sz) { \
 		return jlAllocAligned(sz, (ALIGNMENT)); \
@@ -47,6 +101,7 @@ void jlFreeAligned(void *ptr);
 	static void operator delete[](void *ptr) { \
 		jlFreeAligned(ptr); \
 	}
+#endif
 
 /// Use if you explictly don't want aligned allocations
 /// Or if for some reason, a base class needs it and it doesn't/can't
@@ -0,0 +1,139 @@
+/// @file jlQuasiRandom.h
+/// @author Jeff Lansing
+
+#ifndef JL_QUASI_RANDOM_H
+#define JL_QUASI_RANDOM_H
+
+#include "jlCore.h"
+
+class jlVector4;
+class jlRandom;
+
+/// Low discrepancy point sequences for integration and stratified placement
+/// All three share one interface: next writes every dimension of one point,
+/// fillVector4 writes the first four dimensions of count points and
+/// fillSoA writes dimension d of point i to out[d * count + i].  Dimensions
+/// past getDimensions() read as 0 in a jlVector4.  Point 0 is the origin
+/// until randomize is called, randomized copies seeded differently give
+/// independent estimates for error bars.
+
+/// Sobol points with Joe and Kuo's new-joe-kuo-6.21201 direction numbers
+/// Point i is the xor of the direction numbers picked by the bits of the
+/// Gray code of i, so consecutive points differ by one xor per dimension.
+/// fillSoA steps a dimension four points at a time: points 4q to 4q + 3
+/// are the same value xored with 0, v0, v0 ^ v1 and v1.
+class jlSobol {
+public:
+	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
+
+	jlSobol();
+	explicit jlSobol(int32 dimensions);
+
+	// unscrambled directions, restarts at point 0
+	void init(int32 dimensions);
+	/// Matousek's random linear scrambling of the direction numbers plus a
+	/// random digital shift, an affine form of Owen scrambling that keeps
+	/// the net properties and costs nothing per point.  Keeps the index.
+	void randomize(jlRandom& random);
+
+	int32 getDimensions() const;
+	uint32 getIndex() const;
+	// jumps straight to point index
+	void setIndex(uint32 index);
+
+	void next(float32 *out);
+	jlVector4 nextVector4();
+	void fillVector4(jlVector4 *out, int32 count);
+	void fillSoA(float32 *out, int32 count);
+
+	static const int32 MAX_DIMENSIONS = 32;
+	static const int32 BITS = 32;
+private:
+	// direction[j][d] is bit j's direction number for dimension d, so four
+	// dimensions of one bit load together
+	JL_ALIGN_16 uint32 direction[BITS][MAX_DIMENSIONS];
+	// digital shift, xored onto every point
+	JL_ALIGN_16 uint32 shift[MAX_DIMENSIONS];
+	// point index before the shift
+	JL_ALIGN_16 uint32 current[MAX_DIMENSIONS];
+	int32 dimensions;
+	uint32 index;
+};
+
+/// Halton points, dimension d is the radical inverse of the index in the
+/// d-th prime.  Each dimension keeps its digits and the exact numerator
+/// of the inverse over base^digits, so stepping is a digit increment with
+/// carries and nothing drifts.  Higher bases correlate in pairs for the
+/// first few hundred points, prefer jlSobol past eight or so dimensions.
+class jlHalton {
+public:
+	jlHalton();
+	explicit jlHalton(int32 dimensions);
+
+	void init(int32 dimensions);
+	/// Cranley-Patterson rotation, every dimension is offset by a random
+	/// amount and wrapped into [0, 1).  Keeps the index.
+	void randomize(jlRandom& random);
+
+	int32 getDimensions() const;
+	uint32 getIndex() const;
+	void setIndex(uint32 index);
+
+	void next(float32 *out);
+	jlVector4 nextVector4();
+	void fillVector4(jlVector4 *out, int32 count);
+	void fillSoA(float32 *out, int32 count);
+
+	static const int32 MAX_DIMENSIONS = 32;
+	// enough base 2 digits for any uint32 index
+	static const int32 MAX_DIGITS = 32;
+private:
+	// radical inverse of the next index for dimension d
+	float32 value(int32 d) const;
+	void step(int32 d);
+
+	uint8 digits[MAX_DIMENSIONS][MAX_DIGITS];
+	// inverse is numerator / base^digitCount
+	uint64 numerator[MAX_DIMENSIONS];
+	// base^(digitCount - 1), the weight of the lowest digit
+	uint64 topWeight[MAX_DIMENSIONS];
+	float64 scale[MAX_DIMENSIONS];
+	float64 offset[MAX_DIMENSIONS];
+	int32 dimensions;
+	uint32 index;
+};
+
+/// Roberts' R_d Kronecker sequence, point i is frac(offset + i alpha) with
+/// alpha_k = phi^-(k + 1) and phi the real root of x^(d + 1) = x + 1, the
+/// R2 sequence when d is 2.  Positions are 0.64 fixed point so the adds
+/// wrap exactly and long runs do not drift.  It has the lowest per point
+/// cost and no preferred sample counts, but only Sobol stratifies.
+class jlKronecker {
+public:
+	JL_DECLARE_ALIGNED_ALLOC_OBJECT(16);
+
+	jlKronecker();
+	explicit jlKronecker(int32 dimensions);
+
+	void init(int32 dimensions);
+	/// Cranley-Patterson rotation, a random start per dimension
+	void randomize(jlRandom& random);
+
+	int32 getDimensions() const;
+	uint32 getIndex() const;
+	void setIndex(uint32 index);
+
+	void next(float32 *out);
+	jlVector4 nextVector4();
+	void fillVector4(jlVector4 *out, int32 count);
+	void fillSoA(float32 *out, int32 count);
+
+	static const int32 MAX_DIMENSIONS = 32;
+private:
+	JL_ALIGN_16 uint64 alpha[MAX_DIMENSIONS];
+	JL_ALIGN_16 uint64 offset[MAX_DIMENSIONS];
+	int32 dimensions;
+	uint32 index;
+};
+
+#endif // JL_QUASI_RANDOM_H
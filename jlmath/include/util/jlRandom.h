@@ -3,6 +3,8 @@
 
 #include "jlCore.h"
 
+class jlVector4;
+
 /// A SIMD optimized random number generator
 /// Adapted from SFMT: http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/SFMT/
 class jlRandom {
@@ -11,6 +13,7 @@ public:
 	~jlRandom();
 
 	// check/allocate/use existing space for the random number generator
+	// sizes are in quadint128s, anything below STATE_SIZE is raised to it
 	bool32 isInit() const;
 	void init(int32 size);
 	// will use an existing buffer, which must be deleted elsewhere
@@ -19,7 +22,27 @@ public:
 	// set the desired seed for the rng
 	void seed(uint32 seed = jlRandom::DEFAULT_SEED);
 
-	// get a random uint/int/float
+	/// Keeps a second buffer of the same size that is generated a few
+	/// quads at a time while the first is drawn from, so running off the
+	/// end is a pointer swap rather than a full refill.  The values are
+	/// the same as without it.  Turning it on, seed and jump each pay for
+	/// one refill up front.
+	jlResult setDoubleBuffered(bool32 doubleBuffered);
+	bool32 getDoubleBuffered() const;
+
+	/// Advances the state by 2^128 quadint128 steps (2^130 uint32s), so
+	/// generators jumped 0, 1, 2... times from one seed never overlap.
+	/// Values left in the current buffer are dropped, the next value is
+	/// the first one past the jump.
+	void jump();
+	/// Jumps by a polynomial in SFMT-jump's string format, lowest degree
+	/// first, as written by its calc-jump tool for SFMT19937
+	void jump(const char8 *jumpString);
+	/// Takes the buffer and position of src, both must be the same size
+	void copyState(const jlRandom& src);
+
+	// get a random uint/int/float, bounded ints are in [min, max) and use
+	// Lemire's multiply-shift with rejection so they are exact for any bound
 	uint32 randUint32();
 	uint32 randUint32(uint32 max);
 	uint32 randUint32(uint32 min, uint32 max);
@@ -30,6 +53,21 @@ public:
 	float32 randFloat32(float32 max);
 	float32 randFloat32(float32 min, float32 max);
 
+	/// Bulk draws, the same uint32s as count calls to randUint32.  Runs of
+	/// at least STATE_SIZE quads go straight into a 16 byte aligned out
+	/// without passing through the internal buffer.
+	void fillUint32(uint32 *out, int32 count);
+	/// Uniform in [0, max), the multiplies run four lanes at a time and the
+	/// rare rejected lanes are redrawn one by one afterwards
+	void fillUint32(uint32 *out, int32 count, uint32 max);
+	/// The top 23 bits of each draw are OR-ed into the mantissa of 1.0f,
+	/// four at a time, so floats step by 2^-23 rather than randFloat32's 2^-32
+	void fillFloat32(float32 *out, int32 count, float32 min = 0.0f, float32 max = 1.0f);
+	void fillVector4(jlVector4 *out, int32 count, const jlVector4& min, const jlVector4& max);
+	/// Uniform directions on the unit sphere with w of 0, z and the angle
+	/// around it are drawn for four vectors at once
+	void fillUnitVectors(jlVector4 *out, int32 count);
+
 	int32 getSize() const; // size of the internal buffer
 	int32 getSize32() const; // size if regarded as 32 bit ints
 	const quadint128 * getBuffer() const;
@@ -38,17 +76,50 @@ public:
 	void setOwnsBuffer(bool32 ownsBuffer);
 
 	static float32 ToFloat32(uint32 rnum);
+	/// Turns count uint32 draws stored in data into floats in [min, max)
+	/// in place, the same conversion as fillFloat32
+	static void BitsToFloat32(float32 *data, int32 count, float32 min, float32 max);
+	/// Lemire's bound of count uint32 draws in data, in place.  Draws
+	/// that would be biased are left as max, the return is how many of
+	/// them need redrawing with randUint32(max).
+	static int32 BitsToBounded(uint32 *data, int32 count, uint32 max);
+	/// One draw x bounded to [0, max), returns false when x is rejected
+	static bool32 Bounded(uint32 x, uint32 max, uint32 *out);
+	// refills the buffer, the state in its last STATE_SIZE quads is
+	// advanced so any size gives the same SFMT19937 sequence
 	static void GenerateRandomValues(quadint128 *buffer, int32 size);
 	//static void UpdateCertification
 
 	static const uint32 DEFAULT_SEED = 1234;
+	// SFMT19937 state in quadint128s, also the smallest buffer
+	static const int32 STATE_SIZE = 156;
 private:
 	void updateCertification(uint32 *ubufferPtr);
+	// writes count >= STATE_SIZE quads continuing from state, state may
+	// be the last STATE_SIZE quads of out
+	static void GenerateFromState(const quadint128 *state, quadint128 *out, int32 count);
+	// quads [from, to) of the block that continues from state, so a
+	// block can be generated in pieces
+	static void GenerateRange(const quadint128 *state, quadint128 *out, int32 from, int32 to);
+	// one step of the recursion on a STATE_SIZE ring starting at pos
+	static void NextState(quadint128 *state, int32 pos);
+	// finishes the back buffer and makes it the current one
+	void swapBuffers();
+	// refills or swaps at the end of the buffer and advances the back
+	// buffer, then sets the draw that next needs either
+	void advance();
+	// starts drawing from the state at the end of the buffer
+	void restart();
 	JL_DISALLOW_COPY_AND_ASSIGN(jlRandom);
 
 	JL_ALIGN_16 quadint128 *buffer;
+	// next block while double buffered, backProgress quads of it are ready
+	quadint128 *backBuffer;
+	int32 backProgress;
 	int32 size;
 	int32 idx;
+	// randUint32 only leaves its fast path once idx reaches this
+	int32 nextStep;
 	uint8 flags;
 };
 
@@ -0,0 +1,46 @@
+/// @file jlRandomStreams.h
+/// @author Jeff Lansing
+
+#ifndef JL_RANDOM_STREAMS_H
+#define JL_RANDOM_STREAMS_H
+
+#include "jlCore.h"
+#include "util/jlRandom.h"
+
+/// A set of generators from one seed that never overlap
+/// Stream i is the seeded generator jumped i times, 2^128 quadint128s
+/// apart, so results only depend on the seed and the stream index.
+/// Index streams by task or work item rather than by thread, then a run
+/// gives the same numbers however the tasks were scheduled.
+/// Each stream and its buffer sit on their own cache lines so threads
+/// drawing from neighbouring streams do not share writes.
+class jlRandomStreams {
+public:
+	jlRandomStreams();
+	~jlRandomStreams();
+
+	/// Streams are built one after another, each costs a jump of about
+	/// 20000 state steps, so build once and keep them
+	jlResult init(uint32 seed, int32 count, int32 bufferSize = jlRandom::STATE_SIZE);
+	void release();
+	bool32 isInit() const;
+	int32 getCount() const;
+
+	jlRandom& getStream(int32 i);
+	const jlRandom& getStream(int32 i) const;
+private:
+	JL_DISALLOW_COPY_AND_ASSIGN(jlRandomStreams);
+
+	// one generator, the alignment rounds its size up to whole cache lines
+	struct JL_ALIGN(64) Stream {
+		jlRandom random;
+	};
+
+	Stream *streams;
+	quadint128 *buffers;
+	int32 count;
+};
+
+#include "util/jlRandomStreams.inl"
+
+#endif // JL_RANDOM_STREAMS_H
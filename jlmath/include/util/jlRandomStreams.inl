@@ -0,0 +1,17 @@
+JL_FORCE_INLINE bool32 jlRandomStreams::isInit() const {
+	return streams != JL_NULL;
+}
+
+JL_FORCE_INLINE int32 jlRandomStreams::getCount() const {
+	return count;
+}
+
+JL_FORCE_INLINE jlRandom& jlRandomStreams::getStream(int32 i) {
+	JL_SLOW_ASSERT_MSG(i >= 0 && i < count, "Random stream index out of range!");
+	return streams[i].random;
+}
+
+JL_FORCE_INLINE const jlRandom& jlRandomStreams::getStream(int32 i) const {
+	JL_SLOW_ASSERT_MSG(i >= 0 && i < count, "Random stream index out of range!");
+	return streams[i].random;
+}
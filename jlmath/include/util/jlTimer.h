@@ -0,0 +1,30 @@
+/// @file jlTimer.h
+/// @author Jeff Lansing
+
+#ifndef JL_TIMER_H
+#define JL_TIMER_H
+
+#include "jlCore.h"
+
+/// High resolution wall clock timer for benchmarks
+/// Backed by the performance counter, platform headers stay in the .cpp
+class jlTimer {
+public:
+	jlTimer();
+
+	// restart timing from now
+	void start();
+	// time since the last start
+	int64 getElapsedTicks() const;
+	float64 getElapsedSeconds() const;
+	float64 getElapsedMilliseconds() const;
+
+	static int64 GetTicks();
+	static int64 GetTicksPerSecond();
+	// raw time stamp counter, for cycles per element in tight loops
+	static int64 GetCycles();
+private:
+	int64 startTicks;
+};
+
+#endif // JL_TIMER_H
@@ -136,24 +136,26 @@ private:
 	typedef quad128 jlSimdInternalFloat; // used by jlSimdFloat
 	typedef quad128 jlCompMask; // used by jlComp
 
-	const quad128 QUAD_ZERO = _mm_setzero_ps();
-	const quad128 QUAD_MIN = _mm_set_ps1(FLOAT32_MIN);
-	const quad128 QUAD_MAX = _mm_set_ps1(FLOAT32_MAX);
-	const quad128 QUAD_ONE = _mm_set_ps1(1.0f);
-	const quad128 QUAD_TWO = _mm_set_ps1(2.0f);
-	const quad128 QUAD_THREE = _mm_set_ps1(3.0f);
-	const quad128 QUAD_FOUR = _mm_set_ps1(4.0f);
-	const quad128 QUAD_INV_TWO = _mm_set_ps1(0.5f);
-	const quad128 QUAD_INV_THREE = _mm_set_ps1(1.0f / 3.0f);
-	const quad128 QUAD_INV_FOUR = _mm_set_ps1(0.25f);
-	const quad128 QUAD_SINGLE_ZERO = _mm_set_ss(0.0f);
-	const quad128 QUAD_SINGLE_ONE = _mm_set_ss(1.0f);
-	const quad128 QUAD_SINGLE_TWO = _mm_set_ss(2.0f);
-	const quad128 QUAD_SINGLE_THREE = _mm_set_ss(3.0f);
-	const quad128 QUAD_SINGLE_FOUR = _mm_set_ss(4.0f);
-	const quad128 QUAD_SINGLE_INV_TWO = _mm_set_ss(0.5f);
-	const quad128 QUAD_SINGLE_INV_THREE = _mm_set_ss(1.0f / 3.0f);
-	const quad128 QUAD_SINGLE_INV_FOUR = _mm_set_ss(1.0f / 4.0f);
+	// brace initialized so they are constant initialized instead of 
+	// running _mm_set_ps1 in every translation unit at startup
+	const quad128 QUAD_ZERO = { 0.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_MIN = { FLOAT32_MIN, FLOAT32_MIN, FLOAT32_MIN, FLOAT32_MIN };
+	const quad128 QUAD_MAX = { FLOAT32_MAX, FLOAT32_MAX, FLOAT32_MAX, FLOAT32_MAX };
+	const quad128 QUAD_ONE = { 1.0f, 1.0f, 1.0f, 1.0f };
+	const quad128 QUAD_TWO = { 2.0f, 2.0f, 2.0f, 2.0f };
+	const quad128 QUAD_THREE = { 3.0f, 3.0f, 3.0f, 3.0f };
+	const quad128 QUAD_FOUR = { 4.0f, 4.0f, 4.0f, 4.0f };
+	const quad128 QUAD_INV_TWO = { 0.5f, 0.5f, 0.5f, 0.5f };
+	const quad128 QUAD_INV_THREE = { 1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f };
+	const quad128 QUAD_INV_FOUR = { 0.25f, 0.25f, 0.25f, 0.25f };
+	const quad128 QUAD_SINGLE_ZERO = { 0.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_ONE = { 1.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_TWO = { 2.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_THREE = { 3.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_FOUR = { 4.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_INV_TWO = { 0.5f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_INV_THREE = { 1.0f / 3.0f, 0.0f, 0.0f, 0.0f };
+	const quad128 QUAD_SINGLE_INV_FOUR = { 1.0f / 4.0f, 0.0f, 0.0f, 0.0f };
 #else
 	struct quad128 {
 	public:
@@ -161,12 +163,16 @@ private:
 		
 		quad128() { }
 
+#if JL_CONSTEXPR_ENABLED
+		constexpr quad128(float32 x, float32 y, float32 z, float32 w) : v{ x, y, z, w } { }
+#else
 		quad128(float32 x, float32 y, float32 z, float32 w) {
 			v[0] = x;
 			v[1] = y;
 			v[2] = z;
 			v[3] = w;
 		}
+#endif
 
 		quad128(const float32 *arr) { 
 			v[0] = arr[0];
@@ -220,4 +226,25 @@ private:
 	const quad128 QUAD_SINGLE_INV_FOUR(1.0f / 4.0f, 0.0f, 0.0f, 0.0f);
 #endif
 
+// 8 WIDE INTRINSICS quad256/quadint256
+// Only when the compiler targets AVX2 (/arch:AVX2 or -mavx2), there
+// is no runtime check so the build decides
+#if (JL_SIMD_ENABLED && defined(__AVX2__))
+	#include <immintrin.h>
+	#define JL_AVX2_ENABLED 1
+
+	typedef __m256 quad256;
+	typedef __m256i quadint256;
+#else
+	#define JL_AVX2_ENABLED 0
+#endif
+
+// SSE4.1 roundps/blendps, MSVC has no __SSE4_1__ so /arch:AVX turns it on
+#if (JL_SIMD_ENABLED && (defined(__SSE4_1__) || defined(__AVX__)))
+	#include <smmintrin.h>
+	#define JL_SSE41_ENABLED 1
+#else
+	#define JL_SSE41_ENABLED 0
+#endif
+
 #endif // JL_TYPES_H
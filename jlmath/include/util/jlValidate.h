@@ -0,0 +1,25 @@
+/// @file jlValidate.h
+/// @author Jeff Lansing
+
+#ifndef JL_VALIDATE_H
+#define JL_VALIDATE_H
+
+#include "jlCore.h"
+
+/// What jlValidateArray found, denormals are counted because they
+/// are slow to compute with even though they are valid numbers
+struct jlValidateReport {
+	int32 firstBad; // index of the first NaN, Inf or denormal, -1 if none
+	int32 nanCount;
+	int32 infCount;
+	int32 denormalCount;
+
+	bool32 isOk() const { return firstBad < 0; }
+};
+
+/// Classifies every value by its exponent bits, 16 floats per step
+/// with no branches until something is found so it runs close to
+/// memory bandwidth.  Cheap enough to run on every simulation step.
+jlValidateReport jlValidateArray(const float32 *values, int32 count);
+
+#endif // JL_VALIDATE_H
@@ -0,0 +1,328 @@
+/// @file jlmath_accuracy.cpp
+/// @author Jeff Lansing
+/// Sweeps every approximate kernel in jlMath over its domain and prints
+/// max/mean ulp, max absolute and relative error and cycles per element
+/// as one table for picking tiers.  Each row is checked against the bound
+/// documented with the kernel and the run exits with 1 if any regress.
+/// Usage: jlmath_accuracy [-exhaustive]
+/// By default about 4M evenly spaced floats are taken from each domain,
+/// -exhaustive visits every float in it (minutes per row for big domains).
+#include <cstdio>
+#include <cstring>
+#include "math/jlVector4.h"
+#include "math/jlTrigTable.h"
+#include "util/jlTimer.h"
+
+namespace {
+	const int32 BATCH_SIZE = 4096;
+	const int64 DEFAULT_SAMPLES = 1 << 22;
+
+	/// Which column a row's bound applies to
+	enum jlBoundType {
+		BOUND_ULP,
+		BOUND_ABS,
+		BOUND_REL
+	};
+
+	typedef void (*jlKernelFunc)(const float32 *x, float32 *out, int32 n);
+	typedef float64 (*jlReferenceFunc)(float64 x);
+
+	struct jlKernelCase {
+		const char8 *name;
+		jlKernelFunc kernel;
+		jlReferenceFunc reference;
+		float32 lo;
+		float32 hi;
+		jlBoundType boundType;
+		float64 bound;
+		// timing range when the domain would time denormal results, 0 0 uses the domain
+		float32 timeLo;
+		float32 timeHi;
+	};
+
+	struct jlKernelError {
+		float64 maxUlp;
+		float64 sumUlp;
+		float64 maxAbs;
+		float64 maxRel;
+		int64 samples;
+	};
+
+	// references in double, the CRT of MSVC 2010 has no exp2/log2
+	float64 RefSin(float64 x) { return sin(x); }
+	float64 RefCos(float64 x) { return cos(x); }
+	float64 RefTan(float64 x) { return tan(x); }
+	float64 RefASin(float64 x) { return asin(x); }
+	float64 RefACos(float64 x) { return acos(x); }
+	float64 RefATan(float64 x) { return atan(x); }
+	float64 RefExp(float64 x) { return exp(x); }
+	float64 RefExp2(float64 x) { return pow(2.0, x); }
+	float64 RefLog(float64 x) { return log(x); }
+	float64 RefLog2(float64 x) { return log(x) / log(2.0); }
+	float64 RefPow(float64 x) { return pow(x, 2.5); }
+	float64 RefReciprocal(float64 x) { return 1.0 / x; }
+	float64 RefInvSqrt(float64 x) { return 1.0 / sqrt(x); }
+	float64 RefNormalize(float64 x) { return 1.0 / sqrt(1.0 + x * x); }
+
+	/// Orders float bit patterns so consecutive integers are consecutive floats
+	int32 FloatToOrdered(float32 f) {
+		int32 i;
+		memcpy(&i, &f, sizeof(i));
+		return (i < 0) ? INT32_MIN - i : i;
+	}
+
+	float32 OrderedToFloat(int32 i) {
+		if (i < 0) i = INT32_MIN - i;
+		float32 f;
+		memcpy(&f, &i, sizeof(f));
+		return f;
+	}
+
+	/// Spacing of floats around v, normals only so errors near zero stay finite
+	float64 UlpOf(float64 v) {
+		float32 f = static_cast<float32>(fabs(v));
+		if (f < FLOAT32_MIN) f = FLOAT32_MIN;
+		int32 e;
+		frexp(f, &e);
+		return ldexp(1.0, e - 24);
+	}
+}
+
+// lane parallel kernels evaluate a loaded jlVector4 v, BATCH_SIZE is a multiple of 4
+#define JL_ACCURACY_VECTOR_KERNEL(NAME, EXPR) \
+	void NAME(const float32 *x, float32 *out, int32 n) { \
+		for (int32 i = 0; i < n; i += 4) { \
+			jlVector4 v; \
+			v.loadAligned(x + i); \
+			(EXPR).storeAligned(out + i); \
+		} \
+	}
+
+#define JL_ACCURACY_TIERED_KERNEL(NAME, FUNC) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##Full, FUNC<jlMath::ACCURACY_FULL>(v)) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##Medium, FUNC<jlMath::ACCURACY_MEDIUM>(v)) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##Low, FUNC<jlMath::ACCURACY_LOW>(v))
+
+#define JL_ACCURACY_PRECISION_KERNEL(NAME, FUNC) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##Raw, FUNC<jlMath::PRECISION_RAW>(v)) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##OneNewton, FUNC<jlMath::PRECISION_ONE_NEWTON>(v)) \
+	JL_ACCURACY_VECTOR_KERNEL(NAME##TwoNewton, FUNC<jlMath::PRECISION_TWO_NEWTON>(v))
+
+namespace {
+	JL_ACCURACY_TIERED_KERNEL(Sin, jlMath::Sin)
+	JL_ACCURACY_TIERED_KERNEL(Cos, jlMath::Cos)
+	JL_ACCURACY_TIERED_KERNEL(Tan, jlMath::Tan)
+	JL_ACCURACY_TIERED_KERNEL(ASin, jlMath::ASin)
+	JL_ACCURACY_TIERED_KERNEL(ACos, jlMath::ACos)
+	JL_ACCURACY_TIERED_KERNEL(ATan, jlMath::ATan)
+	JL_ACCURACY_TIERED_KERNEL(Exp, jlMath::Exp)
+	JL_ACCURACY_TIERED_KERNEL(Exp2, jlMath::Exp2)
+	JL_ACCURACY_TIERED_KERNEL(Log, jlMath::Log)
+	JL_ACCURACY_TIERED_KERNEL(Log2, jlMath::Log2)
+	JL_ACCURACY_PRECISION_KERNEL(Reciprocal, jlMath::Reciprocal)
+	JL_ACCURACY_PRECISION_KERNEL(InvSqrt, jlMath::InvSqrt)
+
+	template <jlMath::Accuracy A>
+	void Pow(const float32 *x, float32 *out, int32 n) {
+		const jlVector4 y = jlVector4(2.5f, 2.5f, 2.5f, 2.5f);
+		for (int32 i = 0; i < n; i += 4) {
+			jlVector4 v;
+			v.loadAligned(x + i);
+			jlMath::Pow<A>(v, y).storeAligned(out + i);
+		}
+	}
+
+	void FastSin(const float32 *x, float32 *out, int32 n) {
+		for (int32 i = 0; i < n; ++i) {
+			out[i] = jlMath::FastSin(jlSimdFloat(x[i])).getFloat();
+		}
+	}
+
+	void FastCos(const float32 *x, float32 *out, int32 n) {
+		for (int32 i = 0; i < n; ++i) {
+			out[i] = jlMath::FastCos(jlSimdFloat(x[i])).getFloat();
+		}
+	}
+
+	void FastInvSqrt(const float32 *x, float32 *out, int32 n) {
+		for (int32 i = 0; i < n; ++i) {
+			out[i] = jlMath::FastInvSqrt(x[i]);
+		}
+	}
+
+	/// x component of (1, x, 0) normalized, which is 1 / sqrt(1 + x^2)
+	template <jlMath::Precision P>
+	void Normalize3(const float32 *x, float32 *out, int32 n) {
+		for (int32 i = 0; i < n; ++i) {
+			jlVector4 v = jlVector4(1.0f, x[i], 0.0f);
+			v.normalize3<P>();
+			out[i] = v(0);
+		}
+	}
+
+	void Normalize3Default(const float32 *x, float32 *out, int32 n) {
+		for (int32 i = 0; i < n; ++i) {
+			jlVector4 v = jlVector4(1.0f, x[i], 0.0f);
+			v.normalize3();
+			out[i] = v(0);
+		}
+	}
+
+	template <jlTrigTable::Filter F>
+	void TableSin(const float32 *x, float32 *out, int32 n) {
+		jlTrigTable::GetDefault().sin<F>(x, out, n);
+	}
+
+	template <jlTrigTable::Filter F>
+	void TableCos(const float32 *x, float32 *out, int32 n) {
+		jlTrigTable::GetDefault().cos<F>(x, out, n);
+	}
+
+	/// Bounds are the ones documented next to each kernel, which are the
+	/// measured maxima, so a row only fails past BOUND_MARGIN times its bound
+	const float64 BOUND_MARGIN = 1.25;
+
+	const jlKernelCase KERNEL_CASES[] = {
+		{ "Sin FULL",             SinFull,      RefSin,  -100.0f,  100.0f,  BOUND_ULP, 1.5, 0.0f, 0.0f },
+		{ "Sin FULL",             SinFull,      RefSin,  -8192.0f, 8192.0f, BOUND_ABS, 7.7e-8, 0.0f, 0.0f },
+		{ "Sin MEDIUM",           SinMedium,    RefSin,  -8192.0f, 8192.0f, BOUND_ABS, 3.7e-5, 0.0f, 0.0f },
+		{ "Sin LOW",              SinLow,       RefSin,  -100.0f,  100.0f,  BOUND_ABS, 1.1e-3, 0.0f, 0.0f },
+		{ "Sin LOW",              SinLow,       RefSin,  -8192.0f, 8192.0f, BOUND_ABS, 1.6e-3, 0.0f, 0.0f },
+		{ "Cos FULL",             CosFull,      RefCos,  -100.0f,  100.0f,  BOUND_ULP, 1.5, 0.0f, 0.0f },
+		{ "Cos FULL",             CosFull,      RefCos,  -8192.0f, 8192.0f, BOUND_ABS, 7.7e-8, 0.0f, 0.0f },
+		{ "Cos MEDIUM",           CosMedium,    RefCos,  -8192.0f, 8192.0f, BOUND_ABS, 3.7e-5, 0.0f, 0.0f },
+		{ "Cos LOW",              CosLow,       RefCos,  -100.0f,  100.0f,  BOUND_ABS, 1.1e-3, 0.0f, 0.0f },
+		{ "Cos LOW",              CosLow,       RefCos,  -8192.0f, 8192.0f, BOUND_ABS, 1.6e-3, 0.0f, 0.0f },
+		{ "FastSin",              FastSin,      RefSin,  -100.0f,  100.0f,  BOUND_ABS, 1.1e-3, 0.0f, 0.0f },
+		{ "FastCos",              FastCos,      RefCos,  -100.0f,  100.0f,  BOUND_ABS, 1.1e-3, 0.0f, 0.0f },
+		{ "Tan FULL",             TanFull,      RefTan,  -1.4f,    1.4f,    BOUND_ULP, 3.0, 0.0f, 0.0f },
+		{ "Tan MEDIUM",           TanMedium,    RefTan,  -1.4f,    1.4f,    BOUND_REL, 6e-5, 0.0f, 0.0f },
+		{ "Tan LOW",              TanLow,       RefTan,  -1.4f,    1.4f,    BOUND_REL, 1.4e-2, 0.0f, 0.0f },
+		{ "ASin FULL",            ASinFull,     RefASin, -1.0f,    1.0f,    BOUND_ULP, 2.4, 0.0f, 0.0f },
+		{ "ASin MEDIUM",          ASinMedium,   RefASin, -1.0f,    1.0f,    BOUND_ABS, 6.8e-5, 0.0f, 0.0f },
+		{ "ASin LOW",             ASinLow,      RefASin, -1.0f,    1.0f,    BOUND_ABS, 3.3e-3, 0.0f, 0.0f },
+		{ "ACos FULL",            ACosFull,     RefACos, -1.0f,    1.0f,    BOUND_ULP, 1.3, 0.0f, 0.0f },
+		{ "ACos MEDIUM",          ACosMedium,   RefACos, -1.0f,    1.0f,    BOUND_ABS, 6.8e-5, 0.0f, 0.0f },
+		{ "ACos LOW",             ACosLow,      RefACos, -1.0f,    1.0f,    BOUND_ABS, 3.3e-3, 0.0f, 0.0f },
+		{ "ATan FULL",            ATanFull,     RefATan, -100.0f,  100.0f,  BOUND_ULP, 2.7, 0.0f, 0.0f },
+		{ "ATan MEDIUM",          ATanMedium,   RefATan, -100.0f,  100.0f,  BOUND_ABS, 1.2e-5, 0.0f, 0.0f },
+		{ "ATan LOW",             ATanLow,      RefATan, -100.0f,  100.0f,  BOUND_ABS, 1.6e-3, 0.0f, 0.0f },
+		{ "Exp FULL",             ExpFull,      RefExp,  -87.0f,   88.0f,   BOUND_ULP, 1.4, 0.0f, 0.0f },
+		{ "Exp MEDIUM",           ExpMedium,    RefExp,  -87.0f,   88.0f,   BOUND_REL, 1.1e-4, 0.0f, 0.0f },
+		{ "Exp LOW",              ExpLow,       RefExp,  -87.0f,   88.0f,   BOUND_REL, 3.2e-3, 0.0f, 0.0f },
+		{ "Exp2 FULL",            Exp2Full,     RefExp2, -126.0f,  127.0f,  BOUND_ULP, 1.6, 0.0f, 0.0f },
+		{ "Exp2 MEDIUM",          Exp2Medium,   RefExp2, -126.0f,  127.0f,  BOUND_REL, 1.1e-4, 0.0f, 0.0f },
+		{ "Exp2 LOW",             Exp2Low,      RefExp2, -126.0f,  127.0f,  BOUND_REL, 3.2e-3, 0.0f, 0.0f },
+		{ "Log FULL",             LogFull,      RefLog,  FLOAT32_MIN, FLOAT32_MAX, BOUND_ULP, 0.8, 0.0f, 0.0f },
+		{ "Log MEDIUM",           LogMedium,    RefLog,  FLOAT32_MIN, FLOAT32_MAX, BOUND_ABS, 2.4e-5, 0.0f, 0.0f },
+		{ "Log LOW",              LogLow,       RefLog,  FLOAT32_MIN, FLOAT32_MAX, BOUND_ABS, 9.0e-4, 0.0f, 0.0f },
+		{ "Log2 FULL",            Log2Full,     RefLog2, FLOAT32_MIN, FLOAT32_MAX, BOUND_ULP, 1.3, 0.0f, 0.0f },
+		{ "Log2 MEDIUM",          Log2Medium,   RefLog2, FLOAT32_MIN, FLOAT32_MAX, BOUND_ABS, 2.9e-5, 0.0f, 0.0f },
+		{ "Log2 LOW",             Log2Low,      RefLog2, FLOAT32_MIN, FLOAT32_MAX, BOUND_ABS, 1.3e-3, 0.0f, 0.0f },
+		{ "Pow(x, 2.5) FULL",     Pow<jlMath::ACCURACY_FULL>,   RefPow, 2.4e-4f, 4096.0f, BOUND_ULP, 3.0, 0.0f, 0.0f },
+		{ "Pow(x, 2.5) MEDIUM",   Pow<jlMath::ACCURACY_MEDIUM>, RefPow, 2.4e-4f, 4096.0f, BOUND_REL, 1.7e-4, 0.0f, 0.0f },
+		{ "Pow(x, 2.5) LOW",      Pow<jlMath::ACCURACY_LOW>,    RefPow, 2.4e-4f, 4096.0f, BOUND_REL, 6.4e-3, 0.0f, 0.0f },
+		{ "Reciprocal RAW",       ReciprocalRaw,       RefReciprocal, FLOAT32_MIN, 8.5e37f, BOUND_REL, 3.0e-4, 1.0e-3f, 1.0e3f },
+		{ "Reciprocal ONE_NEWTON", ReciprocalOneNewton, RefReciprocal, FLOAT32_MIN, 8.5e37f, BOUND_ULP, 3.4, 1.0e-3f, 1.0e3f },
+		{ "Reciprocal TWO_NEWTON", ReciprocalTwoNewton, RefReciprocal, FLOAT32_MIN, 8.5e37f, BOUND_ULP, 1.4, 1.0e-3f, 1.0e3f },
+		{ "InvSqrt RAW",          InvSqrtRaw,       RefInvSqrt, FLOAT32_MIN, FLOAT32_MAX, BOUND_REL, 3.3e-4, 0.0f, 0.0f },
+		{ "InvSqrt ONE_NEWTON",   InvSqrtOneNewton, RefInvSqrt, FLOAT32_MIN, FLOAT32_MAX, BOUND_ULP, 4.0, 0.0f, 0.0f },
+		{ "InvSqrt TWO_NEWTON",   InvSqrtTwoNewton, RefInvSqrt, FLOAT32_MIN, FLOAT32_MAX, BOUND_ULP, 1.3, 0.0f, 0.0f },
+		{ "FastInvSqrt",          FastInvSqrt,      RefInvSqrt, FLOAT32_MIN, FLOAT32_MAX, BOUND_REL, 1.8e-3, 0.0f, 0.0f },
+		{ "normalize3",           Normalize3Default,                          RefNormalize, -1.0e4f, 1.0e4f, BOUND_ULP, 4.2, 0.0f, 0.0f },
+		{ "normalize3 RAW",       Normalize3<jlMath::PRECISION_RAW>,          RefNormalize, -1.0e4f, 1.0e4f, BOUND_REL, 3.3e-4, 0.0f, 0.0f },
+		{ "normalize3 TWO_NEWTON", Normalize3<jlMath::PRECISION_TWO_NEWTON>,  RefNormalize, -1.0e4f, 1.0e4f, BOUND_ULP, 2.2, 0.0f, 0.0f },
+		{ "jlTrigTable sin NEAREST", TableSin<jlTrigTable::FILTER_NEAREST>, RefSin, -6.3f, 6.3f, BOUND_ABS, 7.7e-4, 0.0f, 0.0f },
+		{ "jlTrigTable sin LINEAR",  TableSin<jlTrigTable::FILTER_LINEAR>,  RefSin, -6.3f, 6.3f, BOUND_ABS, 8.3e-7, 0.0f, 0.0f },
+		{ "jlTrigTable cos NEAREST", TableCos<jlTrigTable::FILTER_NEAREST>, RefCos, -6.3f, 6.3f, BOUND_ABS, 7.7e-4, 0.0f, 0.0f },
+		{ "jlTrigTable cos LINEAR",  TableCos<jlTrigTable::FILTER_LINEAR>,  RefCos, -6.3f, 6.3f, BOUND_ABS, 8.3e-7, 0.0f, 0.0f }
+	};
+
+	/// Runs one row in batches, the kernel is timed on its own and the
+	/// double precision reference is evaluated outside the timed region
+	jlKernelError SweepKernel(const jlKernelCase& kc, bool8 exhaustive, float32 *x, float32 *out) {
+		jlKernelError err = { 0.0, 0.0, 0.0, 0.0, 0 };
+		int64 first = FloatToOrdered(kc.lo);
+		int64 last = FloatToOrdered(kc.hi);
+		int64 stride = exhaustive ? 1 : jlMath::Max<int64>(1, (last - first) / DEFAULT_SAMPLES);
+		int64 k = first;
+		while (k <= last) {
+			int32 n = 0;
+			for (; n < BATCH_SIZE && k <= last; ++n, k += stride) {
+				x[n] = OrderedToFloat(static_cast<int32>(k));
+			}
+			// pad the last batch with the domain start
+			for (int32 i = n; i < BATCH_SIZE; ++i) {
+				x[i] = kc.lo;
+			}
+			kc.kernel(x, out, BATCH_SIZE);
+			for (int32 i = 0; i < n; ++i) {
+				float64 expected = kc.reference(static_cast<float64>(x[i]));
+				float64 absErr = fabs(static_cast<float64>(out[i]) - expected);
+				// NaN counts as a failure rather than being skipped
+				if (absErr != absErr) absErr = FLOAT64_INFINITY;
+				float64 ulpErr = absErr / UlpOf(expected);
+				float64 relErr = (expected != 0.0) ? absErr / fabs(expected) : absErr;
+				err.maxAbs = jlMath::Max(err.maxAbs, absErr);
+				err.maxRel = jlMath::Max(err.maxRel, relErr);
+				err.maxUlp = jlMath::Max(err.maxUlp, ulpErr);
+				err.sumUlp += ulpErr;
+			}
+			err.samples += n;
+		}
+		return err;
+	}
+
+	/// Cycles per element over values evenly spaced across the domain.  The
+	/// sweep itself is spaced by bit pattern, so most of its samples are tiny
+	/// and would time denormal stalls rather than the kernel.  Rows whose
+	/// results go denormal over most of the domain give their own range.
+	float64 TimeKernel(const jlKernelCase& kc, float32 *x, float32 *out) {
+		const int32 repeats = 64;
+		const bool8 ownRange = (kc.timeLo != 0.0f || kc.timeHi != 0.0f);
+		const float32 lo = ownRange ? kc.timeLo : kc.lo;
+		const float32 hi = ownRange ? kc.timeHi : kc.hi;
+		for (int32 i = 0; i < BATCH_SIZE; ++i) {
+			x[i] = lo + (hi - lo) * (static_cast<float32>(i) / BATCH_SIZE);
+		}
+		kc.kernel(x, out, BATCH_SIZE);
+		int64 start = jlTimer::GetCycles();
+		for (int32 r = 0; r < repeats; ++r) {
+			kc.kernel(x, out, BATCH_SIZE);
+		}
+		return static_cast<float64>(jlTimer::GetCycles() - start) / (repeats * BATCH_SIZE);
+	}
+
+	float64 BoundedValue(const jlKernelCase& kc, const jlKernelError& err) {
+		switch (kc.boundType) {
+			case BOUND_ULP: return err.maxUlp;
+			case BOUND_ABS: return err.maxAbs;
+			default: return err.maxRel;
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	bool8 exhaustive = (argc > 1 && strcmp(argv[1], "-exhaustive") == 0);
+	const char8 *boundNames[] = { "ulp", "abs", "rel" };
+	float32 *x = static_cast<float32 *>(jlAllocAligned(BATCH_SIZE * sizeof(float32), 16));
+	float32 *out = static_cast<float32 *>(jlAllocAligned(BATCH_SIZE * sizeof(float32), 16));
+	int32 failures = 0;
+	int32 numCases = sizeof(KERNEL_CASES) / sizeof(KERNEL_CASES[0]);
+	jlTrigTable::GetDefault();
+	printf("%-26s %-22s %10s %10s %10s %10s %10s %8s %14s\n", "kernel", "domain", "samples", "max ulp", "mean ulp", "max abs", "max rel", "cyc/elem", "bound");
+	for (int32 c = 0; c < numCases; ++c) {
+		const jlKernelCase& kc = KERNEL_CASES[c];
+		jlKernelError err = SweepKernel(kc, exhaustive, x, out);
+		float64 cycles = TimeKernel(kc, x, out);
+		bool8 passed = BoundedValue(kc, err) <= kc.bound * BOUND_MARGIN;
+		if (!passed) ++failures;
+		printf("%-26s [%-9.3g, %9.3g] %10lld %10.3g %10.3g %10.3g %10.3g %8.2f %s %-6.2g %s\n",
+			kc.name, kc.lo, kc.hi, err.samples, err.maxUlp, err.sumUlp / err.samples, err.maxAbs, err.maxRel,
+			cycles, boundNames[kc.boundType], kc.bound, passed ? "ok" : "FAIL");
+	}
+	jlFreeAligned(x);
+	jlFreeAligned(out);
+	printf("%d of %d kernels past %.2f times their documented bound\n", failures, numCases, BOUND_MARGIN);
+	return (failures > 0) ? 1 : 0;
+}
@@ -1,9 +1,23 @@
 #include <iostream>
+#include <cstring>
 #include "math/jlVector2.h"
 #include "math/jlVector4.h"
+#include "math/jlVector4Stream.h"
 #include "math/jlMatrix4.h"
 #include "math/jlQuaternion.h"
+#include "math/jlTrigTable.h"
+#include "math/jlNoise.h"
+#include "math/jlSpline.h"
+#include "math/jlPolynomial.h"
 #include "util/jlRandom.h"
+#include "util/jlRandomStreams.h"
+#include "util/jlCounterRandom.h"
+#include "util/jlFastRandom.h"
+#include "util/jlDistribution.h"
+#include "util/jlQuasiRandom.h"
+#include "util/jlTimer.h"
+#include "util/jlFPEnvironment.h"
+#include "util/jlValidate.h"
 
 /* BEGIN DEBUG PRINT FUNCTIONS */
 void printFloat(float f) { std::cout << "{" << f << "}" << std::endl; }
@@ -65,13 +79,7 @@ jlVector4 * generateRandomVectors(int32 numVectors, float32 scalarMin, float32 s
 		jlRandom random;
 		random.init(numVectors);
 		random.seed(jlRandom::DEFAULT_SEED);
-		for (int32 i = 0; i < numVectors; i++) {
-			float32 x = random.randFloat32(scalarMin, scalarMax);
-			float32 y = random.randFloat32(scalarMin, scalarMax);
-			float32 z = random.randFloat32(scalarMin, scalarMax);
-			//float32 w = random.randFloat32(scalarMin, scalarMax);
-			vectors[i].set(x, y, z, 0.0f);
-		}
+		random.fillVector4(vectors, numVectors, jlVector4(scalarMin, scalarMin, scalarMin, 0.0f), jlVector4(scalarMax, scalarMax, scalarMax, 0.0f));
 	}
 	return vectors;
 }
@@ -174,6 +182,1000 @@ void runSinTest() {
 	}
 }
 
+void runTrigAccuracyTest() {
+	float32 maxErr[3] = { 0.0f, 0.0f, 0.0f };
+	for (int32 i = -4096; i < 4096; i += 4) {
+		jlVector4 x(i * 0.01f, i * 0.01f + 0.0025f, i * 0.01f + 0.005f, i * 0.01f + 0.0075f);
+		jlVector4 s[3] = { jlMath::Sin<jlMath::ACCURACY_FULL>(x), jlMath::Sin<jlMath::ACCURACY_MEDIUM>(x), jlMath::Sin<jlMath::ACCURACY_LOW>(x) };
+		for (int32 t = 0; t < 3; t++) {
+			for (int32 j = 0; j < 4; j++) {
+				float32 err = jlMath::Abs(s[t](j) - (float32)sin((float64)x(j)));
+				if (err > maxErr[t]) maxErr[t] = err;
+			}
+		}
+	}
+	std::cout << "Sin max error FULL: " << maxErr[0] << " MEDIUM: " << maxErr[1] << " LOW: " << maxErr[2] << std::endl;
+}
+
+void runExpLogAccuracyTest() {
+	float32 maxExpErr[3] = { 0.0f, 0.0f, 0.0f };
+	float32 maxLogErr[3] = { 0.0f, 0.0f, 0.0f };
+	for (int32 i = -2000; i < 2000; i += 4) {
+		jlVector4 x(i * 0.04f, i * 0.04f + 0.01f, i * 0.04f + 0.02f, i * 0.04f + 0.03f);
+		jlVector4 e[3] = { jlMath::Exp<jlMath::ACCURACY_FULL>(x), jlMath::Exp<jlMath::ACCURACY_MEDIUM>(x), jlMath::Exp<jlMath::ACCURACY_LOW>(x) };
+		jlVector4 lx = jlMath::Exp<jlMath::ACCURACY_FULL>(x * jlSimdFloat(0.5f));
+		jlVector4 l[3] = { jlMath::Log<jlMath::ACCURACY_FULL>(lx), jlMath::Log<jlMath::ACCURACY_MEDIUM>(lx), jlMath::Log<jlMath::ACCURACY_LOW>(lx) };
+		for (int32 t = 0; t < 3; t++) {
+			for (int32 j = 0; j < 4; j++) {
+				float64 expected = exp((float64)x(j));
+				float32 expErr = (float32)(jlMath::Abs((float32)(e[t](j) - expected)) / expected);
+				float32 logErr = jlMath::Abs(l[t](j) - (float32)log((float64)lx(j)));
+				if (expErr > maxExpErr[t]) maxExpErr[t] = expErr;
+				if (logErr > maxLogErr[t]) maxLogErr[t] = logErr;
+			}
+		}
+	}
+	std::cout << "Exp max relative error FULL: " << maxExpErr[0] << " MEDIUM: " << maxExpErr[1] << " LOW: " << maxExpErr[2] << std::endl;
+	std::cout << "Log max error FULL: " << maxLogErr[0] << " MEDIUM: " << maxLogErr[1] << " LOW: " << maxLogErr[2] << std::endl;
+	PRINT_FLOAT_OP(jlMath::Pow(3.0f, 5));
+	PRINT_FLOAT_OP(jlMath::Pow(2.0f, -3));
+	PRINT_FLOAT_OP((jlMath::Pow<5>(3.0f)));
+	PRINT_VEC4_OP((jlMath::Pow<3>(jlVector4(1.0f, 2.0f, 3.0f, 4.0f))));
+	PRINT_VEC4_OP(jlMath::Pow(jlVector4(2.0f, 10.0f, 0.5f, 0.0f), jlVector4(10.0f, -2.0f, 3.0f, 2.0f)));
+}
+
+void runRoundingTest() {
+	int32 mismatches = 0;
+	for (int32 i = -40000; i < 40000; i += 4) {
+		jlVector4 x(i * 0.01f, i * 0.01f + 0.0025f, i * 0.01f + 0.005f, i * 0.01f + 0.0075f);
+		jlVector4 f = jlMath::Floor(x);
+		jlVector4 c = jlMath::Ceil(x);
+		jlVector4 t = jlMath::Trunc(x);
+		jlVector4 m = jlMath::Mod(x, jlVector4(3.0f, 3.0f, 3.0f, 3.0f));
+		for (int32 j = 0; j < 4; j++) {
+			float32 ft = (x(j) < 0.0f) ? ceil(x(j)) : floor(x(j));
+			if (f(j) != floor(x(j)) || c(j) != ceil(x(j)) || t(j) != ft) mismatches++;
+			if (jlMath::Abs(m(j) - fmod(x(j), 3.0f)) > 1e-4f) mismatches++;
+		}
+	}
+	std::cout << "Floor/Ceil/Trunc/Mod mismatches: " << mismatches << std::endl;
+	jlVector4 halves(-2.5f, -0.5f, 0.5f, 1.5f);
+	PRINT_VEC4_OP(jlMath::Round(halves));
+	PRINT_VEC4_OP(jlMath::Floor(halves));
+	PRINT_VEC4_OP(jlMath::Ceil(halves));
+	PRINT_VEC4_OP(jlMath::Trunc(halves));
+	PRINT_VEC4_OP(jlMath::Fract(halves));
+	PRINT_VEC4_OP(jlMath::Round(jlVector4(16777216.0f, -8388609.0f, 1e30f, -0.25f)));
+	PRINT_VEC4_OP(jlMath::WrapAngle(jlVector4(7.0f, -7.0f, 100.0f, 3.0f)));
+	PRINT_FLOAT_OP(jlMath::WrapAngle(7.0f));
+	PRINT_SIMDFLOAT_OP(jlMath::Floor(jlSimdFloat(-1.25f)));
+	PRINT_SIMDFLOAT_OP(jlMath::Mod(jlSimdFloat(-7.5f), jlSimdFloat(2.0f)));
+	PRINT_INT_OP(jlMath::FloorToInt(jlSimdFloat(-1.25f)));
+	PRINT_INT_OP(jlMath::RoundToInt(jlSimdFloat(2.5f)));
+	// cell coordinates for a grid of 0.5 wide cells
+	quadint128 cells = jlMath::FloorToInt(jlVector4(-0.75f, 0.25f, 1.0f, 3.9f) * jlSimdFloat(2.0f));
+	PRINT_VEC4_OP(jlMath::ToFloat(cells));
+	PRINT_VEC4_OP(jlMath::ToFloat(jlMath::TruncToInt(jlVector4(-1.9f, -0.1f, 0.9f, 2.1f))));
+}
+
+void runValidateTest() {
+	const float32 zero = 0.0f;
+	const float32 nan = zero / zero;
+	const float32 inf = 1.0f / zero;
+	jlVector4 v(1.0f, -2.0f, 0.0f, -0.0f);
+	PRINT_INT_OP(v.isOk());
+	v(2) = nan;
+	PRINT_INT_OP(v.isOk());
+	v(2) = -inf;
+	PRINT_INT_OP(v.isOk());
+	v(2) = FLOAT32_MAX;
+	PRINT_INT_OP(v.isOk());
+	jlMatrix4 m = jlMatrix4::IDENTITY;
+	PRINT_INT_OP(m.isOk());
+	m(3, 2) = inf;
+	PRINT_INT_OP(m.isOk());
+	PRINT_INT_OP(jlQuaternion(0.0f, 0.0f, nan, 1.0f).isOk());
+
+	// offset by one so the scan starts unaligned
+	const int32 n = 1003;
+	float32 *values = static_cast<float32 *>(jlAllocAligned((n + 1) * sizeof(float32), 16));
+	float32 *x = values + 1;
+	for (int32 i = 0; i < n; i++) {
+		x[i] = i * 0.5f - 100.0f;
+	}
+	jlValidateReport r = jlValidateArray(x, n);
+	std::cout << "first bad: " << r.firstBad << " nan: " << r.nanCount << " inf: " << r.infCount << " denormal: " << r.denormalCount << std::endl;
+	x[517] = nan;
+	x[2] = 1e-40f;
+	x[600] = -inf;
+	x[601] = inf;
+	x[1001] = nan;
+	r = jlValidateArray(x, n);
+	std::cout << "first bad: " << r.firstBad << " nan: " << r.nanCount << " inf: " << r.infCount << " denormal: " << r.denormalCount << std::endl;
+	jlFreeAligned(values);
+}
+
+void runFPEnvironmentTest() {
+	volatile float32 tiny = 1e-38f; // volatile so the products happen at run time
+	PRINT_FLOAT_OP(tiny * 0.01f); // denormal
+	PRINT_INT_OP(jlFPEnvironment::IsFlushingDenormals());
+	{
+		jlFPEnvironment flush;
+		PRINT_INT_OP(jlFPEnvironment::IsFlushingDenormals());
+		PRINT_FLOAT_OP(tiny * 0.01f); // 0
+		{
+			jlFPEnvironment nested(false, jlFPEnvironment::ROUNDING_DOWN);
+			PRINT_INT_OP(jlFPEnvironment::IsFlushingDenormals());
+			PRINT_INT_OP(jlFPEnvironment::GetRounding());
+			// Round is ties to even whatever the rounding mode
+			jlVector4 rounded = jlMath::Round(jlVector4(-0.5f, 1.5f, -1.5f, 2.5f));
+			PRINT_VEC4_OP(rounded);
+			std::cout << "Round under ROUNDING_DOWN" << ((rounded.compEqual(jlVector4(-0.0f, 2.0f, -2.0f, 2.0f)).allAreSet(jlComp::MASK_XYZW)) ? " (ok)" : " (FAILED)") << std::endl;
+		}
+		PRINT_INT_OP(jlFPEnvironment::IsFlushingDenormals());
+		PRINT_INT_OP(jlFPEnvironment::GetRounding());
+	}
+	PRINT_INT_OP(jlFPEnvironment::IsFlushingDenormals());
+	// sampling, flags survive the guard so they can be read after it
+	jlFPEnvironment::ClearExceptions();
+	{
+		jlFPEnvironment flush(false);
+		volatile float32 zero = 0.0f;
+		volatile float32 invalid = zero / zero;
+		JL_UNUSED(invalid);
+	}
+	PRINT_INT_OP(jlFPEnvironment::Sample("runFPEnvironmentTest", __FILE__, __LINE__));
+	PRINT_INT_OP(jlFPEnvironment::GetExceptions() & jlFPEnvironment::EXCEPTION_REPORTED); // cleared
+}
+
+void reportNoiseRange(const char8 *name, const jlNoise& noise, jlNoise::Type type, int32 dims) {
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	float32 lo = 0.0f, hi = 0.0f;
+	for (int32 i = 0; i < 1 << 16; i += 4) {
+		jlVector4 p[4];
+		for (int32 d = 0; d < 4; d++) {
+			p[d] = jlVector4(random.randFloat32(-64.0f, 64.0f), random.randFloat32(-64.0f, 64.0f), random.randFloat32(-64.0f, 64.0f), random.randFloat32(-64.0f, 64.0f));
+		}
+		jlVector4 n;
+		if (dims == 2) n = (type == jlNoise::TYPE_SIMPLEX) ? noise.simplex(p[0], p[1]) : noise.perlin(p[0], p[1]);
+		else if (dims == 3) n = (type == jlNoise::TYPE_SIMPLEX) ? noise.simplex(p[0], p[1], p[2]) : noise.perlin(p[0], p[1], p[2]);
+		else n = (type == jlNoise::TYPE_SIMPLEX) ? noise.simplex(p[0], p[1], p[2], p[3]) : noise.perlin(p[0], p[1], p[2], p[3]);
+		for (int32 l = 0; l < 4; l++) {
+			if (n(l) < lo) lo = n(l);
+			if (n(l) > hi) hi = n(l);
+		}
+	}
+	std::cout << name << " range: [" << lo << ", " << hi << "]" << std::endl;
+}
+
+void runNoiseTest() {
+	jlNoise noise;
+	jlVector4 x(0.0f, 0.5f, 1.25f, -3.7f), y(0.0f, 0.25f, 2.5f, 11.1f), z(0.0f, 0.75f, -0.5f, 4.2f), w(0.0f, 0.1f, 0.2f, 0.3f);
+	PRINT_VEC4_OP(noise.perlin(x, y)); // 0 at lattice points
+	PRINT_VEC4_OP(noise.perlin(x, y, z));
+	PRINT_VEC4_OP(noise.perlin(x, y, z, w));
+	PRINT_VEC4_OP(noise.simplex(x, y));
+	PRINT_VEC4_OP(noise.simplex(x, y, z));
+	PRINT_VEC4_OP(noise.simplex(x, y, z, w));
+	PRINT_VEC4_OP(noise.fbm(jlNoise::TYPE_PERLIN, x, y, z, 5));
+	PRINT_VEC4_OP(noise.turbulence(jlNoise::TYPE_SIMPLEX, x, y, 5));
+	reportNoiseRange("Perlin 2D", noise, jlNoise::TYPE_PERLIN, 2);
+	reportNoiseRange("Perlin 3D", noise, jlNoise::TYPE_PERLIN, 3);
+	reportNoiseRange("Perlin 4D", noise, jlNoise::TYPE_PERLIN, 4);
+	reportNoiseRange("Simplex 2D", noise, jlNoise::TYPE_SIMPLEX, 2);
+	reportNoiseRange("Simplex 3D", noise, jlNoise::TYPE_SIMPLEX, 3);
+	reportNoiseRange("Simplex 4D", noise, jlNoise::TYPE_SIMPLEX, 4);
+	// same seed gives the same field, a different one does not
+	jlNoise same, other;
+	same.seed(jlRandom::DEFAULT_SEED);
+	other.seed(42);
+	PRINT_INT_OP(noise.simplex(x, y, z).compEqual(same.simplex(x, y, z)).allAreSet(jlComp::MASK_XYZW));
+	PRINT_INT_OP(noise.simplex(x, y, z).compEqual(other.simplex(x, y, z)).allAreSet(jlComp::MASK_XYZW));
+	// grid fill matches pointwise evaluation, 7 x 3 leaves a partial quad
+	JL_ALIGN_16 float32 grid[7 * 3];
+	jlVector4 origin(0.3f, -1.2f, 0.0f, 0.0f), spacing(0.37f, 0.41f, 0.0f, 0.0f);
+	noise.fillGrid2(grid, 7, 3, origin, spacing, jlNoise::TYPE_SIMPLEX, 3);
+	jlVector4 last = noise.fbm(jlNoise::TYPE_SIMPLEX, jlVector4(0.3f + 6 * 0.37f, 0.0f, 0.0f, 0.0f), jlVector4(-1.2f + 2 * 0.41f, 0.0f, 0.0f, 0.0f), 3);
+	PRINT_FLOAT_OP(grid[20]);
+	PRINT_FLOAT_OP(last(0));
+	JL_ALIGN_16 float32 volume[4 * 4 * 4];
+	noise.fillGrid3(volume, 4, 4, 4, origin, jlVector4(0.25f, 0.25f, 0.25f, 0.0f), jlNoise::TYPE_PERLIN);
+	PRINT_FLOAT_OP(volume[0]);
+	PRINT_FLOAT_OP(volume[63]);
+	// every grid point against pointwise fbm, covers the AVX2 eight point path
+	const int32 nx = 13, ny = 5, nz = 3;
+	JL_ALIGN_16 float32 fill[nx * ny * nz];
+	const jlVector4 step(0.37f, 0.41f, 0.29f, 0.0f);
+	int32 mismatches = 0;
+	for (int32 type = jlNoise::TYPE_PERLIN; type <= jlNoise::TYPE_SIMPLEX; type++) {
+		const jlNoise::Type t = static_cast<jlNoise::Type>(type);
+		noise.fillGrid2(fill, nx, ny, origin, step, t, 3);
+		for (int32 i = 0; i < nx * ny; i++) {
+			const float32 fx = origin(0) + (i % nx) * step(0), fy = origin(1) + (i / nx) * step(1);
+			mismatches += fabs(noise.fbm(t, jlVector4(fx, fx, fx, fx), jlVector4(fy, fy, fy, fy), 3)(0) - fill[i]) > 1.0e-6f;
+		}
+		noise.fillGrid3(fill, nx, ny, nz, origin, step, t, 3);
+		for (int32 i = 0; i < nx * ny * nz; i++) {
+			const float32 fx = origin(0) + (i % nx) * step(0), fy = origin(1) + (i / nx % ny) * step(1), fz = origin(2) + (i / (nx * ny)) * step(2);
+			mismatches += fabs(noise.fbm(t, jlVector4(fx, fx, fx, fx), jlVector4(fy, fy, fy, fy), jlVector4(fz, fz, fz, fz), 3)(0) - fill[i]) > 1.0e-6f;
+		}
+	}
+	std::cout << "Noise grid mismatches: " << mismatches << std::endl;
+}
+
+void runSplineTest() {
+	jlVector4 p0(0.0f, 0.0f, 0.0f), p1(1.0f, 2.0f, 0.0f), p2(3.0f, 2.0f, 1.0f), p3(4.0f, 0.0f, 1.0f);
+	jlCubicSegment bezier(jlCubicSegment::BASIS_BEZIER, p0, p1, p2, p3);
+	jlCubicSegment catmull(jlCubicSegment::BASIS_CATMULL_ROM, p0, p1, p2, p3);
+	jlCubicSegment hermite(jlCubicSegment::BASIS_HERMITE, p0, p1, p3, p2);
+	jlCubicSegment bspline(jlCubicSegment::BASIS_BSPLINE, p0, p1, p2, p3);
+	PRINT_VEC4_OP(bezier.evaluate(jlSimdFloat(1.0f))); // p3
+	PRINT_VEC4_OP(bezier.derivative(jlSimdFloat(0.0f))); // 3 (p1 - p0)
+	PRINT_VEC4_OP(catmull.evaluate(jlSimdFloat(0.0f))); // p1
+	PRINT_VEC4_OP(catmull.evaluate(jlSimdFloat(1.0f))); // p2
+	PRINT_VEC4_OP(hermite.derivative(jlSimdFloat(1.0f))); // p2, the end tangent
+	PRINT_VEC4_OP(bspline.evaluate(jlSimdFloat(0.0f))); // (p0 + 4 p1 + p2) / 6
+	PRINT_VEC4_OP(bspline.secondDerivative(jlSimdFloat(0.5f)));
+	// forward differencing against Horner
+	const int32 n = 1000;
+	jlVector4 *fd = new jlVector4[n];
+	catmull.evaluateUniform(fd, n);
+	float32 maxErr = 0.0f;
+	for (int32 i = 0; i < n; i++) {
+		float32 err = jlVector4::Distance(fd[i], catmull.evaluate(jlSimdFloat(i / (n - 1.0f))));
+		if (err > maxErr) maxErr = err;
+	}
+	std::cout << "Forward differencing max error over " << n << " points: " << maxErr << std::endl;
+	delete [] fd;
+	float32 t[5] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+	jlVector4 pts[5];
+	bezier.evaluate(t, pts, 5);
+	PRINT_VEC4_OP(pts[2]);
+	// segments from a point list
+	jlVector4 path[6] = { p0, p1, p2, p3, jlVector4(5.0f, 1.0f, 0.0f), jlVector4(6.0f, 0.0f, 0.0f) };
+	jlCubicSegment segments[3];
+	PRINT_INT_OP(jlCubicSegment::Build(jlCubicSegment::BASIS_CATMULL_ROM, path, 6, segments));
+	PRINT_VEC4_OP(segments[0].evaluate(jlSimdFloat(1.0f)) - segments[1].evaluate(jlSimdFloat(0.0f))); // joins
+	// a straight bezier with bunched control points, length 3, spacing should come out even
+	jlCubicSegment line(jlCubicSegment::BASIS_BEZIER, jlVector4(0.0f, 0.0f, 0.0f), jlVector4(0.2f, 0.0f, 0.0f), jlVector4(0.4f, 0.0f, 0.0f), jlVector4(3.0f, 0.0f, 0.0f));
+	jlArcLengthTable table;
+	table.init(line);
+	PRINT_FLOAT_OP(table.getLength());
+	PRINT_FLOAT_OP(line.evaluate(jlSimdFloat(table.getParameter(1.5f)))(0)); // 1.5
+	jlVector4 even[7];
+	table.evaluateEvenly(line, even, 7);
+	PRINT_VEC4_OP(jlVector4(even[1](0), even[2](0), even[3](0), even[6](0))); // 0.5 1 1.5 3
+	// quaternions, evenly spaced keys about one axis make squad a plain slerp
+	jlVector4 axis(0.0f, 0.0f, 1.0f);
+	jlQuaternion keys[4];
+	for (int32 i = 0; i < 4; i++) {
+		keys[i].setAxisAngle(axis, jlSimdFloat(0.5f * i));
+	}
+	PRINT_QUATERNION_OP(keys[1] * keys[1].unitInverse()); // identity
+	jlQuaternionSegment squad;
+	squad.setSquad(keys[0], keys[1], keys[2], keys[3]);
+	PRINT_QUATERNION_OP(squad.evaluate(jlSimdFloat(0.3f)));
+	PRINT_QUATERNION_OP(jlQuaternion::Slerp(keys[1], keys[2], jlSimdFloat(0.3f)));
+	jlQuaternion batch[5];
+	squad.evaluate(t, batch, 5);
+	PRINT_QUATERNION_OP(batch[1]);
+	PRINT_QUATERNION_OP(squad.evaluate(jlSimdFloat(0.25f)));
+	jlQuaternion tilted;
+	tilted.setAxisAngle(jlVector4(1.0f, 0.0f, 0.0f), jlSimdFloat(1.0f));
+	jlQuaternionSegment curve;
+	curve.setBezier(keys[0], tilted, keys[2], keys[3]);
+	curve.evaluateUniform(batch, 5);
+	PRINT_QUATERNION_OP(batch[2]);
+	PRINT_QUATERNION_OP(curve.evaluate(jlSimdFloat(0.5f)));
+	PRINT_QUATERNION_OP(batch[4]); // keys[3]
+}
+
+void printRoots(const char8 *name, const jlPolynomialRoots& r) {
+	std::cout << name << ":" << std::endl;
+	for (int32 l = 0; l < 4; l++) {
+		std::cout << "  lane " << l << ":";
+		for (int32 k = 0; k < 4 && (r.valid[k].getMask() & (1 << l)); k++) {
+			std::cout << " " << r.roots[k](l);
+		}
+		std::cout << std::endl;
+	}
+}
+
+const float32 QUARTIC_EXACT_ERROR = 1.0e-3f;
+const float64 QUARTIC_RESIDUAL_EPSILONS = 4.0;
+
+int32 countRoots(const jlPolynomialRoots& r, int32 lane) {
+	int32 n = 0;
+	for (int32 k = 0; k < 4; k++) n += (r.valid[k].getMask() >> lane) & 1;
+	return n;
+}
+
+/// Expands (x - r0)(x - r1)(x - r2)(x - r3) per lane in float64, rounds the coefficients to float and solves
+jlPolynomialRoots solveWithRoots(const float32 x[4][4], float32 c[5][4]) {
+	for (int32 l = 0; l < 4; l++) {
+		float64 p[5] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+		for (int32 k = 0; k < 4; k++) for (int32 i = k + 1; i > 0; i--) p[i] -= p[i - 1] * x[l][k];
+		for (int32 i = 0; i < 5; i++) c[i][l] = (float32)p[i];
+	}
+	jlVector4 cv[5];
+	for (int32 i = 0; i < 5; i++) cv[i].loadAligned(c[i]);
+	return jlPolynomial::SolveQuartic(cv[0], cv[1], cv[2], cv[3], cv[4]);
+}
+
+jlPolynomialRoots solveWithRoots(const float32 x[4][4]) {
+	JL_ALIGN_16 float32 c[5][4];
+	return solveWithRoots(x, c);
+}
+
+void runPolynomialTest() {
+	// (x - 1)(x - 3), x^2 + 1, 2x - 4, and a tiny leading term with roots near 1 and -1e8
+	printRoots("Quadratic", jlPolynomial::SolveQuadratic(jlVector4(1.0f, 1.0f, 0.0f, 1e-8f), jlVector4(-4.0f, 0.0f, 2.0f, 1.0f), jlVector4(3.0f, 1.0f, -4.0f, -1.0f)));
+	// (x - 1)(x - 2)(x - 3), x^3 + x + 1, (x - 2)^3, x^2 - 1
+	printRoots("Cubic", jlPolynomial::SolveCubic(jlVector4(1.0f, 1.0f, 1.0f, 0.0f), jlVector4(-6.0f, 0.0f, -6.0f, 1.0f), jlVector4(11.0f, 1.0f, 12.0f, 0.0f), jlVector4(-6.0f, 1.0f, -8.0f, -1.0f)));
+	// (x - 1)(x - 2)(x - 3)(x - 4), x^4 - 5x^2 + 4, x^4 + 1, x^4 - 1
+	printRoots("Quartic", jlPolynomial::SolveQuartic(jlVector4(1.0f, 1.0f, 1.0f, 1.0f), jlVector4(-10.0f, 0.0f, 0.0f, 0.0f), jlVector4(35.0f, -5.0f, 0.0f, 0.0f), jlVector4(-50.0f, 0.0f, 0.0f, 0.0f), jlVector4(24.0f, 4.0f, 1.0f, -1.0f)));
+	// quartics with four known real roots k / 4 in [-10, 10], whose coefficients are exact in float
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	float32 maxErr = 0.0f;
+	int32 wrongCount = 0;
+	for (int32 it = 0; it < 2500; it++) {
+		float32 x[4][4];
+		for (int32 l = 0; l < 4; l++) {
+			for (int32 k = 0; k < 4; k++) x[l][k] = (float32)((int32)(random.randUint32() % 81) - 40) * 0.25f;
+			for (int32 i = 1; i < 4; i++) for (int32 j = i; j > 0 && x[l][j] < x[l][j - 1]; j--) { float32 t = x[l][j]; x[l][j] = x[l][j - 1]; x[l][j - 1] = t; }
+		}
+		jlPolynomialRoots r = solveWithRoots(x);
+		for (int32 l = 0; l < 4; l++) {
+			if (countRoots(r, l) != 4) {
+				wrongCount++;
+				continue;
+			}
+			for (int32 k = 0; k < 4; k++) {
+				float32 err = jlMath::Abs(r.roots[k](l) - x[l][k]);
+				if (err > maxErr) maxErr = err;
+			}
+		}
+	}
+	std::cout << "Quartic 10000 exact: max error " << maxErr << ", wrong root count " << wrongCount
+		<< ((maxErr < QUARTIC_EXACT_ERROR && wrongCount == 0) ? " (ok)" : " (FAILED)") << std::endl;
+	// random real roots, rounding the coefficients to float moves them, so check the backward residual
+	// |f(x)| against the rounding bound sum |c_i| |x|^i and that close pairs still come back as two roots
+	float64 maxResidual = 0.0;
+	int32 lost = 0;
+	for (int32 it = 0; it < 2500; it++) {
+		float32 x[4][4];
+		for (int32 l = 0; l < 4; l++) {
+			for (int32 k = 0; k < 4; k++) x[l][k] = random.randFloat32(-10.0f, 10.0f);
+		}
+		JL_ALIGN_16 float32 c[5][4];
+		jlPolynomialRoots r = solveWithRoots(x, c);
+		for (int32 l = 0; l < 4; l++) {
+			lost += 4 - countRoots(r, l);
+			for (int32 k = 0; k < 4 && (r.valid[k].getMask() & (1 << l)); k++) {
+				float64 root = r.roots[k](l), f = 0.0, bound = 0.0;
+				for (int32 i = 0; i < 5; i++) {
+					f = f * root + c[i][l];
+					bound = bound * fabs(root) + fabs(c[i][l]);
+				}
+				float64 residual = fabs(f) / (bound * FLOAT32_EPSILON);
+				if (residual > maxResidual) maxResidual = residual;
+			}
+		}
+	}
+	std::cout << "Quartic 10000 random: max residual " << maxResidual << " epsilons, lost roots " << lost
+		<< ((maxResidual < QUARTIC_RESIDUAL_EPSILONS && lost == 0) ? " (ok)" : " (FAILED)") << std::endl;
+}
+
+void runRandomStreamsTest() {
+	// SFMT19937 seeded with 1234 starts 3440181555 1564997079 1510669302 2930277156, for any buffer size
+	jlRandom small, large;
+	small.init(jlRandom::STATE_SIZE);
+	large.init(1000);
+	small.seed(1234);
+	large.seed(1234);
+	int32 mismatches = 0;
+	for (int32 i = 0; i < 100000; i++) {
+		uint32 s = small.randUint32();
+		if (i < 4) std::cout << s << " ";
+		mismatches += s != large.randUint32();
+	}
+	std::cout << std::endl << "Buffer size mismatches: " << mismatches << std::endl;
+	// a jump polynomial of x^16 skips 16 quads, 64 values
+	jlRandom jumped, skipped;
+	jumped.init(jlRandom::STATE_SIZE);
+	skipped.init(jlRandom::STATE_SIZE);
+	jumped.seed(99);
+	skipped.seed(99);
+	jumped.jump("00001");
+	for (int32 i = 0; i < 64; i++) skipped.randUint32();
+	mismatches = 0;
+	for (int32 i = 0; i < 10000; i++) mismatches += jumped.randUint32() != skipped.randUint32();
+	std::cout << "Jump x^16 mismatches: " << mismatches << std::endl;
+	// same seed gives the same streams, neighbouring streams share no values
+	jlRandomStreams streams, again;
+	PRINT_INT_OP(streams.init(7, 8) == JL_OK);
+	PRINT_INT_OP(again.init(7, 8, 512) == JL_OK);
+	uint32 values[8][1000];
+	int32 repeats = 0, shared = 0;
+	for (int32 s = 0; s < streams.getCount(); s++) {
+		for (int32 i = 0; i < 1000; i++) {
+			values[s][i] = streams.getStream(s).randUint32();
+			repeats += values[s][i] == again.getStream(s).randUint32();
+			if (s > 0) shared += values[s][i] == values[s - 1][i];
+		}
+	}
+	std::cout << "Streams: repeated " << repeats << " of 8000, shared with the previous stream " << shared << std::endl;
+}
+
+void runRandomFillTest() {
+	// bulk fills match single draws, whether they go through the buffer or straight into out
+	jlRandom bulk, single;
+	bulk.init(200);
+	single.init(200);
+	bulk.seed();
+	single.seed();
+	uint32 *values = static_cast<uint32 *>(jlAllocAligned(12000 * sizeof(uint32), 16));
+	const int32 counts[5] = { 3, 1000, 5, 640, 11111 };
+	int32 mismatches = 0;
+	for (int32 k = 0; k < 5; k++) {
+		bulk.fillUint32(values, counts[k]);
+		for (int32 i = 0; i < counts[k]; i++) mismatches += values[i] != single.randUint32();
+	}
+	std::cout << "Fill mismatches: " << mismatches << std::endl;
+	// the AVX2, SSE2 and FPU refills are bit identical, an odd buffer size
+	// also runs the AVX2 single quad tail, every build has to match the FPU value
+	const uint32 REFILL_CHECKSUM = 1296863738u;
+	jlRandom odd;
+	odd.init(1001);
+	odd.seed(77);
+	uint32 checksum = 0;
+	for (int32 i = 0; i < 1000000; i++) checksum ^= odd.randUint32() * (i + 1);
+	std::cout << "Refill checksum: " << checksum << ((checksum == REFILL_CHECKSUM) ? " (ok)" : " (FAILED)") << std::endl;
+	float32 *floats = reinterpret_cast<float32 *>(values);
+	bulk.fillFloat32(floats, 1003, -2.0f, 3.0f);
+	float32 lo = FLOAT32_MAX, hi = -FLOAT32_MAX;
+	for (int32 i = 0; i < 1003; i++) {
+		lo = (floats[i] < lo) ? floats[i] : lo;
+		hi = (floats[i] > hi) ? floats[i] : hi;
+	}
+	std::cout << "fillFloat32 in [-2, 3): " << lo << " to " << hi << std::endl;
+	jlFreeAligned(values);
+	jlVector4 *dirs = new jlVector4[1001];
+	bulk.fillUnitVectors(dirs, 1001);
+	float32 maxErr = 0.0f;
+	jlVector4 mean = jlVector4::ZERO;
+	for (int32 i = 0; i < 1001; i++) {
+		float32 err = jlMath::Abs(dirs[i].length3().getFloat() - 1.0f);
+		if (err > maxErr) maxErr = err;
+		mean += dirs[i];
+	}
+	std::cout << "Unit vectors: max length error " << maxErr << ", mean ";
+	printVector4(mean * jlSimdFloat(1.0f / 1001.0f));
+	delete [] dirs;
+}
+
+void runCounterRandomTest() {
+	// Random123 known answer for counter 0 and key 0: 6627e8d5 e169c58d bc57ac4c 9b00dbd8
+	std::cout << std::hex;
+	for (int32 i = 0; i < 4; i++) std::cout << jlCounterRandom::Uint32At(0, i) << " ";
+	std::cout << std::dec << std::endl;
+	// sequential draws, bulk fills and direct addressing all agree
+	jlCounterRandom sequential(99), bulk(99);
+	sequential.randUint32();
+	bulk.randUint32();
+	uint32 values[1001];
+	bulk.fillUint32(values, 1001);
+	int32 mismatches = 0;
+	for (int32 i = 0; i < 1001; i++) {
+		uint32 v = sequential.randUint32();
+		mismatches += v != values[i];
+		mismatches += v != jlCounterRandom::Uint32At(99, i + 1);
+	}
+	// the four block fill carries into the high counter word
+	jlCounterRandom carry(99, 0xFFFFFFFEull);
+	carry.fillUint32(values, 64);
+	for (int32 i = 0; i < 64; i++) mismatches += values[i] != jlCounterRandom::Uint32At(99, 0xFFFFFFFEull * 4 + i);
+	std::cout << "Counter random mismatches: " << mismatches << std::endl;
+	// element i of a parallel loop only needs (key, i)
+	float32 sum = 0.0f;
+	for (int32 i = 0; i < 10000; i++) sum += jlCounterRandom::Float32At(7, i);
+	std::cout << "Mean of 10000 Float32At: " << sum / 10000.0f << std::endl;
+}
+
+void runFastRandomTest() {
+	// splitmix64 seeded xoshiro128++ reference for seed 1234, lanes interleaved:
+	// 9ef725be acf40c4f fd2d679f df558a93 4a2dfa25 e0c5fc31 20aa9d9f f486a053
+	jlFastRandom fast;
+	std::cout << std::hex;
+	for (int32 i = 0; i < 8; i++) std::cout << fast.randUint32() << " ";
+	std::cout << std::dec << std::endl;
+	// bulk fills continue the same sequence from any position
+	jlFastRandom sequential(42), bulk(42);
+	sequential.randUint32();
+	bulk.randUint32();
+	uint32 values[1001];
+	bulk.fillUint32(values, 1001);
+	int32 mismatches = 0;
+	for (int32 i = 0; i < 1001; i++) {
+		mismatches += sequential.randUint32() != values[i];
+	}
+	std::cout << "Fast random mismatches: " << mismatches << std::endl;
+	jlFastRandom jumped(42);
+	jumped.jump();
+	std::cout << "Jumped: " << jumped.randUint32() << " " << jumped.randUint32() << std::endl;
+	jlVector4 mean = jlVector4::ZERO;
+	for (int32 i = 0; i < 10000; i++) mean.add(fast.randVector4());
+	mean.mul(jlSimdFloat(1.0f / 10000.0f));
+	std::cout << "Mean of 10000 randVector4: ";
+	printVector4(mean);
+	std::cout << "sizeof(jlFastRandom): " << sizeof(jlFastRandom) << std::endl;
+}
+
+void runFastRandomBenchmark() {
+	const int32 n = 1 << 16;
+	const int32 iterations = 100;
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	jlFastRandom fast;
+	uint32 *out = static_cast<uint32 *>(jlAllocAligned(n * sizeof(uint32), 16));
+	uint32 sum = 0;
+	jlTimer timer;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) {
+		for (int32 i = 0; i < n; i++) sum += random.randUint32();
+	}
+	std::cout << "jlRandom randUint32: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) {
+		for (int32 i = 0; i < n; i++) sum += fast.randUint32();
+	}
+	std::cout << "jlFastRandom randUint32: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) random.fillUint32(out, n);
+	std::cout << "jlRandom fillUint32: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) fast.fillUint32(out, n);
+	std::cout << "jlFastRandom fillUint32: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw (" << (sum ^ out[0]) << ")" << std::endl;
+	jlFreeAligned(out);
+}
+
+void runDistributionTest() {
+	const int32 n = 100003;
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	float32 *samples = static_cast<float32 *>(jlAllocAligned(n * sizeof(float32), 16));
+	jlDistribution::FillNormal(random, samples, n, 2.0f, 3.0f);
+	float64 sum = 0.0, sumSq = 0.0;
+	for (int32 i = 0; i < n; i++) {
+		sum += samples[i];
+		sumSq += samples[i] * samples[i];
+	}
+	std::cout << "Normal(2, 3): mean " << sum / n << ", stddev " << sqrt(sumSq / n - (sum / n) * (sum / n)) << std::endl;
+	jlDistribution::FillExponential(random, samples, n, 4.0f);
+	sum = 0.0;
+	for (int32 i = 0; i < n; i++) sum += samples[i];
+	std::cout << "Exponential(4): mean " << sum / n << " (0.25)" << std::endl;
+	jlFreeAligned(samples);
+	// mean r^2 of the disk is 1/2, mean cos of the hemisphere is 2/3
+	const int32 m = 10001;
+	jlVector4 *points = new jlVector4[m];
+	jlDistribution::FillUnitDisk(random, points, m);
+	float32 maxR = 0.0f;
+	sum = 0.0;
+	for (int32 i = 0; i < m; i++) {
+		float32 r2 = points[i].lengthSquared3().getFloat();
+		maxR = (r2 > maxR) ? r2 : maxR;
+		sum += r2;
+	}
+	std::cout << "Disk: max r^2 " << maxR << ", mean r^2 " << sum / m << std::endl;
+	jlVector4 normal(1.0f, -2.0f, 0.5f);
+	normal.normalize3();
+	jlDistribution::FillCosineHemisphere(random, points, m, normal);
+	float32 minCos = 1.0f, maxErr = 0.0f;
+	sum = 0.0;
+	for (int32 i = 0; i < m; i++) {
+		float32 c = points[i].dot3(normal).getFloat();
+		minCos = (c < minCos) ? c : minCos;
+		maxErr = jlMath::Max(maxErr, jlMath::Abs(points[i].length3().getFloat() - 1.0f));
+		sum += c;
+	}
+	std::cout << "Cosine hemisphere: min cos " << minCos << ", mean cos " << sum / m << ", max length error " << maxErr << std::endl;
+	delete [] points;
+}
+
+void runDistributionBenchmark() {
+	const int32 n = 1 << 16;
+	const int32 iterations = 100;
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	float32 *samples = static_cast<float32 *>(jlAllocAligned(n * sizeof(float32), 16));
+	jlVector4 *points = new jlVector4[n / 4];
+	jlTimer timer;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) {
+		for (int32 i = 0; i < n; i++) samples[i] = random.randFloat32();
+	}
+	std::cout << "randFloat32 loop: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per sample" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) random.fillFloat32(samples, n);
+	std::cout << "fillFloat32: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per sample" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::FillNormal(random, samples, n);
+	std::cout << "FillNormal: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per sample" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::FillExponential(random, samples, n);
+	std::cout << "FillExponential: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per sample" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::FillUnitSphere(random, points, n / 4);
+	std::cout << "FillUnitSphere: " << timer.getElapsedSeconds() * 1.0e9 / (n / 4 * iterations) << " ns per vector" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::FillUnitDisk(random, points, n / 4);
+	std::cout << "FillUnitDisk: " << timer.getElapsedSeconds() * 1.0e9 / (n / 4 * iterations) << " ns per vector" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::FillCosineHemisphere(random, points, n / 4, jlVector4::UNIT_Y);
+	std::cout << "FillCosineHemisphere: " << timer.getElapsedSeconds() * 1.0e9 / (n / 4 * iterations) << " ns per vector" << std::endl;
+	delete [] points;
+	jlFreeAligned(samples);
+}
+
+void runBoundedTest() {
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	// above 2^24 scaling a float can only reach multiples of the float spacing
+	const uint32 big = 3000000001U;
+	int32 oddFloat = 0, oddLemire = 0;
+	for (int32 i = 0; i < 10000; i++) {
+		oddFloat += static_cast<uint32>(big * random.randFloat32()) & 1;
+		oddLemire += random.randUint32(big) & 1;
+	}
+	std::cout << "Odd draws below 3000000001 of 10000: float " << oddFloat << ", Lemire " << oddLemire << std::endl;
+	// die rolls from the bulk path, each face near 1/6
+	const int32 n = 60000;
+	uint32 *rolls = static_cast<uint32 *>(jlAllocAligned(n * sizeof(uint32), 16));
+	random.fillUint32(rolls, n, 6);
+	int32 faces[7] = { 0, 0, 0, 0, 0, 0, 0 };
+	for (int32 i = 0; i < n; i++) faces[(rolls[i] < 6) ? rolls[i] : 6]++;
+	std::cout << "Die faces:";
+	for (int32 f = 0; f < 7; f++) std::cout << " " << faces[f];
+	std::cout << std::endl;
+	jlFreeAligned(rolls);
+	// every ordering of four items about equally often
+	int32 orders[256] = { 0 };
+	for (int32 it = 0; it < 24000; it++) {
+		int32 items[4] = { 0, 1, 2, 3 };
+		jlDistribution::Shuffle(random, items, 4);
+		orders[items[0] * 64 + items[1] * 16 + items[2] * 4 + items[3]]++;
+	}
+	int32 minOrder = 24000, maxOrder = 0, seen = 0;
+	for (int32 i = 0; i < 256; i++) {
+		if (orders[i] == 0) continue;
+		seen++;
+		minOrder = (orders[i] < minOrder) ? orders[i] : minOrder;
+		maxOrder = (orders[i] > maxOrder) ? orders[i] : maxOrder;
+	}
+	std::cout << "Shuffle of 4: " << seen << " orders seen, counts " << minOrder << " to " << maxOrder << " (1000 each)" << std::endl;
+	int32 picked[10];
+	jlDistribution::SampleIndices(random, picked, 10, 1000);
+	bool32 ascending = 1;
+	for (int32 i = 1; i < 10; i++) ascending = ascending && picked[i] > picked[i - 1];
+	PRINT_INT_OP(ascending);
+}
+
+void runBoundedBenchmark() {
+	const int32 n = 1 << 16;
+	const int32 iterations = 100;
+	const uint32 max = 1000;
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	uint32 *out = static_cast<uint32 *>(jlAllocAligned(n * sizeof(uint32), 16));
+	jlTimer timer;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) {
+		for (int32 i = 0; i < n; i++) out[i] = static_cast<uint32>(max * random.randFloat32());
+	}
+	std::cout << "Float scaled bound: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) {
+		for (int32 i = 0; i < n; i++) out[i] = random.randUint32(max);
+	}
+	std::cout << "randUint32(max): " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) random.fillUint32(out, n, max);
+	std::cout << "fillUint32(max): " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per draw" << std::endl;
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) jlDistribution::Shuffle(random, out, n);
+	std::cout << "Shuffle: " << timer.getElapsedSeconds() * 1.0e9 / (n * iterations) << " ns per item" << std::endl;
+	jlFreeAligned(out);
+}
+
+void runDoubleBufferTest() {
+	jlRandom single, twin;
+	single.init(1001);
+	twin.init(1001);
+	single.seed(4321);
+	twin.seed(4321);
+	twin.setDoubleBuffered(BOOL32_TRUE);
+	int32 mismatches = 0;
+	for (int32 i = 0; i < 10000; i++) {
+		if (single.randUint32() != twin.randUint32()) mismatches++;
+	}
+	// toggling mid stream, bulk fills and jumps must not change the values
+	twin.setDoubleBuffered(BOOL32_FALSE);
+	for (int32 i = 0; i < 3000; i++) {
+		if (single.randUint32() != twin.randUint32()) mismatches++;
+	}
+	twin.setDoubleBuffered(BOOL32_TRUE);
+	single.jump();
+	twin.jump();
+	for (int32 i = 0; i < 10000; i++) {
+		if (single.randUint32() != twin.randUint32()) mismatches++;
+	}
+	// a direct fill moves where the single buffered blocks end, so this comes after the jump
+	JL_ALIGN_16 uint32 a[5000];
+	JL_ALIGN_16 uint32 b[5000];
+	single.fillUint32(a, 5000);
+	twin.fillUint32(b, 5000);
+	for (int32 i = 0; i < 5000; i++) {
+		if (a[i] != b[i]) mismatches++;
+	}
+	jlRandom copy;
+	copy.init(1001);
+	copy.setDoubleBuffered(BOOL32_TRUE);
+	copy.copyState(twin);
+	for (int32 i = 0; i < 10000; i++) {
+		if (single.randUint32() != copy.randUint32()) mismatches++;
+	}
+	std::cout << "Double buffered mismatches: " << mismatches << std::endl;
+
+	// worst single draw, the refill spike is what double buffering removes
+	// each draw keeps its fastest of several passes so preemption drops out
+	const int32 draws = 1 << 14;
+	int64 *fastest = static_cast<int64 *>(jlAllocAligned(draws * sizeof(int64), 16));
+	for (int32 mode = 0; mode < 2; mode++) {
+		uint32 sum = 0;
+		for (int32 pass = 0; pass < 8; pass++) {
+			jlRandom random;
+			random.init(1024);
+			random.seed(99);
+			random.setDoubleBuffered(mode);
+			for (int32 i = 0; i < draws; i++) {
+				const int64 start = jlTimer::GetCycles();
+				sum += random.randUint32();
+				const int64 cycles = jlTimer::GetCycles() - start;
+				if (pass == 0 || cycles < fastest[i]) fastest[i] = cycles;
+			}
+		}
+		int64 worst = 0;
+		for (int32 i = 0; i < draws; i++) {
+			if (fastest[i] > worst) worst = fastest[i];
+		}
+		std::cout << (mode ? "Double" : "Single") << " buffered worst draw: " << worst << " cycles (" << sum << ")" << std::endl;
+	}
+	jlFreeAligned(fastest);
+}
+
+// next, fillVector4 and fillSoA from an odd index must give the same points
+template <class S>
+int32 quasiRandomMismatches(S& sequence) {
+	const int32 n = 37;
+	const int32 dims = sequence.getDimensions();
+	float32 single[n][S::MAX_DIMENSIONS];
+	float32 *soa = static_cast<float32 *>(jlAllocAligned(n * dims * sizeof(float32), 16));
+	jlVector4 *vectors = static_cast<jlVector4 *>(jlAllocAligned(n * sizeof(jlVector4), 16));
+	sequence.setIndex(5);
+	for (int32 i = 0; i < n; i++) sequence.next(single[i]);
+	sequence.setIndex(5);
+	sequence.fillSoA(soa, n);
+	sequence.setIndex(5);
+	sequence.fillVector4(vectors, n);
+	int32 mismatches = 0;
+	for (int32 i = 0; i < n; i++) {
+		for (int32 d = 0; d < dims; d++) {
+			mismatches += single[i][d] != soa[d * n + i];
+			if (d < 4) mismatches += single[i][d] != vectors[i](d);
+		}
+	}
+	mismatches += sequence.getIndex() != 5 + n;
+	jlFreeAligned(soa);
+	jlFreeAligned(vectors);
+	return mismatches;
+}
+
+// mean of x y z w over the unit cube, exactly 1/16
+template <class S>
+float64 quasiRandomIntegrationError(S& sequence, int32 n) {
+	float64 sum = 0.0;
+	for (int32 i = 0; i < n; i++) {
+		jlVector4 p = sequence.nextVector4();
+		sum += p(0) * p(1) * p(2) * p(3);
+	}
+	return fabs(sum / n - 1.0 / 16.0);
+}
+
+void runQuasiRandomTest() {
+	jlRandom random;
+	random.init(jlRandom::STATE_SIZE);
+	random.seed();
+	jlSobol sobol(6);
+	jlHalton halton(6);
+	jlKronecker kronecker(6);
+	int32 mismatches = quasiRandomMismatches(sobol) + quasiRandomMismatches(halton) + quasiRandomMismatches(kronecker);
+	sobol.randomize(random);
+	halton.randomize(random);
+	kronecker.randomize(random);
+	mismatches += quasiRandomMismatches(sobol) + quasiRandomMismatches(halton) + quasiRandomMismatches(kronecker);
+	std::cout << "Quasi random mismatches: " << mismatches << std::endl;
+
+	// the first 1024 points of a scrambled Sobol dimension fill each of 1024 bins once
+	const int32 bins = 1024;
+	jlSobol scrambled(jlSobol::MAX_DIMENSIONS);
+	scrambled.randomize(random);
+	float32 *soa = static_cast<float32 *>(jlAllocAligned(bins * jlSobol::MAX_DIMENSIONS * sizeof(float32), 16));
+	scrambled.fillSoA(soa, bins);
+	int32 collisions = 0;
+	for (int32 d = 0; d < jlSobol::MAX_DIMENSIONS; d++) {
+		int32 hits[bins] = { 0 };
+		for (int32 i = 0; i < bins; i++) collisions += hits[static_cast<int32>(soa[d * bins + i] * bins)]++ > 0;
+	}
+	jlFreeAligned(soa);
+	std::cout << "Sobol stratification collisions: " << collisions << std::endl;
+
+	const int32 n = 4096;
+	jlSobol sobol4(4);
+	jlHalton halton4(4);
+	jlKronecker kronecker4(4);
+	sobol4.randomize(random);
+	halton4.randomize(random);
+	kronecker4.randomize(random);
+	float64 randomSum = 0.0;
+	for (int32 i = 0; i < n; i++) {
+		randomSum += random.randFloat32() * random.randFloat32() * random.randFloat32() * random.randFloat32();
+	}
+	std::cout << "Integration error over " << n << " points, random: " << fabs(randomSum / n - 1.0 / 16.0)
+		<< " sobol: " << quasiRandomIntegrationError(sobol4, n)
+		<< " halton: " << quasiRandomIntegrationError(halton4, n)
+		<< " kronecker: " << quasiRandomIntegrationError(kronecker4, n) << std::endl;
+}
+
+void runAlignedCacheTest() {
+	const int32 n = 4096;
+	const size_t sizes[] = { 16, 48, 64, 100, 256, 1024 };
+	const size_t alignments[] = { 16, 32, 64 };
+	uint8 **blocks = new uint8 *[n];
+	jlMemoryResetStats();
+	int32 misaligned = 0, corrupted = 0, cached = 0;
+	for (int32 pass = 0; pass < 4; pass++) {
+		for (int32 i = 0; i < n; i++) {
+			const size_t sz = sizes[i % 6], alignment = alignments[i % 3];
+			cached += sz <= JL_MEMORY_MAX_CACHED_SIZE;
+			blocks[i] = static_cast<uint8 *>(jlAllocAlignedCached(sz, alignment));
+			misaligned += ((uintptr_t)blocks[i] & (alignment - 1)) != 0;
+			memset(blocks[i], i & 0xff, sz);
+		}
+		// overlapping blocks would have overwritten each other's fill
+		for (int32 i = 0; i < n; i++) {
+			const size_t sz = sizes[i % 6];
+			corrupted += blocks[i][0] != (i & 0xff) || blocks[i][sz - 1] != (i & 0xff);
+			jlFreeAlignedCached(blocks[i], sz, alignments[i % 3]);
+		}
+	}
+	delete [] blocks;
+	// aligned types take the cache through their class new and sized delete
+	jlQuaternion *quats[8];
+	for (int32 k = 0; k < 8; k++) quats[k] = new jlQuaternion();
+	for (int32 k = 0; k < 8; k++) delete quats[k];
+#if (JL_USE_ALIGNED_BLOCK_CACHE)
+	cached += 8;
+#endif
+	jlMemoryStats stats;
+	jlMemoryGetStats(&stats);
+	std::cout << "Aligned cache misaligned: " << misaligned << " corrupted: " << corrupted << std::endl;
+	// every cached allocation is a hit or a miss and every one was freed,
+	// release builds only count the misses
+#ifdef JL_DEBUG
+	const bool8 counted = stats.cacheHits > 0 && stats.cacheHits + stats.cacheMisses == cached && stats.cacheFrees == cached;
+	std::cout << "Aligned cache hits " << stats.cacheHits << " misses " << stats.cacheMisses << " frees " << stats.cacheFrees
+		<< " of " << cached << " uncached " << stats.uncachedAllocs << " chunks " << stats.cacheChunks
+		<< ", hit rate " << 100.0 * stats.cacheHits / (stats.cacheHits + stats.cacheMisses) << "%";
+#else
+	const bool8 counted = stats.cacheMisses > 0 && stats.cacheMisses < cached;
+	std::cout << "Aligned cache misses " << stats.cacheMisses << " of " << cached << " uncached " << stats.uncachedAllocs
+		<< " chunks " << stats.cacheChunks;
+#endif
+	std::cout << ((counted && misaligned == 0 && corrupted == 0) ? " (ok)" : " (FAILED)") << std::endl;
+
+	jlMemoryReleaseCache();
+}
+
+/// Cached against plain aligned allocation, eight blocks alive at a time
+void runAlignedCacheBenchmark() {
+	const int32 iterations = 1 << 18;
+	const size_t sizes[] = { 16, 64, 256 };
+	void *ptr[8];
+	jlTimer timer;
+	for (int32 s = 0; s < 3; s++) {
+		const size_t sz = sizes[s];
+		timer.start();
+		for (int32 it = 0; it < iterations; it++) {
+			for (int32 k = 0; k < 8; k++) ptr[k] = jlAllocAligned(sz, 16);
+			for (int32 k = 0; k < 8; k++) jlFreeAligned(ptr[k]);
+		}
+		const float64 plain = timer.getElapsedSeconds() * 1.0e9 / (iterations * 8);
+		timer.start();
+		for (int32 it = 0; it < iterations; it++) {
+			for (int32 k = 0; k < 8; k++) ptr[k] = jlAllocAlignedCached(sz, 16);
+			for (int32 k = 0; k < 8; k++) jlFreeAlignedCached(ptr[k], sz, 16);
+		}
+		const float64 cached = timer.getElapsedSeconds() * 1.0e9 / (iterations * 8);
+		std::cout << sz << " bytes alloc/free: jlAllocAligned " << plain << " ns, jlAllocAlignedCached " << cached
+			<< " ns, cache " << ((cached < plain) ? "faster" : "slower") << std::endl;
+	}
+	jlMemoryReleaseCache();
+}
+
+
+template <jlMath::Accuracy A>
+void sinArray(const float32 *x, float32 *out, int32 n) {
+	for (int32 i = 0; i < n; i += 4) {
+		jlVector4 v; v.loadAligned(x + i);
+		jlMath::Sin<A>(v).storeAligned(out + i);
+	}
+}
+
+void reportTrigBenchmark(const char8 *name, const jlTimer& timer, int32 lookups, const float32 *x, const float32 *out, int32 n) {
+	float32 maxErr = 0.0f;
+	for (int32 i = 0; i < n; i++) {
+		float32 err = jlMath::Abs(out[i] - (float32)sin((float64)x[i]));
+		if (err > maxErr) maxErr = err;
+	}
+	std::cout << name << ": " << timer.getElapsedSeconds() * 1.0e9 / lookups << " ns per sin, max error " << maxErr << std::endl;
+}
+
+void runTrigTableBenchmark() {
+	const int32 n = 1 << 14;
+	const int32 iterations = 200;
+	float32 *x = static_cast<float32 *>(jlAllocAligned(n * sizeof(float32), 16));
+	float32 *out = static_cast<float32 *>(jlAllocAligned(n * sizeof(float32), 16));
+	jlRandom random;
+	random.init(1024);
+	random.seed();
+	for (int32 i = 0; i < n; i++) {
+		x[i] = random.randFloat32(-jlMath::PI, jlMath::PI);
+	}
+	const jlTrigTable& table = jlTrigTable::GetDefault();
+	jlTimer timer;
+	for (int32 it = 0; it < iterations; it++) table.sin<jlTrigTable::FILTER_NEAREST>(x, out, n);
+	reportTrigBenchmark("Table nearest", timer, n * iterations, x, out, n);
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) table.sin<jlTrigTable::FILTER_LINEAR>(x, out, n);
+	reportTrigBenchmark("Table linear", timer, n * iterations, x, out, n);
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) sinArray<jlMath::ACCURACY_LOW>(x, out, n);
+	reportTrigBenchmark("Polynomial LOW", timer, n * iterations, x, out, n);
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) sinArray<jlMath::ACCURACY_MEDIUM>(x, out, n);
+	reportTrigBenchmark("Polynomial MEDIUM", timer, n * iterations, x, out, n);
+	timer.start();
+	for (int32 it = 0; it < iterations; it++) sinArray<jlMath::ACCURACY_FULL>(x, out, n);
+	reportTrigBenchmark("Polynomial FULL", timer, n * iterations, x, out, n);
+	// the scalar table path and cos quarter period offset
+	PRINT_FLOAT_OP(table.cos(0.0f));
+	PRINT_FLOAT_OP(table.cos<jlTrigTable::FILTER_LINEAR>(-jlMath::PI));
+	PRINT_VEC4_OP(table.sin<jlTrigTable::FILTER_LINEAR>(jlVector4(0.0f, jlMath::PI_OVER_TWO, -jlMath::PI_OVER_TWO, 10.0f)));
+	PRINT_FLOAT_OP(jlMath::Sin(jlMath::PI_OVER_FOUR, true));
+	jlFreeAligned(x);
+	jlFreeAligned(out);
+}
+
 /* BEGIN BARYCENTRIC/RAY TEST */
 void barycentric(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& pt, jlSimdFloat* JL_RESTRICT u, jlSimdFloat* JL_RESTRICT v, jlSimdFloat* JL_RESTRICT w) {
 	jlVector4 ab = b - a, ac = c - a, ap = pt - a;
@@ -184,8 +1186,9 @@ void barycentric(const jlVector4& a, const jlVector4& b, const jlVector4& c, con
 	jlSimdFloat d20 = ap.dot3(ab);
 	jlSimdFloat d21 = ap.dot3(ac);
 	jlSimdFloat denom = d00 * d11 - d01 * d01;
-	*v = (d11 * d20 - d01 * d21) / denom;
-	*w = (d00 * d21 - d01 * d20) / denom;
+	jlSimdFloat invDenom = jlMath::Reciprocal<jlMath::PRECISION_ONE_NEWTON>(denom);
+	*v = (d11 * d20 - d01 * d21) * invDenom;
+	*w = (d00 * d21 - d01 * d20) * invDenom;
 	*u = one - *v - *w;
 }
 
@@ -323,6 +1326,7 @@ const int32 MAX_NUM_PARTICLES = 1024;
 static jlParticle PARTICLE_LIST[MAX_NUM_PARTICLES];
 
 void updateAOSParticles(int32 iterations) {
+	jlFPEnvironment flushDenormals; // decaying energies and velocities go denormal
 	jlSimdFloat timeSlice = jlSimdFloat(1.0f / 60.0f);
 	for (int32 iter = 0; iter < iterations; ++iter) {
 		for (int32 p = 0; p < MAX_NUM_PARTICLES; p += 4) {
@@ -332,6 +1336,7 @@ void updateAOSParticles(int32 iterations) {
 			PARTICLE_LIST[p + 3].update(timeSlice);
 		}
 	}
+	JL_FP_SAMPLE("updateAOSParticles");
 }
 
 /// Struct of Arrays Particles
@@ -358,6 +1363,7 @@ void initSOAParticles() {
 }
 
 void updateSOAParticles(int32 iterations) {
+	jlFPEnvironment flushDenormals; // accelerations decay by dt every iteration
 	jlSimdFloat dt = jlSimdFloat(1.0f / 60.0f);
 	for (int32 iter = 0; iter < iterations; iter++) {
 		for (int32 ap = 0; ap < MAX_NUM_PARTICLES; ap += 4) {
@@ -417,6 +1423,27 @@ void updateSOAParticles(int32 iterations) {
 			ALL_PARTICLES.energies[ep + 3] -= dt;
 		}
 	}
+	JL_FP_SAMPLE("updateSOAParticles");
+}
+
+/// Same update as updateSOAParticles, the three vector loops are fused into 
+/// one pass so each array is only streamed through the cache once per iteration
+void updateSOAParticlesFused(int32 iterations) {
+	jlFPEnvironment flushDenormals;
+	jlSimdFloat dt = jlSimdFloat(1.0f / 60.0f);
+	jlVector4Stream accelerations(ALL_PARTICLES.accelerations, MAX_NUM_PARTICLES);
+	jlVector4Stream velocities(ALL_PARTICLES.velocities, MAX_NUM_PARTICLES);
+	jlVector4Stream positions(ALL_PARTICLES.positions, MAX_NUM_PARTICLES);
+	for (int32 iter = 0; iter < iterations; iter++) {
+		positions += velocities.store((velocities + accelerations.store(accelerations * dt) * dt) * dt);
+		for (int32 ep = 0; ep < MAX_NUM_PARTICLES; ep += 4) {
+			ALL_PARTICLES.energies[ep] -= dt;
+			ALL_PARTICLES.energies[ep + 1] -= dt;
+			ALL_PARTICLES.energies[ep + 2] -= dt;
+			ALL_PARTICLES.energies[ep + 3] -= dt;
+		}
+	}
+	JL_FP_SAMPLE("updateSOAParticlesFused");
 }
 
 // http://stackoverflow.com/questions/794632/programmatically-get-the-cache-line-size
@@ -477,8 +1504,17 @@ void testVector4() {
 	PRINT_VEC4_OP2(a, a.normalize4());
 	a.set(5.0f, 5.0f, 5.0f);
 	jlSimdFloat len = a.normalize3WithLength();
-	PRINT_VEC4_OP2(a, a.normalize3());
+	PRINT_VEC4_OP(a); // {0.57735, 0.57735, 0.57735, 0}
 	PRINT_SIMDFLOAT_OP(len);
+	a.set(3.0f, 0.0f, 4.0f);
+	PRINT_VEC4_OP2(a, a.normalize3<jlMath::PRECISION_RAW>());
+	a.set(3.0f, 0.0f, 4.0f);
+	PRINT_VEC4_OP2(a, a.normalize3<jlMath::PRECISION_IEEE>());
+	a.setZero4();
+	PRINT_VEC4_OP2(a, a.normalize3<jlMath::PRECISION_TWO_NEWTON>()); // stays zero
+	PRINT_VEC4_OP(jlMath::Reciprocal<jlMath::PRECISION_ONE_NEWTON>(jlVector4(2.0f, 4.0f, -8.0f, 0.1f)));
+	PRINT_VEC4_OP(jlMath::InvSqrt<jlMath::PRECISION_TWO_NEWTON>(jlVector4(1.0f, 4.0f, 16.0f, 0.25f)));
+	PRINT_VEC4_OP2(a, a.setDiv<jlMath::PRECISION_ONE_NEWTON>(jlVector4(1.0f, 2.0f, 3.0f), jlSimdFloat(4.0f)));
 	// cross
 	jlVector4 uy = jlVector4(0, 1, 0);
 	jlVector4 uz = jlVector4(0, 0, 1);
@@ -507,6 +1543,54 @@ void testVector4() {
 	std::cout << "-- End jlVector4 Testing --" << std::endl;
 }
 
+void testVector4Stream() {
+	std::cout << "-- Begin Testing jlVector4Stream --" << std::endl;
+	const int32 n = 7; // not a multiple of the unroll
+	JL_ALIGN_16 jlVector4 pos[n], vel[n], acc[n], expected[n];
+	for (int32 i = 0; i < n; ++i) {
+		float32 f = (float32)i;
+		pos[i].set(f, 0.0f, -f, 1.0f);
+		vel[i].set(1.0f, f, 2.0f, 0.0f);
+		acc[i].set(0.0f, -9.8f, f, 0.0f);
+	}
+	jlVector4Stream p(pos, n), v(vel, n), a(acc, n);
+	jlSimdFloat dt = jlSimdFloat(0.5f);
+	for (int32 i = 0; i < n; ++i) {
+		expected[i] = pos[i] + (vel[i] + acc[i] * dt) * dt;
+	}
+	p += (v + a * dt) * dt;
+	PRINT_VEC4_OP(pos[n - 1]);
+	PRINT_VEC4_OP(expected[n - 1]);
+	jlSimdFloat maxErr = jlSimdFloat(0.0f);
+	for (int32 i = 0; i < n; ++i) {
+		maxErr.setMax(maxErr, (pos[i] - expected[i]).length4());
+	}
+	PRINT_SIMDFLOAT_OP(maxErr);
+	// assignment, constants and stores
+	p = v * v - jlVector4::UNIT_X;
+	PRINT_VEC4_OP(pos[2]); // {0, 4, 4, 0}
+	p = v.store(v / jlSimdFloat(2.0f)) + jlVector4::ONE;
+	PRINT_VEC4_OP(vel[2]); // {0.5, 1, 1, 0}
+	PRINT_VEC4_OP(pos[2]); // {1.5, 2, 2, 1}
+	// fused particle update matches the three loop version
+	initSOAParticles();
+	for (int32 i = 0; i < MAX_NUM_PARTICLES; ++i) {
+		ALL_PARTICLES.accelerations[i].set(0.0f, -9.8f, 0.0f);
+		ALL_PARTICLES.velocities[i].set(1.0f, 2.0f, (float32)i);
+	}
+	updateSOAParticles(2);
+	jlVector4 loopPos = ALL_PARTICLES.positions[MAX_NUM_PARTICLES - 1];
+	initSOAParticles();
+	for (int32 i = 0; i < MAX_NUM_PARTICLES; ++i) {
+		ALL_PARTICLES.accelerations[i].set(0.0f, -9.8f, 0.0f);
+		ALL_PARTICLES.velocities[i].set(1.0f, 2.0f, (float32)i);
+	}
+	updateSOAParticlesFused(2);
+	PRINT_VEC4_OP(loopPos);
+	PRINT_VEC4_OP(ALL_PARTICLES.positions[MAX_NUM_PARTICLES - 1]);
+	std::cout << "-- End jlVector4Stream Testing --" << std::endl;
+}
+
 void testVector2() {
 	std::cout << "-- Begin Testing jlVector2 --" << std::endl;
 	jlVector2 a = jlVector2(2.0f, 5.0f);
@@ -616,6 +1700,11 @@ void testMatrix4() {
 	PRINT_VEC4_OP(a * pt); // should translate the point 10, 0, 0
 	PRINT_MATRIX4_OP(a);
 	PRINT_MATRIX4_OP(a * a.inverse()); // should be identity
+	PRINT_MATRIX4_OP(a * a.inverse<jlMath::PRECISION_ONE_NEWTON>()); // identity to about 1e-6
+	a.makeRotationY(jlSimdFloat(jlMath::PI_OVER_TWO));
+	PRINT_VEC4_OP(a * jlVector4::UNIT_X); // should be 0, 0, -1
+	a.makeRotationZ(jlSimdFloat(jlMath::PI_OVER_TWO));
+	PRINT_VEC4_OP(a * jlVector4::UNIT_X); // should be 0, 1, 0
 	std::cout << "-- End Testing jlMatrix4 --" << std::endl;
 }
 
@@ -650,6 +1739,24 @@ void testQuaternion() {
 		t.setMin(t, jlSimdFloat(1.0f));
 		PRINT_QUATERNION_OP(jlQuaternion::Slerp(q0, q1, t));
 	}
+
+	// euler angles apply x, then y, then z
+	jlVector4 euler = jlVector4(0.3f, -1.1f, 2.0f);
+	jlQuaternion qx, qy, qz, qe;
+	qx.setAxisAngle(jlVector4::UNIT_X, euler.getElem<0>());
+	qy.setAxisAngle(jlVector4::UNIT_Y, euler.getElem<1>());
+	qz.setAxisAngle(jlVector4::UNIT_Z, euler.getElem<2>());
+	qe.setEuler(euler);
+	PRINT_QUATERNION_OP(qz * (qy * qx));
+	PRINT_QUATERNION_OP(qe); // should match the line above
+
+	jlVector4 axes[5] = { jlVector4::UNIT_X, jlVector4::UNIT_Y, jlVector4::UNIT_Z, jlVector4::NEG_UNIT_X, jlVector4::NEG_UNIT_Y };
+	float32 angles[5] = { 0.0f, 0.5f, 1.0f, 1.5f, 2.0f };
+	jlQuaternion batch[5];
+	jlQuaternion::FromAxisAngles(axes, angles, batch, 5);
+	for (int32 i = 0; i < 5; ++i) {
+		PRINT_QUATERNION_OP(batch[i]);
+	}
 	std::cout << "-- End Testing jlQuaternion --" << std::endl;
 }
 /* END UNIT TESTS */
@@ -0,0 +1,327 @@
+/// @file jlrandom_quality.cpp
+/// @author Jeff Lansing
+/// Runs a small statistical battery over every generator and prints one
+/// table of p-values and throughput for deciding which to use where.
+/// The tests are chi-square over byte buckets, lag one serial correlation,
+/// Marsaglia's birthday spacings, Knuth's gap test and the frequency of
+/// each of the 32 bits.  Seeds are fixed so a run is repeatable, a p-value
+/// beyond P_FAIL on either side fails the row and the run exits with 1.
+/// The LCG row is a control that should fail, it is not counted.
+/// Usage: jlrandom_quality [-large]
+/// -large draws 16 times as many values per test.
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "util/jlRandom.h"
+#include "util/jlCounterRandom.h"
+#include "util/jlFastRandom.h"
+#include "util/jlTimer.h"
+
+namespace {
+	const int32 BATCH_SIZE = 1 << 16;
+	// draws per test are DEFAULT_BATCHES batches, -large multiplies them
+	const int32 DEFAULT_BATCHES = 64;
+	const int32 LARGE_SCALE = 16;
+	const int32 THROUGHPUT_BATCHES = 256;
+	const float64 P_FAIL = 1.0e-4;
+	const uint64 SEED = 20120815;
+
+	// 4096 birthdays in a year of 2^32 days, lambda = m^3 / 4n = 4
+	const int32 BIRTHDAYS = 4096;
+	const float64 BIRTHDAY_LAMBDA = 4.0;
+	// gaps between draws whose top GAP_BITS are zero, the last bin is
+	// every gap of GAP_BINS - 1 or longer
+	const int32 GAP_BITS = 3;
+	const int32 GAP_BINS = 17;
+
+	const int32 NUM_TESTS = 5;
+	const char8 *TEST_NAMES[NUM_TESTS] = { "buckets", "serial", "birthday", "gap", "bits" };
+
+	typedef void (*jlSeedFunc)(uint64 seed);
+	typedef void (*jlFillFunc)(uint32 *out, int32 count);
+
+	struct jlGeneratorCase {
+		const char8 *name;
+		jlSeedFunc seed;
+		jlFillFunc fill;
+		bool8 control;
+	};
+
+	/// Lanczos log gamma, the CRT of MSVC 2010 has no lgamma
+	float64 LogGamma(float64 x) {
+		static const float64 coeffs[6] = { 76.18009172947146, -86.50532032941677, 24.01409824083091,
+			-1.231739572450155, 0.1208650973866179e-2, -0.5395239384953e-5 };
+		float64 tmp = x + 5.5;
+		tmp -= (x + 0.5) * log(tmp);
+		float64 series = 1.000000000190015;
+		float64 y = x;
+		for (int32 i = 0; i < 6; ++i) {
+			series += coeffs[i] / ++y;
+		}
+		return -tmp + log(2.5066282746310005 * series / x);
+	}
+
+	/// Upper regularized incomplete gamma Q(a, x), the series for P below
+	/// a + 1 and Lentz's continued fraction above
+	float64 GammaQ(float64 a, float64 x) {
+		if (x <= 0.0) return 1.0;
+		const float64 gln = LogGamma(a);
+		if (x < a + 1.0) {
+			float64 ap = a, sum = 1.0 / a, del = sum;
+			for (int32 n = 0; n < 1000 && fabs(del) > fabs(sum) * 1.0e-15; ++n) {
+				del *= x / ++ap;
+				sum += del;
+			}
+			return 1.0 - sum * exp(-x + a * log(x) - gln);
+		}
+		const float64 tiny = 1.0e-300;
+		float64 b = x + 1.0 - a, c = 1.0 / tiny, d = 1.0 / b, h = d;
+		for (int32 i = 1; i < 1000; ++i) {
+			const float64 an = -i * (i - a);
+			b += 2.0;
+			d = an * d + b;
+			if (fabs(d) < tiny) d = tiny;
+			c = b + an / c;
+			if (fabs(c) < tiny) c = tiny;
+			d = 1.0 / d;
+			const float64 del = d * c;
+			h *= del;
+			if (fabs(del - 1.0) < 1.0e-15) break;
+		}
+		return exp(-x + a * log(x) - gln) * h;
+	}
+
+	float64 ChiSquareP(float64 chi2, int32 dof) {
+		return GammaQ(0.5 * dof, 0.5 * chi2);
+	}
+
+	/// Standard normal cdf, erfc(|z| / sqrt(2)) is Q(1/2, z^2 / 2).  Like the
+	/// chi-square p it is uniform for a good generator, so both ends fail.
+	float64 NormalCdf(float64 z) {
+		const float64 tail = 0.5 * GammaQ(0.5, 0.5 * z * z);
+		return (z < 0.0) ? tail : 1.0 - tail;
+	}
+
+	float64 ToUnit(uint32 x) {
+		return x * (1.0 / 4294967296.0);
+	}
+
+	/// Top byte counts against a flat 256 bucket histogram
+	float64 BucketTest(jlFillFunc fill, uint32 *buffer, int32 batches) {
+		int64 counts[256];
+		memset(counts, 0, sizeof(counts));
+		for (int32 b = 0; b < batches; ++b) {
+			fill(buffer, BATCH_SIZE);
+			for (int32 i = 0; i < BATCH_SIZE; ++i) {
+				++counts[buffer[i] >> 24];
+			}
+		}
+		const float64 expected = static_cast<float64>(batches) * BATCH_SIZE / 256.0;
+		float64 chi2 = 0.0;
+		for (int32 i = 0; i < 256; ++i) {
+			const float64 d = counts[i] - expected;
+			chi2 += d * d / expected;
+		}
+		return ChiSquareP(chi2, 255);
+	}
+
+	/// Lag one correlation of the draws as uniforms, sqrt(n) r is close to
+	/// a standard normal for independent draws
+	float64 SerialTest(jlFillFunc fill, uint32 *buffer, int32 batches) {
+		float64 sum = 0.0, sumSq = 0.0, sumLag = 0.0;
+		float64 prev = 0.0;
+		int64 n = 0;
+		for (int32 b = 0; b < batches; ++b) {
+			fill(buffer, BATCH_SIZE);
+			for (int32 i = 0; i < BATCH_SIZE; ++i, ++n) {
+				const float64 u = ToUnit(buffer[i]);
+				if (n > 0) sumLag += prev * u;
+				sum += u;
+				sumSq += u * u;
+				prev = u;
+			}
+		}
+		const float64 mean = sum / n;
+		const float64 variance = sumSq / n - mean * mean;
+		const float64 r = (sumLag / (n - 1) - mean * mean) / variance;
+		return NormalCdf(r * sqrt(static_cast<float64>(n)));
+	}
+
+	/// Duplicate spacings between BIRTHDAYS sorted 32 bit draws are
+	/// Poisson with BIRTHDAY_LAMBDA, the total over every sample is
+	/// compared with its normal approximation
+	float64 BirthdayTest(jlFillFunc fill, uint32 *buffer, int32 batches) {
+		uint32 spacings[BIRTHDAYS];
+		int64 duplicates = 0, samples = 0;
+		for (int32 b = 0; b < batches; ++b) {
+			fill(buffer, BATCH_SIZE);
+			for (int32 s = 0; s + BIRTHDAYS <= BATCH_SIZE; s += BIRTHDAYS, ++samples) {
+				uint32 *days = buffer + s;
+				std::sort(days, days + BIRTHDAYS);
+				spacings[0] = days[0];
+				for (int32 i = 1; i < BIRTHDAYS; ++i) {
+					spacings[i] = days[i] - days[i - 1];
+				}
+				std::sort(spacings, spacings + BIRTHDAYS);
+				for (int32 i = 1; i < BIRTHDAYS; ++i) {
+					duplicates += spacings[i] == spacings[i - 1];
+				}
+			}
+		}
+		const float64 expected = samples * BIRTHDAY_LAMBDA;
+		return NormalCdf((duplicates - expected) / sqrt(expected));
+	}
+
+	/// Runs between draws that land in the lowest 1 / 2^GAP_BITS of the
+	/// range are geometric, binned and compared by chi-square
+	float64 GapTest(jlFillFunc fill, uint32 *buffer, int32 batches) {
+		int64 counts[GAP_BINS];
+		memset(counts, 0, sizeof(counts));
+		int64 gaps = 0;
+		int32 run = 0;
+		for (int32 b = 0; b < batches; ++b) {
+			fill(buffer, BATCH_SIZE);
+			for (int32 i = 0; i < BATCH_SIZE; ++i) {
+				if ((buffer[i] >> (32 - GAP_BITS)) == 0) {
+					++counts[(run < GAP_BINS - 1) ? run : GAP_BINS - 1];
+					++gaps;
+					run = 0;
+				} else {
+					++run;
+				}
+			}
+		}
+		const float64 p = 1.0 / (1 << GAP_BITS);
+		float64 chi2 = 0.0, tail = 1.0;
+		for (int32 r = 0; r < GAP_BINS; ++r) {
+			// P(gap = r) = p (1 - p)^r, the last bin takes the whole tail
+			const float64 prob = (r < GAP_BINS - 1) ? p * tail : tail;
+			const float64 expected = gaps * prob;
+			const float64 d = counts[r] - expected;
+			chi2 += d * d / expected;
+			tail *= 1.0 - p;
+		}
+		return ChiSquareP(chi2, GAP_BINS - 1);
+	}
+
+	/// Ones in each bit position, the 32 normalized excesses squared sum
+	/// to a chi-square with 32 degrees of freedom
+	float64 BitTest(jlFillFunc fill, uint32 *buffer, int32 batches) {
+		int64 ones[32];
+		memset(ones, 0, sizeof(ones));
+		for (int32 b = 0; b < batches; ++b) {
+			fill(buffer, BATCH_SIZE);
+			for (int32 i = 0; i < BATCH_SIZE; ++i) {
+				const uint32 x = buffer[i];
+				for (int32 bit = 0; bit < 32; ++bit) {
+					ones[bit] += (x >> bit) & 1;
+				}
+			}
+		}
+		const float64 n = static_cast<float64>(batches) * BATCH_SIZE;
+		float64 chi2 = 0.0;
+		for (int32 bit = 0; bit < 32; ++bit) {
+			const float64 z = (2.0 * ones[bit] - n) / sqrt(n);
+			chi2 += z * z;
+		}
+		return ChiSquareP(chi2, 32);
+	}
+
+	float64 Throughput(jlFillFunc fill, uint32 *buffer) {
+		fill(buffer, BATCH_SIZE);
+		jlTimer timer;
+		timer.start();
+		for (int32 b = 0; b < THROUGHPUT_BATCHES; ++b) {
+			fill(buffer, BATCH_SIZE);
+		}
+		const float64 bytes = static_cast<float64>(THROUGHPUT_BATCHES) * BATCH_SIZE * sizeof(uint32);
+		return bytes / timer.getElapsedSeconds() * 1.0e-9;
+	}
+
+	jlRandom sfmt;
+	jlRandom sfmtDouble;
+	jlCounterRandom philox;
+	jlFastRandom xoshiro;
+	uint32 lcg;
+
+	template <class R>
+	void DrawEach(R& random, uint32 *out, int32 count) {
+		for (int32 i = 0; i < count; ++i) {
+			out[i] = random.randUint32();
+		}
+	}
+
+	void SeedSfmt(uint64 seed) { sfmt.seed(static_cast<uint32>(seed)); }
+	void SeedSfmtDouble(uint64 seed) { sfmtDouble.seed(static_cast<uint32>(seed)); }
+	void SeedPhilox(uint64 seed) { philox.seed(seed); }
+	void SeedXoshiro(uint64 seed) { xoshiro.seed(seed); }
+	void SeedLcg(uint64 seed) { lcg = static_cast<uint32>(seed); }
+
+	void SfmtEach(uint32 *out, int32 count) { DrawEach(sfmt, out, count); }
+	void SfmtFill(uint32 *out, int32 count) { sfmt.fillUint32(out, count); }
+	void SfmtDoubleEach(uint32 *out, int32 count) { DrawEach(sfmtDouble, out, count); }
+	void PhiloxEach(uint32 *out, int32 count) { DrawEach(philox, out, count); }
+	void PhiloxFill(uint32 *out, int32 count) { philox.fillUint32(out, count); }
+	void XoshiroEach(uint32 *out, int32 count) { DrawEach(xoshiro, out, count); }
+	void XoshiroFill(uint32 *out, int32 count) { xoshiro.fillUint32(out, count); }
+
+	/// Numerical Recipes' 32 bit LCG, its spacings are far too regular
+	void LcgEach(uint32 *out, int32 count) {
+		for (int32 i = 0; i < count; ++i) {
+			lcg = 1664525U * lcg + 1013904223U;
+			out[i] = lcg;
+		}
+	}
+
+	const jlGeneratorCase GENERATOR_CASES[] = {
+		{ "jlRandom randUint32",        SeedSfmt,       SfmtEach,       false },
+		{ "jlRandom fillUint32",        SeedSfmt,       SfmtFill,       false },
+		{ "jlRandom double buffered",   SeedSfmtDouble, SfmtDoubleEach, false },
+		{ "jlCounterRandom randUint32", SeedPhilox,     PhiloxEach,     false },
+		{ "jlCounterRandom fillUint32", SeedPhilox,     PhiloxFill,     false },
+		{ "jlFastRandom randUint32",    SeedXoshiro,    XoshiroEach,    false },
+		{ "jlFastRandom fillUint32",    SeedXoshiro,    XoshiroFill,    false },
+		{ "LCG (control)",              SeedLcg,        LcgEach,        true }
+	};
+}
+
+int main(int argc, char *argv[]) {
+	const int32 batches = (argc > 1 && strcmp(argv[1], "-large") == 0) ? DEFAULT_BATCHES * LARGE_SCALE : DEFAULT_BATCHES;
+	uint32 *buffer = static_cast<uint32 *>(jlAllocAligned(BATCH_SIZE * sizeof(uint32), 16));
+	sfmt.init(1024);
+	sfmtDouble.init(1024);
+	sfmtDouble.setDoubleBuffered(true);
+	int32 failures = 0;
+	int32 numCases = sizeof(GENERATOR_CASES) / sizeof(GENERATOR_CASES[0]);
+	printf("%lld draws per test, p-values outside [%g, %g] fail\n",
+		static_cast<int64>(batches) * BATCH_SIZE, P_FAIL, 1.0 - P_FAIL);
+	printf("%-28s", "generator");
+	for (int32 t = 0; t < NUM_TESTS; ++t) {
+		printf(" %9s", TEST_NAMES[t]);
+	}
+	printf(" %8s\n", "GB/s");
+	for (int32 c = 0; c < numCases; ++c) {
+		const jlGeneratorCase& gc = GENERATOR_CASES[c];
+		gc.seed(SEED);
+		float64 p[NUM_TESTS];
+		p[0] = BucketTest(gc.fill, buffer, batches);
+		p[1] = SerialTest(gc.fill, buffer, batches);
+		p[2] = BirthdayTest(gc.fill, buffer, batches);
+		p[3] = GapTest(gc.fill, buffer, batches);
+		p[4] = BitTest(gc.fill, buffer, batches);
+		float64 gbs = Throughput(gc.fill, buffer);
+		bool8 passed = true;
+		printf("%-28s", gc.name);
+		for (int32 t = 0; t < NUM_TESTS; ++t) {
+			const bool8 ok = p[t] >= P_FAIL && p[t] <= 1.0 - P_FAIL;
+			if (!ok) passed = false;
+			printf(" %8.4f%c", p[t], ok ? ' ' : '*');
+		}
+		printf(" %8.2f %s\n", gbs, passed ? "ok" : (gc.control ? "FAIL (expected)" : "FAIL"));
+		if (!passed && !gc.control) ++failures;
+	}
+	jlFreeAligned(buffer);
+	printf("%d generators failed\n", failures);
+	return (failures > 0) ? 1 : 0;
+}
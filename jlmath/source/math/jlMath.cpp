@@ -1,51 +1,80 @@
 #include "math/jlMath.h"
+#include "math/jlTrigTable.h"
 
-const float32 jlMath::PI = jlMath::ATan(1.0f) * 4.0f;
-const float32 jlMath::TWO_PI = PI * 2.0f;
-const float32 jlMath::PI_OVER_TWO = PI * 0.5f;
-const float32 jlMath::PI_OVER_FOUR = PI * 0.25f;
-const float32 jlMath::ONE_OVER_PI = 1.0f / PI;
-const float32 jlMath::ONE_OVER_TWO_PI = 1.0f / TWO_PI;
-const float32 jlMath::DEG2RAD = PI / 180.0f;
-const float32 jlMath::RAD2DEG = 180.0f / PI;
-const float32 jlMath::LOG2 = log(2.0f);
-const int32 jlMath::DEFAULT_TRIG_TABLE_SIZE = 4096;
-
-#if JL_MATH_TRIG_TABLES
-float32 * jlMath::sinTable = TBD_NULL;
-float32 * jlMath::tanTable = TBD_NULL;
-int32 jlMath::trigTableSize = 0;
-float32 jlMath::trigTableFactor = 0.0f;
+// literal values keep these out of dynamic initialization
+#if JL_CONSTEXPR_ENABLED
+constexpr float32 jlMath::PI;
+constexpr float32 jlMath::TWO_PI;
+constexpr float32 jlMath::PI_OVER_TWO;
+constexpr float32 jlMath::PI_OVER_FOUR;
+constexpr float32 jlMath::ONE_OVER_PI;
+constexpr float32 jlMath::ONE_OVER_TWO_PI;
+constexpr float32 jlMath::DEG2RAD;
+constexpr float32 jlMath::RAD2DEG;
+constexpr float32 jlMath::LOG2;
+#else
+const float32 jlMath::PI = 3.14159265358979323846f;
+const float32 jlMath::TWO_PI = 6.28318530717958647692f;
+const float32 jlMath::PI_OVER_TWO = 1.57079632679489661923f;
+const float32 jlMath::PI_OVER_FOUR = 0.785398163397448309616f;
+const float32 jlMath::ONE_OVER_PI = 0.318309886183790671538f;
+const float32 jlMath::ONE_OVER_TWO_PI = 0.159154943091895335769f;
+const float32 jlMath::DEG2RAD = 0.0174532925199432957692f;
+const float32 jlMath::RAD2DEG = 57.2957795130823208768f;
+const float32 jlMath::LOG2 = 0.693147180559945309417f;
 #endif
+const int32 jlMath::DEFAULT_TRIG_TABLE_SIZE = jlTrigTable::DEFAULT_SIZE;
 
+/// Builds the shared table now instead of on the first lookup
+/// Fails if another caller already built it with a different size
 jlResult jlMath::SetupTrigTables(int32 tableSize) {
-	#if JL_MATH_TRIG_TABLES
-	TBD_ASSERT_MSG(tableSize > 0, "Can't have a negative trig table size!");
-	trigTableSize = tableSize;
-	if (tableSize) {
-		trigTableFactor = tableSize / TWO_PI;
-		sinTable = new float32[tableSize];
-		tanTable = new float32[tableSize];
-
-		float32 angle;
-		int32 i;
-		for (i = 0; i < tableSize; ++i) {
-			angle = TWO_PI * i / tableSize;
-			sinTable[i] = Sin(angle);
-			tanTable[i] = Tan(angle);
-		}
-	}
-	#else
-	JL_UNREFERENCED(tableSize);
-	#endif
-	return JL_OK;
+	return (jlTrigTable::GetDefault(tableSize).getSize() == tableSize) ? JL_OK : JL_ERROR;
 }
 
+/// The shared table lives until exit so lookups on other threads stay valid
 jlResult jlMath::UnloadTrigTables() {
-	#if JL_MATH_TRIG_TABLES
-	TBD_SAFE_DELETE_ARRAY(sinTable)
-	TBD_SAFE_DELETE_ARRAY(tanTable)
-	trigTableSize = 0;
-	#endif
 	return JL_OK;
 }
+
+float32 jlMath::Cos(float32 x, bool8 useTable) {
+	if (useTable) {
+		return jlTrigTable::GetDefault().cos(x);
+	}
+	return Cos(x);
+}
+
+float32 jlMath::Sin(float32 x, bool8 useTable) {
+	if (useTable) {
+		return jlTrigTable::GetDefault().sin(x);
+	}
+	return Sin(x);
+}
+
+float32 jlMath::Tan(float32 x, bool8 useTable) {
+	if (useTable) {
+		const jlTrigTable& table = jlTrigTable::GetDefault();
+		return table.sin(x) / table.cos(x);
+	}
+	return Tan(x);
+}
+
+#if JL_SIMD_ENABLED
+/// Slow path of SinCosInternal for lanes the Cody-Waite reduction can't handle
+void jlMath::SinCosLargeInternal(const quad128& x, const quad128& lanes, quad128 *s, quad128 *c) {
+	JL_ALIGN_16 float32 xv[4];
+	JL_ALIGN_16 float32 sv[4];
+	JL_ALIGN_16 float32 cv[4];
+	int32 mask = _mm_movemask_ps(lanes);
+	_mm_store_ps(xv, x);
+	_mm_store_ps(sv, *s);
+	_mm_store_ps(cv, *c);
+	for (int32 i = 0; i < 4; ++i) {
+		if (mask & (1 << i)) {
+			sv[i] = static_cast<float32>(sin(static_cast<float64>(xv[i])));
+			cv[i] = static_cast<float32>(cos(static_cast<float64>(xv[i])));
+		}
+	}
+	*s = _mm_load_ps(sv);
+	*c = _mm_load_ps(cv);
+}
+#endif
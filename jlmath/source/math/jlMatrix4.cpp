@@ -1,5 +1,16 @@
 #include "math/jlMatrix4.h"
 
-const jlMatrix4 jlMatrix4::ZERO(jlVector4::ZERO, jlVector4::ZERO, jlVector4::ZERO, jlVector4::ZERO);
-const jlMatrix4 jlMatrix4::IDENTITY(jlVector4::UNIT_X, jlVector4::UNIT_Y, jlVector4::UNIT_Y, jlVector4::ZERO_PT);
-const jlMatrix4 jlMatrix4::NEG_IDENTITY(jlVector4::NEG_UNIT_X, jlVector4::NEG_UNIT_Y, jlVector4::NEG_UNIT_Z, -jlVector4::ZERO_PT);
+// built from literals rather than the jlVector4 statics, which live in 
+// another translation unit and may not be initialized yet
+const jlMatrix4 jlMatrix4::ZERO(0.0f, 0.0f, 0.0f, 0.0f, 
+								0.0f, 0.0f, 0.0f, 0.0f, 
+								0.0f, 0.0f, 0.0f, 0.0f, 
+								0.0f, 0.0f, 0.0f, 0.0f);
+const jlMatrix4 jlMatrix4::IDENTITY(1.0f, 0.0f, 0.0f, 0.0f, 
+									0.0f, 1.0f, 0.0f, 0.0f, 
+									0.0f, 0.0f, 1.0f, 0.0f, 
+									0.0f, 0.0f, 0.0f, 1.0f);
+const jlMatrix4 jlMatrix4::NEG_IDENTITY(-1.0f, 0.0f, 0.0f, 0.0f, 
+										0.0f, -1.0f, 0.0f, 0.0f, 
+										0.0f, 0.0f, -1.0f, 0.0f, 
+										0.0f, 0.0f, 0.0f, -1.0f);
@@ -0,0 +1,679 @@
+#include "math/jlNoise.h"
+#include "util/jlRandom.h"
+#include "util/jlDistribution.h"
+
+namespace {
+	// simplex skew/unskew factors, (sqrt(n + 1) - 1) / n and (n + 1 - sqrt(n + 1)) / (n (n + 1))
+	const float32 F2 = 0.366025403784438647f;
+	const float32 G2 = 0.211324865405187118f;
+	const float32 F3 = 1.0f / 3.0f;
+	const float32 G3 = 1.0f / 6.0f;
+	const float32 F4 = 0.309016994374947424f;
+	const float32 G4 = 0.138196601125010515f;
+
+	const float32 GRAD2[8][2] = {
+		{ 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 },
+		{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }
+	};
+
+	// the 12 cube edges, 4 of them repeated so a hash can be masked with 15
+	const float32 GRAD3[16][3] = {
+		{ 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+		{ 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+		{ 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 },
+		{ 1, 1, 0 }, { 0, -1, 1 }, { -1, 1, 0 }, { 0, -1, -1 }
+	};
+
+	// the 32 edges of a tesseract
+	const float32 GRAD4[32][4] = {
+		{ 0, 1, 1, 1 }, { 0, 1, 1, -1 }, { 0, 1, -1, 1 }, { 0, 1, -1, -1 },
+		{ 0, -1, 1, 1 }, { 0, -1, 1, -1 }, { 0, -1, -1, 1 }, { 0, -1, -1, -1 },
+		{ 1, 0, 1, 1 }, { 1, 0, 1, -1 }, { 1, 0, -1, 1 }, { 1, 0, -1, -1 },
+		{ -1, 0, 1, 1 }, { -1, 0, 1, -1 }, { -1, 0, -1, 1 }, { -1, 0, -1, -1 },
+		{ 1, 1, 0, 1 }, { 1, 1, 0, -1 }, { 1, -1, 0, 1 }, { 1, -1, 0, -1 },
+		{ -1, 1, 0, 1 }, { -1, 1, 0, -1 }, { -1, -1, 0, 1 }, { -1, -1, 0, -1 },
+		{ 1, 1, 1, 0 }, { 1, 1, -1, 0 }, { 1, -1, 1, 0 }, { 1, -1, -1, 0 },
+		{ -1, 1, 1, 0 }, { -1, 1, -1, 0 }, { -1, -1, 1, 0 }, { -1, -1, -1, 0 }
+	};
+
+	JL_FORCE_INLINE jlVector4 Splat(float32 f) {
+		return jlVector4(f, f, f, f);
+	}
+
+	/// 1 in the lanes set in c, 0 elsewhere
+	JL_FORCE_INLINE jlVector4 Indicator(const jlComp& c) {
+		jlVector4 r = jlVector4::ONE;
+		r.splice(c.getCompMask());
+		return r;
+	}
+
+	/// 6t^5 - 15t^4 + 10t^3, zero first and second derivatives at 0 and 1
+	JL_FORCE_INLINE jlVector4 Fade(const jlVector4& t) {
+		return t * t * t * (t * (t * Splat(6.0f) - Splat(15.0f)) + Splat(10.0f));
+	}
+
+	JL_FORCE_INLINE jlVector4 Mix(const jlVector4& a, const jlVector4& b, const jlVector4& t) {
+		return a + (b - a) * t;
+	}
+
+	/// Lattice cell of each lane wrapped to the permutation table
+	JL_FORCE_INLINE void LatticeCells(const jlVector4& f, int32 *cells) {
+		for (int32 l = 0; l < 4; ++l) {
+			cells[l] = static_cast<int32>(f(l)) & 255;
+		}
+	}
+
+	/// Integer value of 0/1 indicator lanes, used as lattice offsets
+	JL_FORCE_INLINE void LatticeOffsets(const jlVector4& o, int32 *offsets) {
+		for (int32 l = 0; l < 4; ++l) {
+			offsets[l] = static_cast<int32>(o(l));
+		}
+	}
+
+	// gradient dot offset for each lane, h holds one hash per lane
+	JL_FORCE_INLINE jlVector4 Grad(const int32 *h, const jlVector4& x, const jlVector4& y) {
+		const float32 *g0 = GRAD2[h[0] & 7], *g1 = GRAD2[h[1] & 7], *g2 = GRAD2[h[2] & 7], *g3 = GRAD2[h[3] & 7];
+		return jlVector4(g0[0], g1[0], g2[0], g3[0]) * x + jlVector4(g0[1], g1[1], g2[1], g3[1]) * y;
+	}
+
+	JL_FORCE_INLINE jlVector4 Grad(const int32 *h, const jlVector4& x, const jlVector4& y, const jlVector4& z) {
+		const float32 *g0 = GRAD3[h[0] & 15], *g1 = GRAD3[h[1] & 15], *g2 = GRAD3[h[2] & 15], *g3 = GRAD3[h[3] & 15];
+		return jlVector4(g0[0], g1[0], g2[0], g3[0]) * x + jlVector4(g0[1], g1[1], g2[1], g3[1]) * y +
+			jlVector4(g0[2], g1[2], g2[2], g3[2]) * z;
+	}
+
+	JL_FORCE_INLINE jlVector4 Grad(const int32 *h, const jlVector4& x, const jlVector4& y, const jlVector4& z, const jlVector4& w) {
+		const float32 *g0 = GRAD4[h[0] & 31], *g1 = GRAD4[h[1] & 31], *g2 = GRAD4[h[2] & 31], *g3 = GRAD4[h[3] & 31];
+		return jlVector4(g0[0], g1[0], g2[0], g3[0]) * x + jlVector4(g0[1], g1[1], g2[1], g3[1]) * y +
+			jlVector4(g0[2], g1[2], g2[2], g3[2]) * z + jlVector4(g0[3], g1[3], g2[3], g3[3]) * w;
+	}
+
+	/// Radial falloff (r^2 - d^2)^4 of one simplex corner, zero outside the radius
+	JL_FORCE_INLINE jlVector4 Falloff(const jlVector4& radiusSquared, const jlVector4& distanceSquared) {
+		jlVector4 t;
+		t.setMax(radiusSquared - distanceSquared, jlVector4::ZERO);
+		t = t * t;
+		return t * t;
+	}
+}
+
+#if (JL_AVX2_ENABLED) // eight point versions for the grid fills
+namespace {
+	/// Same arithmetic in the same order as the jlVector4 versions, so the
+	/// grid fills give the same values whichever width produced them
+	JL_FORCE_INLINE quad256 Splat8(float32 f) {
+		return _mm256_set1_ps(f);
+	}
+
+	/// perm[i] of each lane, perm is padded so the 4 byte read at 511 stays inside
+	JL_FORCE_INLINE quadint256 Perm8(const uint8 *perm, const quadint256& i) {
+		return _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int *>(perm), i, 1), _mm256_set1_epi32(255));
+	}
+
+	JL_FORCE_INLINE quadint256 Cells8(const quad256& f) {
+		return _mm256_and_si256(_mm256_cvttps_epi32(f), _mm256_set1_epi32(255));
+	}
+
+	JL_FORCE_INLINE quad256 Indicator8(const quad256& mask) {
+		return _mm256_and_ps(mask, Splat8(1.0f));
+	}
+
+	JL_FORCE_INLINE quad256 Fade8(const quad256& t) {
+		quad256 p = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, Splat8(6.0f)), Splat8(15.0f))), Splat8(10.0f));
+		return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), p);
+	}
+
+	JL_FORCE_INLINE quad256 Mix8(const quad256& a, const quad256& b, const quad256& t) {
+		return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+	}
+
+	JL_FORCE_INLINE quad256 Grad8(const quadint256& h, const quad256& x, const quad256& y) {
+		const quadint256 row = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(7)), 1);
+		return _mm256_add_ps(_mm256_mul_ps(_mm256_i32gather_ps(&GRAD2[0][0], row, 4), x),
+			_mm256_mul_ps(_mm256_i32gather_ps(&GRAD2[0][1], row, 4), y));
+	}
+
+	JL_FORCE_INLINE quad256 Grad8(const quadint256& h, const quad256& x, const quad256& y, const quad256& z) {
+		const quadint256 row = _mm256_mullo_epi32(_mm256_and_si256(h, _mm256_set1_epi32(15)), _mm256_set1_epi32(3));
+		quad256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_i32gather_ps(&GRAD3[0][0], row, 4), x),
+			_mm256_mul_ps(_mm256_i32gather_ps(&GRAD3[0][1], row, 4), y));
+		return _mm256_add_ps(r, _mm256_mul_ps(_mm256_i32gather_ps(&GRAD3[0][2], row, 4), z));
+	}
+
+	JL_FORCE_INLINE quad256 Falloff8(const quad256& radiusSquared, const quad256& distanceSquared) {
+		quad256 t = _mm256_max_ps(_mm256_sub_ps(radiusSquared, distanceSquared), _mm256_setzero_ps());
+		t = _mm256_mul_ps(t, t);
+		return _mm256_mul_ps(t, t);
+	}
+
+	quad256 Perlin8(const uint8 *perm, const quad256& x, const quad256& y) {
+		const quadint256 one = _mm256_set1_epi32(1);
+		quad256 fx = _mm256_floor_ps(x), fy = _mm256_floor_ps(y);
+		quad256 x0 = _mm256_sub_ps(x, fx), y0 = _mm256_sub_ps(y, fy);
+		quad256 x1 = _mm256_sub_ps(x0, Splat8(1.0f)), y1 = _mm256_sub_ps(y0, Splat8(1.0f));
+		quadint256 cx = Cells8(fx), cy = Cells8(fy);
+		quadint256 a = Perm8(perm, cx), b = Perm8(perm, _mm256_add_epi32(cx, one));
+		quadint256 cy1 = _mm256_add_epi32(cy, one);
+		quadint256 h0 = Perm8(perm, _mm256_add_epi32(a, cy)), h1 = Perm8(perm, _mm256_add_epi32(b, cy));
+		quadint256 h2 = Perm8(perm, _mm256_add_epi32(a, cy1)), h3 = Perm8(perm, _mm256_add_epi32(b, cy1));
+		quad256 u = Fade8(x0);
+		quad256 n0 = Mix8(Grad8(h0, x0, y0), Grad8(h1, x1, y0), u);
+		quad256 n1 = Mix8(Grad8(h2, x0, y1), Grad8(h3, x1, y1), u);
+		return Mix8(n0, n1, Fade8(y0));
+	}
+
+	quad256 Perlin8(const uint8 *perm, const quad256& x, const quad256& y, const quad256& z) {
+		quad256 f[3] = { _mm256_floor_ps(x), _mm256_floor_ps(y), _mm256_floor_ps(z) };
+		quad256 d0[3] = { _mm256_sub_ps(x, f[0]), _mm256_sub_ps(y, f[1]), _mm256_sub_ps(z, f[2]) };
+		quad256 d1[3];
+		quadint256 cells[3];
+		for (int32 a = 0; a < 3; ++a) {
+			d1[a] = _mm256_sub_ps(d0[a], Splat8(1.0f));
+			cells[a] = Cells8(f[a]);
+		}
+		quad256 n[8];
+		for (int32 c = 0; c < 8; ++c) {
+			quadint256 h = Perm8(perm, _mm256_add_epi32(cells[0], _mm256_set1_epi32(c & 1)));
+			h = Perm8(perm, _mm256_add_epi32(_mm256_add_epi32(h, cells[1]), _mm256_set1_epi32((c >> 1) & 1)));
+			h = Perm8(perm, _mm256_add_epi32(_mm256_add_epi32(h, cells[2]), _mm256_set1_epi32(c >> 2)));
+			n[c] = Grad8(h, (c & 1) ? d1[0] : d0[0], (c & 2) ? d1[1] : d0[1], (c & 4) ? d1[2] : d0[2]);
+		}
+		quad256 u = Fade8(d0[0]), v = Fade8(d0[1]);
+		quad256 n00 = Mix8(Mix8(n[0], n[1], u), Mix8(n[2], n[3], u), v);
+		quad256 n01 = Mix8(Mix8(n[4], n[5], u), Mix8(n[6], n[7], u), v);
+		return Mix8(n00, n01, Fade8(d0[2]));
+	}
+
+	quad256 Simplex8(const uint8 *perm, const quad256& x, const quad256& y) {
+		const quadint256 one = _mm256_set1_epi32(1);
+		quad256 s = _mm256_mul_ps(_mm256_add_ps(x, y), Splat8(F2));
+		quad256 i = _mm256_floor_ps(_mm256_add_ps(x, s));
+		quad256 j = _mm256_floor_ps(_mm256_add_ps(y, s));
+		quad256 t = _mm256_mul_ps(_mm256_add_ps(i, j), Splat8(G2));
+		quad256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(i, t)), y0 = _mm256_sub_ps(y, _mm256_sub_ps(j, t));
+		quad256 i1 = Indicator8(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ));
+		quad256 j1 = _mm256_sub_ps(Splat8(1.0f), i1);
+		quad256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, i1), Splat8(G2)), y1 = _mm256_add_ps(_mm256_sub_ps(y0, j1), Splat8(G2));
+		quad256 x2 = _mm256_add_ps(x0, Splat8(2.0f * G2 - 1.0f)), y2 = _mm256_add_ps(y0, Splat8(2.0f * G2 - 1.0f));
+		quadint256 ci = Cells8(i), cj = Cells8(j);
+		quadint256 oi = _mm256_cvttps_epi32(i1), oj = _mm256_cvttps_epi32(j1);
+		quadint256 h0 = Perm8(perm, _mm256_add_epi32(Perm8(perm, ci), cj));
+		quadint256 h1 = Perm8(perm, _mm256_add_epi32(Perm8(perm, _mm256_add_epi32(ci, oi)), _mm256_add_epi32(cj, oj)));
+		quadint256 h2 = Perm8(perm, _mm256_add_epi32(Perm8(perm, _mm256_add_epi32(ci, one)), _mm256_add_epi32(cj, one)));
+		const quad256 r2 = Splat8(0.5f);
+		quad256 n = _mm256_mul_ps(Falloff8(r2, _mm256_add_ps(_mm256_mul_ps(x0, x0), _mm256_mul_ps(y0, y0))), Grad8(h0, x0, y0));
+		n = _mm256_add_ps(n, _mm256_mul_ps(Falloff8(r2, _mm256_add_ps(_mm256_mul_ps(x1, x1), _mm256_mul_ps(y1, y1))), Grad8(h1, x1, y1)));
+		n = _mm256_add_ps(n, _mm256_mul_ps(Falloff8(r2, _mm256_add_ps(_mm256_mul_ps(x2, x2), _mm256_mul_ps(y2, y2))), Grad8(h2, x2, y2)));
+		return _mm256_mul_ps(n, Splat8(70.0f));
+	}
+
+	quad256 Simplex8(const uint8 *perm, const quad256& x, const quad256& y, const quad256& z) {
+		const quad256 one = Splat8(1.0f);
+		quad256 s = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), Splat8(F3));
+		quad256 cell[3] = { _mm256_floor_ps(_mm256_add_ps(x, s)), _mm256_floor_ps(_mm256_add_ps(y, s)), _mm256_floor_ps(_mm256_add_ps(z, s)) };
+		quad256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(cell[0], cell[1]), cell[2]), Splat8(G3));
+		quad256 d0[3] = { _mm256_sub_ps(x, _mm256_sub_ps(cell[0], t)), _mm256_sub_ps(y, _mm256_sub_ps(cell[1], t)), _mm256_sub_ps(z, _mm256_sub_ps(cell[2], t)) };
+		quad256 cxy = Indicator8(_mm256_cmp_ps(d0[0], d0[1], _CMP_GT_OQ));
+		quad256 cxz = Indicator8(_mm256_cmp_ps(d0[0], d0[2], _CMP_GT_OQ));
+		quad256 cyz = Indicator8(_mm256_cmp_ps(d0[1], d0[2], _CMP_GT_OQ));
+		quad256 rank[3] = {
+			_mm256_add_ps(cxy, cxz),
+			_mm256_add_ps(_mm256_sub_ps(one, cxy), cyz),
+			_mm256_add_ps(_mm256_sub_ps(one, cxz), _mm256_sub_ps(one, cyz))
+		};
+		// corner 1 steps along the largest axis, corner 2 the two largest
+		quad256 d[4][3];
+		quadint256 cells[3], offsets[2][3];
+		for (int32 a = 0; a < 3; ++a) {
+			d[0][a] = d0[a];
+			cells[a] = Cells8(cell[a]);
+			for (int32 c = 1; c <= 2; ++c) {
+				quad256 o = Indicator8(_mm256_cmp_ps(rank[a], Splat8(c == 1 ? 1.5f : 0.5f), _CMP_GT_OQ));
+				d[c][a] = _mm256_add_ps(_mm256_sub_ps(d0[a], o), Splat8(c * G3));
+				offsets[c - 1][a] = _mm256_cvttps_epi32(o);
+			}
+			d[3][a] = _mm256_add_ps(d0[a], Splat8(3.0f * G3 - 1.0f));
+		}
+		const quad256 r2 = Splat8(0.5f);
+		quad256 n = _mm256_setzero_ps();
+		for (int32 c = 0; c < 4; ++c) {
+			quadint256 h = _mm256_setzero_si256();
+			for (int32 a = 0; a < 3; ++a) {
+				quadint256 o = (c == 0) ? _mm256_setzero_si256() : (c == 3) ? _mm256_set1_epi32(1) : offsets[c - 1][a];
+				h = Perm8(perm, _mm256_add_epi32(_mm256_add_epi32(h, cells[a]), o));
+			}
+			quad256 distanceSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d[c][0], d[c][0]), _mm256_mul_ps(d[c][1], d[c][1])), _mm256_mul_ps(d[c][2], d[c][2]));
+			quad256 contribution = _mm256_mul_ps(Falloff8(r2, distanceSquared), Grad8(h, d[c][0], d[c][1], d[c][2]));
+			n = (c == 0) ? contribution : _mm256_add_ps(n, contribution);
+		}
+		return _mm256_mul_ps(n, Splat8(76.0f));
+	}
+
+	quad256 Fbm8(const uint8 *perm, jlNoise::Type type, const quad256& x, const quad256& y, int32 octaves, float32 lacunarity, float32 gain) {
+		quad256 sum = _mm256_setzero_ps();
+		float32 frequency = 1.0f, amplitude = 1.0f;
+		for (int32 o = 0; o < octaves; ++o) {
+			const quad256 f = Splat8(frequency);
+			const quad256 fx = _mm256_mul_ps(x, f), fy = _mm256_mul_ps(y, f);
+			quad256 n = (type == jlNoise::TYPE_SIMPLEX) ? Simplex8(perm, fx, fy) : Perlin8(perm, fx, fy);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(n, Splat8(amplitude)));
+			frequency *= lacunarity;
+			amplitude *= gain;
+		}
+		return sum;
+	}
+
+	quad256 Fbm8(const uint8 *perm, jlNoise::Type type, const quad256& x, const quad256& y, const quad256& z, int32 octaves, float32 lacunarity, float32 gain) {
+		quad256 sum = _mm256_setzero_ps();
+		float32 frequency = 1.0f, amplitude = 1.0f;
+		for (int32 o = 0; o < octaves; ++o) {
+			const quad256 f = Splat8(frequency);
+			const quad256 fx = _mm256_mul_ps(x, f), fy = _mm256_mul_ps(y, f), fz = _mm256_mul_ps(z, f);
+			quad256 n = (type == jlNoise::TYPE_SIMPLEX) ? Simplex8(perm, fx, fy, fz) : Perlin8(perm, fx, fy, fz);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(n, Splat8(amplitude)));
+			frequency *= lacunarity;
+			amplitude *= gain;
+		}
+		return sum;
+	}
+}
+#endif
+
+jlNoise::jlNoise() {
+	seed(jlRandom::DEFAULT_SEED);
+}
+
+/// Unbiased shuffle of 0..255, then doubled
+void jlNoise::seed(jlRandom& random) {
+	JL_ASSERT(random.isInit());
+	for (int32 i = 0; i < 256; ++i) {
+		perm[i] = static_cast<uint8>(i);
+	}
+	jlDistribution::Shuffle(random, perm, 256);
+	for (int32 i = 0; i < 256; ++i) {
+		perm[i + 256] = perm[i];
+	}
+	for (int32 i = 512; i < PERM_SIZE; ++i) {
+		perm[i] = 0;
+	}
+}
+
+void jlNoise::seed(uint32 s) {
+	jlRandom random;
+	random.init(jlRandom::STATE_SIZE);
+	random.seed(s);
+	seed(random);
+}
+
+jlVector4 jlNoise::perlin(const jlVector4& x, const jlVector4& y) const {
+	jlVector4 fx = jlMath::Floor(x);
+	jlVector4 fy = jlMath::Floor(y);
+	jlVector4 x0 = x - fx, y0 = y - fy;
+	jlVector4 x1 = x0 - jlVector4::ONE, y1 = y0 - jlVector4::ONE;
+	int32 cx[4], cy[4];
+	LatticeCells(fx, cx);
+	LatticeCells(fy, cy);
+	// corner c is offset by bit 0 in x and bit 1 in y
+	int32 h[4][4];
+	for (int32 l = 0; l < 4; ++l) {
+		for (int32 c = 0; c < 4; ++c) {
+			h[c][l] = perm[perm[cx[l] + (c & 1)] + cy[l] + (c >> 1)];
+		}
+	}
+	jlVector4 u = Fade(x0);
+	jlVector4 n0 = Mix(Grad(h[0], x0, y0), Grad(h[1], x1, y0), u);
+	jlVector4 n1 = Mix(Grad(h[2], x0, y1), Grad(h[3], x1, y1), u);
+	return Mix(n0, n1, Fade(y0));
+}
+
+jlVector4 jlNoise::perlin(const jlVector4& x, const jlVector4& y, const jlVector4& z) const {
+	jlVector4 fx = jlMath::Floor(x);
+	jlVector4 fy = jlMath::Floor(y);
+	jlVector4 fz = jlMath::Floor(z);
+	jlVector4 d0[3] = { x - fx, y - fy, z - fz };
+	jlVector4 d1[3] = { d0[0] - jlVector4::ONE, d0[1] - jlVector4::ONE, d0[2] - jlVector4::ONE };
+	int32 cx[4], cy[4], cz[4];
+	LatticeCells(fx, cx);
+	LatticeCells(fy, cy);
+	LatticeCells(fz, cz);
+	int32 h[8][4];
+	for (int32 l = 0; l < 4; ++l) {
+		for (int32 c = 0; c < 8; ++c) {
+			h[c][l] = perm[perm[perm[cx[l] + (c & 1)] + cy[l] + ((c >> 1) & 1)] + cz[l] + (c >> 2)];
+		}
+	}
+	jlVector4 n[8];
+	for (int32 c = 0; c < 8; ++c) {
+		n[c] = Grad(h[c], (c & 1) ? d1[0] : d0[0], (c & 2) ? d1[1] : d0[1], (c & 4) ? d1[2] : d0[2]);
+	}
+	jlVector4 u = Fade(d0[0]), v = Fade(d0[1]);
+	jlVector4 n00 = Mix(Mix(n[0], n[1], u), Mix(n[2], n[3], u), v);
+	jlVector4 n01 = Mix(Mix(n[4], n[5], u), Mix(n[6], n[7], u), v);
+	return Mix(n00, n01, Fade(d0[2]));
+}
+
+jlVector4 jlNoise::perlin(const jlVector4& x, const jlVector4& y, const jlVector4& z, const jlVector4& w) const {
+	jlVector4 fx = jlMath::Floor(x);
+	jlVector4 fy = jlMath::Floor(y);
+	jlVector4 fz = jlMath::Floor(z);
+	jlVector4 fw = jlMath::Floor(w);
+	jlVector4 d0[4] = { x - fx, y - fy, z - fz, w - fw };
+	jlVector4 d1[4] = { d0[0] - jlVector4::ONE, d0[1] - jlVector4::ONE, d0[2] - jlVector4::ONE, d0[3] - jlVector4::ONE };
+	int32 cx[4], cy[4], cz[4], cw[4];
+	LatticeCells(fx, cx);
+	LatticeCells(fy, cy);
+	LatticeCells(fz, cz);
+	LatticeCells(fw, cw);
+	int32 h[16][4];
+	for (int32 l = 0; l < 4; ++l) {
+		for (int32 c = 0; c < 16; ++c) {
+			int32 hx = perm[cx[l] + (c & 1)];
+			int32 hy = perm[hx + cy[l] + ((c >> 1) & 1)];
+			int32 hz = perm[hy + cz[l] + ((c >> 2) & 1)];
+			h[c][l] = perm[hz + cw[l] + (c >> 3)];
+		}
+	}
+	jlVector4 n[16];
+	for (int32 c = 0; c < 16; ++c) {
+		n[c] = Grad(h[c], (c & 1) ? d1[0] : d0[0], (c & 2) ? d1[1] : d0[1], (c & 4) ? d1[2] : d0[2], (c & 8) ? d1[3] : d0[3]);
+	}
+	// collapse one axis at a time, pairs differ in the lowest remaining bit
+	jlVector4 fade[4] = { Fade(d0[0]), Fade(d0[1]), Fade(d0[2]), Fade(d0[3]) };
+	for (int32 axis = 0, count = 16; axis < 4; ++axis, count >>= 1) {
+		for (int32 c = 0; c < count; c += 2) {
+			n[c >> 1] = Mix(n[c], n[c + 1], fade[axis]);
+		}
+	}
+	return n[0];
+}
+
+/// Corners of the enclosing triangle are picked by which of x0, y0 is
+/// larger, each contributes (0.5 - d^2)^4 times its gradient.
+/// 70 scales the sum to about [-1, 1].
+jlVector4 jlNoise::simplex(const jlVector4& x, const jlVector4& y) const {
+	jlVector4 s = (x + y) * jlSimdFloat(F2);
+	jlVector4 i = jlMath::Floor(x + s);
+	jlVector4 j = jlMath::Floor(y + s);
+	jlVector4 t = (i + j) * jlSimdFloat(G2);
+	jlVector4 x0 = x - (i - t), y0 = y - (j - t);
+	jlVector4 i1 = Indicator(x0.compGreater(y0));
+	jlVector4 j1 = jlVector4::ONE - i1;
+	jlVector4 x1 = x0 - i1 + Splat(G2), y1 = y0 - j1 + Splat(G2);
+	jlVector4 x2 = x0 + Splat(2.0f * G2 - 1.0f), y2 = y0 + Splat(2.0f * G2 - 1.0f);
+	int32 ci[4], cj[4], oi[4], oj[4];
+	LatticeCells(i, ci);
+	LatticeCells(j, cj);
+	LatticeOffsets(i1, oi);
+	LatticeOffsets(j1, oj);
+	int32 h[3][4];
+	for (int32 l = 0; l < 4; ++l) {
+		h[0][l] = perm[perm[ci[l]] + cj[l]];
+		h[1][l] = perm[perm[ci[l] + oi[l]] + cj[l] + oj[l]];
+		h[2][l] = perm[perm[ci[l] + 1] + cj[l] + 1];
+	}
+	const jlVector4 r2 = Splat(0.5f);
+	jlVector4 n = Falloff(r2, x0 * x0 + y0 * y0) * Grad(h[0], x0, y0);
+	n += Falloff(r2, x1 * x1 + y1 * y1) * Grad(h[1], x1, y1);
+	n += Falloff(r2, x2 * x2 + y2 * y2) * Grad(h[2], x2, y2);
+	return n * jlSimdFloat(70.0f);
+}
+
+/// The simplex corners are ordered by ranking x0, y0, z0 against each
+/// other, every comparison adds one to exactly one rank so the ranks
+/// stay a permutation of 0..2 even with ties.  Radius^2 is 0.5 rather
+/// than the usual 0.6, which reaches past the neighbouring simplices and
+/// leaves small steps in the field.  76 scales the sum to about [-1, 1].
+jlVector4 jlNoise::simplex(const jlVector4& x, const jlVector4& y, const jlVector4& z) const {
+	jlVector4 s = (x + y + z) * jlSimdFloat(F3);
+	jlVector4 i = jlMath::Floor(x + s);
+	jlVector4 j = jlMath::Floor(y + s);
+	jlVector4 k = jlMath::Floor(z + s);
+	jlVector4 t = (i + j + k) * jlSimdFloat(G3);
+	jlVector4 x0 = x - (i - t), y0 = y - (j - t), z0 = z - (k - t);
+	jlVector4 cxy = Indicator(x0.compGreater(y0));
+	jlVector4 cxz = Indicator(x0.compGreater(z0));
+	jlVector4 cyz = Indicator(y0.compGreater(z0));
+	jlVector4 rx = cxy + cxz;
+	jlVector4 ry = (jlVector4::ONE - cxy) + cyz;
+	jlVector4 rz = (jlVector4::ONE - cxz) + (jlVector4::ONE - cyz);
+	const jlVector4 half = Splat(0.5f), oneHalf = Splat(1.5f);
+	jlVector4 i1 = Indicator(rx.compGreater(oneHalf)), i2 = Indicator(rx.compGreater(half));
+	jlVector4 j1 = Indicator(ry.compGreater(oneHalf)), j2 = Indicator(ry.compGreater(half));
+	jlVector4 k1 = Indicator(rz.compGreater(oneHalf)), k2 = Indicator(rz.compGreater(half));
+	jlVector4 x1 = x0 - i1 + Splat(G3), y1 = y0 - j1 + Splat(G3), z1 = z0 - k1 + Splat(G3);
+	jlVector4 x2 = x0 - i2 + Splat(2.0f * G3), y2 = y0 - j2 + Splat(2.0f * G3), z2 = z0 - k2 + Splat(2.0f * G3);
+	jlVector4 x3 = x0 + Splat(3.0f * G3 - 1.0f), y3 = y0 + Splat(3.0f * G3 - 1.0f), z3 = z0 + Splat(3.0f * G3 - 1.0f);
+	int32 ci[4], cj[4], ck[4], o1[3][4], o2[3][4];
+	LatticeCells(i, ci);
+	LatticeCells(j, cj);
+	LatticeCells(k, ck);
+	LatticeOffsets(i1, o1[0]);
+	LatticeOffsets(j1, o1[1]);
+	LatticeOffsets(k1, o1[2]);
+	LatticeOffsets(i2, o2[0]);
+	LatticeOffsets(j2, o2[1]);
+	LatticeOffsets(k2, o2[2]);
+	int32 h[4][4];
+	for (int32 l = 0; l < 4; ++l) {
+		h[0][l] = perm[perm[perm[ci[l]] + cj[l]] + ck[l]];
+		h[1][l] = perm[perm[perm[ci[l] + o1[0][l]] + cj[l] + o1[1][l]] + ck[l] + o1[2][l]];
+		h[2][l] = perm[perm[perm[ci[l] + o2[0][l]] + cj[l] + o2[1][l]] + ck[l] + o2[2][l]];
+		h[3][l] = perm[perm[perm[ci[l] + 1] + cj[l] + 1] + ck[l] + 1];
+	}
+	const jlVector4 r2 = Splat(0.5f);
+	jlVector4 n = Falloff(r2, x0 * x0 + y0 * y0 + z0 * z0) * Grad(h[0], x0, y0, z0);
+	n += Falloff(r2, x1 * x1 + y1 * y1 + z1 * z1) * Grad(h[1], x1, y1, z1);
+	n += Falloff(r2, x2 * x2 + y2 * y2 + z2 * z2) * Grad(h[2], x2, y2, z2);
+	n += Falloff(r2, x3 * x3 + y3 * y3 + z3 * z3) * Grad(h[3], x3, y3, z3);
+	return n * jlSimdFloat(76.0f);
+}
+
+/// Same ranking as 3D over the 6 pairs, radius^2 0.5, scale 62
+jlVector4 jlNoise::simplex(const jlVector4& x, const jlVector4& y, const jlVector4& z, const jlVector4& w) const {
+	jlVector4 s = (x + y + z + w) * jlSimdFloat(F4);
+	jlVector4 cell[4] = { jlMath::Floor(x + s), jlMath::Floor(y + s), jlMath::Floor(z + s), jlMath::Floor(w + s) };
+	jlVector4 t = (cell[0] + cell[1] + cell[2] + cell[3]) * jlSimdFloat(G4);
+	jlVector4 d0[4] = { x - (cell[0] - t), y - (cell[1] - t), z - (cell[2] - t), w - (cell[3] - t) };
+	jlVector4 rank[4] = { jlVector4::ZERO, jlVector4::ZERO, jlVector4::ZERO, jlVector4::ZERO };
+	for (int32 a = 0; a < 4; ++a) {
+		for (int32 b = a + 1; b < 4; ++b) {
+			jlVector4 c = Indicator(d0[a].compGreater(d0[b]));
+			rank[a] += c;
+			rank[b] += jlVector4::ONE - c;
+		}
+	}
+	// corner 1 steps along the largest axis, corner 2 the two largest and so on
+	jlVector4 d[5][4];
+	int32 cells[4][4], offsets[3][4][4];
+	for (int32 a = 0; a < 4; ++a) {
+		d[0][a] = d0[a];
+		LatticeCells(cell[a], cells[a]);
+		for (int32 c = 1; c <= 3; ++c) {
+			jlVector4 o = Indicator(rank[a].compGreater(Splat(3.5f - c)));
+			d[c][a] = d0[a] - o + Splat(c * G4);
+			LatticeOffsets(o, offsets[c - 1][a]);
+		}
+		d[4][a] = d0[a] + Splat(4.0f * G4 - 1.0f);
+	}
+	int32 h[5][4];
+	for (int32 l = 0; l < 4; ++l) {
+		for (int32 c = 0; c < 5; ++c) {
+			int32 hash = 0;
+			for (int32 a = 0; a < 4; ++a) {
+				int32 o = (c == 0) ? 0 : (c == 4) ? 1 : offsets[c - 1][a][l];
+				hash = perm[hash + cells[a][l] + o];
+			}
+			h[c][l] = hash;
+		}
+	}
+	const jlVector4 r2 = Splat(0.5f);
+	jlVector4 n = jlVector4::ZERO;
+	for (int32 c = 0; c < 5; ++c) {
+		jlVector4 distanceSquared = d[c][0] * d[c][0] + d[c][1] * d[c][1] + d[c][2] * d[c][2] + d[c][3] * d[c][3];
+		n += Falloff(r2, distanceSquared) * Grad(h[c], d[c][0], d[c][1], d[c][2], d[c][3]);
+	}
+	return n * jlSimdFloat(62.0f);
+}
+
+jlVector4 jlNoise::fbm(Type type, const jlVector4& x, const jlVector4& y, int32 octaves, float32 lacunarity, float32 gain) const {
+	JL_ASSERT(octaves > 0);
+	jlVector4 sum = jlVector4::ZERO;
+	jlSimdFloat frequency = jlSimdFloat(1.0f);
+	jlSimdFloat amplitude = jlSimdFloat(1.0f);
+	for (int32 o = 0; o < octaves; ++o) {
+		sum += sample(type, x * frequency, y * frequency) * amplitude;
+		frequency *= jlSimdFloat(lacunarity);
+		amplitude *= jlSimdFloat(gain);
+	}
+	return sum;
+}
+
+jlVector4 jlNoise::fbm(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z, int32 octaves, float32 lacunarity, float32 gain) const {
+	JL_ASSERT(octaves > 0);
+	jlVector4 sum = jlVector4::ZERO;
+	jlSimdFloat frequency = jlSimdFloat(1.0f);
+	jlSimdFloat amplitude = jlSimdFloat(1.0f);
+	for (int32 o = 0; o < octaves; ++o) {
+		sum += sample(type, x * frequency, y * frequency, z * frequency) * amplitude;
+		frequency *= jlSimdFloat(lacunarity);
+		amplitude *= jlSimdFloat(gain);
+	}
+	return sum;
+}
+
+jlVector4 jlNoise::turbulence(Type type, const jlVector4& x, const jlVector4& y, int32 octaves, float32 lacunarity, float32 gain) const {
+	JL_ASSERT(octaves > 0);
+	jlVector4 sum = jlVector4::ZERO;
+	jlSimdFloat frequency = jlSimdFloat(1.0f);
+	jlSimdFloat amplitude = jlSimdFloat(1.0f);
+	for (int32 o = 0; o < octaves; ++o) {
+		jlVector4 n = sample(type, x * frequency, y * frequency);
+		n.setMax(n, -n);
+		sum += n * amplitude;
+		frequency *= jlSimdFloat(lacunarity);
+		amplitude *= jlSimdFloat(gain);
+	}
+	return sum;
+}
+
+jlVector4 jlNoise::turbulence(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z, int32 octaves, float32 lacunarity, float32 gain) const {
+	JL_ASSERT(octaves > 0);
+	jlVector4 sum = jlVector4::ZERO;
+	jlSimdFloat frequency = jlSimdFloat(1.0f);
+	jlSimdFloat amplitude = jlSimdFloat(1.0f);
+	for (int32 o = 0; o < octaves; ++o) {
+		jlVector4 n = sample(type, x * frequency, y * frequency, z * frequency);
+		n.setMax(n, -n);
+		sum += n * amplitude;
+		frequency *= jlSimdFloat(lacunarity);
+		amplitude *= jlSimdFloat(gain);
+	}
+	return sum;
+}
+
+/// Points are generated in output order, eight at a time with AVX2 and
+/// then four at a time, so the buffer is written front to back once
+void jlNoise::fillGrid2(float32 *out, int32 nx, int32 ny, const jlVector4& origin, const jlVector4& spacing, Type type, int32 octaves) const {
+	JL_ASSERT(out != JL_NULL && ((uintptr_t)out & 15) == 0);
+	JL_ASSERT(nx > 0 && ny > 0);
+	const int32 total = nx * ny;
+	int32 ix = 0, iy = 0, n = 0;
+#if (JL_AVX2_ENABLED)
+	JL_ALIGN(32) float32 px8[8], py8[8];
+	for (; n + 8 <= total; n += 8) {
+		for (int32 l = 0; l < 8; ++l) {
+			px8[l] = origin(0) + ix * spacing(0);
+			py8[l] = origin(1) + iy * spacing(1);
+			if (++ix == nx) {
+				ix = 0;
+				++iy;
+			}
+		}
+		_mm256_storeu_ps(out + n, Fbm8(perm, type, _mm256_load_ps(px8), _mm256_load_ps(py8), octaves, 2.0f, 0.5f));
+	}
+#endif
+	JL_ALIGN_16 float32 px[4], py[4], tail[4];
+	for (; n < total; n += 4) {
+		for (int32 l = 0; l < 4; ++l) {
+			px[l] = origin(0) + ix * spacing(0);
+			py[l] = origin(1) + iy * spacing(1);
+			if (++ix == nx) {
+				ix = 0;
+				++iy;
+			}
+		}
+		jlVector4 x, y;
+		x.loadAligned(px);
+		y.loadAligned(py);
+		jlVector4 r = fbm(type, x, y, octaves);
+		if (n + 4 <= total) {
+			r.storeAligned(out + n);
+		} else {
+			r.storeAligned(tail);
+			for (int32 l = 0; n + l < total; ++l) {
+				out[n + l] = tail[l];
+			}
+		}
+	}
+}
+
+void jlNoise::fillGrid3(float32 *out, int32 nx, int32 ny, int32 nz, const jlVector4& origin, const jlVector4& spacing, Type type, int32 octaves) const {
+	JL_ASSERT(out != JL_NULL && ((uintptr_t)out & 15) == 0);
+	JL_ASSERT(nx > 0 && ny > 0 && nz > 0);
+	const int32 total = nx * ny * nz;
+	int32 ix = 0, iy = 0, iz = 0, n = 0;
+#if (JL_AVX2_ENABLED)
+	JL_ALIGN(32) float32 px8[8], py8[8], pz8[8];
+	for (; n + 8 <= total; n += 8) {
+		for (int32 l = 0; l < 8; ++l) {
+			px8[l] = origin(0) + ix * spacing(0);
+			py8[l] = origin(1) + iy * spacing(1);
+			pz8[l] = origin(2) + iz * spacing(2);
+			if (++ix == nx) {
+				ix = 0;
+				if (++iy == ny) {
+					iy = 0;
+					++iz;
+				}
+			}
+		}
+		_mm256_storeu_ps(out + n, Fbm8(perm, type, _mm256_load_ps(px8), _mm256_load_ps(py8), _mm256_load_ps(pz8), octaves, 2.0f, 0.5f));
+	}
+#endif
+	JL_ALIGN_16 float32 px[4], py[4], pz[4], tail[4];
+	for (; n < total; n += 4) {
+		for (int32 l = 0; l < 4; ++l) {
+			px[l] = origin(0) + ix * spacing(0);
+			py[l] = origin(1) + iy * spacing(1);
+			pz[l] = origin(2) + iz * spacing(2);
+			if (++ix == nx) {
+				ix = 0;
+				if (++iy == ny) {
+					iy = 0;
+					++iz;
+				}
+			}
+		}
+		jlVector4 x, y, z;
+		x.loadAligned(px);
+		y.loadAligned(py);
+		z.loadAligned(pz);
+		jlVector4 r = fbm(type, x, y, z, octaves);
+		if (n + 4 <= total) {
+			r.storeAligned(out + n);
+		} else {
+			r.storeAligned(tail);
+			for (int32 l = 0; n + l < total; ++l) {
+				out[n + l] = tail[l];
+			}
+		}
+	}
+}
+
+jlVector4 jlNoise::sample(Type type, const jlVector4& x, const jlVector4& y) const {
+	return (type == TYPE_SIMPLEX) ? simplex(x, y) : perlin(x, y);
+}
+
+jlVector4 jlNoise::sample(Type type, const jlVector4& x, const jlVector4& y, const jlVector4& z) const {
+	return (type == TYPE_SIMPLEX) ? simplex(x, y, z) : perlin(x, y, z);
+}
@@ -0,0 +1,462 @@
+#include "math/jlPolynomial.h"
+#include <cstring>
+
+// The double-float steps below rely on every product and sum being
+// rounded on its own, a fused multiply-add breaks their exact error terms
+#if (JL_COMPILER == JL_COMPILER_MSVC)
+#	pragma fp_contract(off)
+#else
+#	pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+	const jlVector4 NO_ROOT(FLOAT32_MAX, FLOAT32_MAX, FLOAT32_MAX, FLOAT32_MAX);
+	// cubic discriminants below this times the size of their terms count
+	// as zero, about the square of 16 float epsilons
+	const float32 DELTA_TOLERANCE = 1.0e-11f;
+	// a complex quartic pair is reported as a double root when its centre
+	// is a root within this many float epsilons of the coefficient sizes
+	const float32 PAIR_TOLERANCE = 2.0f;
+	// Newton steps for quartic roots and for the extremum between a pair
+	const int32 ROOT_STEPS = 4;
+	const int32 EXTREMUM_STEPS = 3;
+
+	JL_FORCE_INLINE jlVector4 Splat(float32 f) {
+		return jlVector4(f, f, f, f);
+	}
+
+	JL_FORCE_INLINE jlVector4 Select(const jlComp& comp, const jlVector4& trueValue, const jlVector4& falseValue) {
+		jlVector4 r;
+		r.setSelect(comp, trueValue, falseValue);
+		return r;
+	}
+
+	JL_FORCE_INLINE jlVector4 Abs(const jlVector4& x) {
+		jlVector4 r;
+		r.setMax(x, -x);
+		return r;
+	}
+
+	JL_FORCE_INLINE jlComp And(const jlComp& a, const jlComp& b) {
+		jlComp r;
+		r.setAnd(a, b);
+		return r;
+	}
+
+	/// Real cube root keeping the sign, exp2(log2(x) / 3) refined by one Newton step
+	jlVector4 Cbrt(const jlVector4& x) {
+		jlVector4 ax = Abs(x);
+		jlVector4 clamped; clamped.setMax(ax, Splat(FLOAT32_MIN));
+		jlVector4 y = jlMath::Exp2(jlMath::Log2(clamped) * jlSimdFloat(1.0f / 3.0f));
+		y = (y + y + clamped / (y * y)) * jlSimdFloat(1.0f / 3.0f);
+		y = Select(ax.compGreater(jlVector4::ZERO), y, jlVector4::ZERO);
+		return Select(x.compLess(jlVector4::ZERO), -y, y);
+	}
+
+	/// Roots of a x^2 + b x + c in no particular order, NO_ROOT where missing
+	void QuadraticRoots(const jlVector4& a, const jlVector4& b, const jlVector4& c, jlVector4 *r) {
+		jlVector4 disc = b * b - Splat(4.0f) * a * c;
+		jlVector4 clampedDisc; clampedDisc.setMax(disc, jlVector4::ZERO);
+		jlVector4 sq = jlMath::Sqrt(clampedDisc);
+		jlVector4 q = (b + Select(b.compGreaterEqual(jlVector4::ZERO), sq, -sq)) * jlSimdFloat(-0.5f);
+		jlComp isQuadratic = a.compNotEqual(jlVector4::ZERO);
+		jlComp hasRoots = And(isQuadratic, disc.compGreaterEqual(jlVector4::ZERO));
+		// q is only 0 when b and c are, then both roots are 0
+		jlComp qNonZero = q.compNotEqual(jlVector4::ZERO);
+		jlVector4 x0 = q / Select(isQuadratic, a, jlVector4::ONE);
+		jlVector4 x1 = Select(qNonZero, c / Select(qNonZero, q, jlVector4::ONE), jlVector4::ZERO);
+		// zero a leaves b x + c
+		jlComp bNonZero = b.compNotEqual(jlVector4::ZERO);
+		jlVector4 linear = Select(bNonZero, -c / Select(bNonZero, b, jlVector4::ONE), NO_ROOT);
+		r[0] = Select(isQuadratic, Select(hasRoots, x0, NO_ROOT), linear);
+		r[1] = Select(hasRoots, x1, NO_ROOT);
+	}
+
+	/// Roots of a x^3 + b x^2 + c x + d in no particular order, NO_ROOT where missing
+	void CubicRoots(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& d, jlVector4 *r) {
+		const jlSimdFloat third = jlSimdFloat(1.0f / 3.0f);
+		jlComp isCubic = a.compNotEqual(jlVector4::ZERO);
+		jlVector4 inv = jlVector4::ONE / Select(isCubic, a, jlVector4::ONE);
+		jlVector4 B = b * inv, C = c * inv, D = d * inv;
+		// x = t - B / 3 gives t^3 + p t + q
+		jlVector4 B2 = B * B;
+		jlVector4 p = C - B2 * third;
+		jlVector4 q = B * (B2 * jlSimdFloat(2.0f / 27.0f) - C * third) + D;
+		jlVector4 offset = B * third;
+		jlVector4 halfQ = q * jlSimdFloat(0.5f);
+		jlVector4 thirdP = p * third;
+		jlVector4 delta = halfQ * halfQ + thirdP * thirdP * thirdP;
+		// one real root, u^3 takes the sign of -q so the sum does not cancel
+		jlVector4 clampedDelta; clampedDelta.setMax(delta, jlVector4::ZERO);
+		jlVector4 sqrtDelta = jlMath::Sqrt(clampedDelta);
+		jlVector4 u = Cbrt(-(halfQ + Select(q.compGreaterEqual(jlVector4::ZERO), sqrtDelta, -sqrtDelta)));
+		jlComp uNonZero = u.compNotEqual(jlVector4::ZERO);
+		jlVector4 v = Select(uNonZero, -thirdP / Select(uNonZero, u, jlVector4::ONE), jlVector4::ZERO);
+		jlVector4 single = u + v;
+		// three real roots, t = 2 m cos(phi - 2 pi k / 3) with m = sqrt(-p / 3)
+		jlVector4 negThirdP; negThirdP.setMax(-thirdP, jlVector4::ZERO);
+		jlVector4 m = jlMath::Sqrt(negThirdP);
+		jlComp mNonZero = m.compGreater(jlVector4::ZERO);
+		jlVector4 cos3Phi = -halfQ / Select(mNonZero, m * m * m, jlVector4::ONE);
+		cos3Phi.setMin(cos3Phi, jlVector4::ONE);
+		cos3Phi.setMax(cos3Phi, -jlVector4::ONE);
+		jlVector4 phi = jlMath::ACos(cos3Phi) * third;
+		jlVector4 twoM = m + m;
+		const jlVector4 twoPiOverThree = Splat(2.0f * jlMath::PI / 3.0f);
+		jlVector4 t0 = twoM * jlMath::Cos(phi);
+		jlVector4 t1 = twoM * jlMath::Cos(phi - twoPiOverThree);
+		jlVector4 t2 = twoM * jlMath::Cos(phi + twoPiOverThree);
+		// p, q and so delta cancel badly near repeated roots, call it three
+		// roots while delta is within rounding of the terms that made p and q
+		jlVector4 absB = Abs(B), absC = Abs(C);
+		jlVector4 qScale = absB * (B2 * jlSimdFloat(2.0f / 27.0f) + absC * third) + Abs(D);
+		jlVector4 pScale = (absC + B2 * third) * third;
+		jlVector4 deltaScale = qScale * qScale * jlSimdFloat(0.25f) + pScale * pScale * pScale;
+		jlComp threeReal = delta.compLessEqual(deltaScale * jlSimdFloat(DELTA_TOLERANCE));
+		jlVector4 quadratic[2];
+		QuadraticRoots(b, c, d, quadratic);
+		r[0] = Select(isCubic, Select(threeReal, t0, single) - offset, quadratic[0]);
+		r[1] = Select(isCubic, Select(threeReal, t1 - offset, NO_ROOT), quadratic[1]);
+		r[2] = Select(And(isCubic, threeReal), t2 - offset, NO_ROOT);
+	}
+
+	/// One Newton step on the valid lanes, kept only where it lowers |f|
+	jlVector4 Polish(const jlVector4 *coeffs, int32 degree, const jlVector4& root) {
+		jlComp valid = root.compLess(NO_ROOT);
+		jlVector4 x = Select(valid, root, jlVector4::ZERO);
+		jlVector4 f = coeffs[0], df = jlVector4::ZERO;
+		for (int32 i = 1; i <= degree; ++i) {
+			df = df * x + f;
+			f = f * x + coeffs[i];
+		}
+		jlComp dfNonZero = df.compNotEqual(jlVector4::ZERO);
+		jlVector4 stepped = x - f / Select(dfNonZero, df, jlVector4::ONE);
+		jlVector4 fStepped = jlPolynomial::Evaluate(coeffs, degree, stepped);
+		jlComp better = Abs(fStepped).compLess(Abs(f));
+		return Select(And(And(valid, dfNonZero), better), stepped, root);
+	}
+
+	/// A double-float, the unevaluated sum hi + lo with |lo| at most half
+	/// an ulp of hi, carries about 48 bits through the quartic refinement
+	struct DoubleFloat {
+		jlVector4 hi;
+		jlVector4 lo;
+	};
+
+	/// s + e == a + b exactly, s = fl(a + b)
+	JL_FORCE_INLINE void TwoSum(const jlVector4& a, const jlVector4& b, jlVector4& s, jlVector4& e) {
+		s = a + b;
+		jlVector4 bb = s - a;
+		e = (a - (s - bb)) + (b - bb);
+	}
+
+	/// hi + lo == a + b exactly for |a| >= |b|
+	JL_FORCE_INLINE DoubleFloat FastTwoSum(const jlVector4& a, const jlVector4& b) {
+		DoubleFloat r;
+		r.hi = a + b;
+		r.lo = b - (r.hi - a);
+		return r;
+	}
+
+	/// Splits by clearing the low 12 mantissa bits rather than with
+	/// Veltkamp's multiply, so both halves have 12 significant bits
+#if (JL_SIMD_ENABLED)
+	JL_FORCE_INLINE jlVector4 HighBits(const jlVector4& x) {
+		return jlVector4(_mm_and_ps(x.getQuad(), _mm_castsi128_ps(_mm_set1_epi32(0xFFFFF000))));
+	}
+#else
+	jlVector4 HighBits(const jlVector4& x) {
+		jlVector4 r;
+		for (int32 i = 0; i < 4; ++i) {
+			uint32 bits;
+			memcpy(&bits, &x(i), sizeof(bits));
+			bits &= 0xFFFFF000U;
+			memcpy(&r(i), &bits, sizeof(bits));
+		}
+		return r;
+	}
+#endif
+
+	/// p + e == a b exactly, p = fl(a b), Dekker's product on 12 bit halves
+	JL_FORCE_INLINE void TwoProd(const jlVector4& a, const jlVector4& b, jlVector4& p, jlVector4& e) {
+		p = a * b;
+		jlVector4 ah = HighBits(a), bh = HighBits(b);
+		jlVector4 al = a - ah, bl = b - bh;
+		e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+	}
+
+	JL_FORCE_INLINE DoubleFloat Add(const DoubleFloat& a, const DoubleFloat& b) {
+		jlVector4 s, e;
+		TwoSum(a.hi, b.hi, s, e);
+		return FastTwoSum(s, e + a.lo + b.lo);
+	}
+
+	JL_FORCE_INLINE DoubleFloat Mul(const DoubleFloat& a, const DoubleFloat& b) {
+		jlVector4 p, e;
+		TwoProd(a.hi, b.hi, p, e);
+		return FastTwoSum(p, e + (a.hi * b.lo + a.lo * b.hi));
+	}
+
+	JL_FORCE_INLINE DoubleFloat Mul(const DoubleFloat& a, const jlVector4& b) {
+		jlVector4 p, e;
+		TwoProd(a.hi, b, p, e);
+		return FastTwoSum(p, e + a.lo * b);
+	}
+
+	/// Exact for powers of 2
+	JL_FORCE_INLINE DoubleFloat Scale(const DoubleFloat& a, float32 s) {
+		DoubleFloat r;
+		r.hi = a.hi * jlSimdFloat(s);
+		r.lo = a.lo * jlSimdFloat(s);
+		return r;
+	}
+
+	JL_FORCE_INLINE DoubleFloat Negate(const DoubleFloat& a) {
+		DoubleFloat r;
+		r.hi = -a.hi;
+		r.lo = -a.lo;
+		return r;
+	}
+
+	/// n / d to double-float, the remainder n - q d is exact
+	JL_FORCE_INLINE DoubleFloat Div(const jlVector4& n, const jlVector4& d) {
+		jlVector4 q = n / d;
+		jlVector4 p, e;
+		TwoProd(q, d, p, e);
+		return FastTwoSum(q, ((n - p) - e) / d);
+	}
+
+	/// f and f' of the polynomial with double-float coefficients c at x.
+	/// f is compensated Horner, as accurate as Horner in double-float and
+	/// then rounded, f' only steers Newton and stays plain float.
+	void CompensatedHorner(const DoubleFloat *c, int32 degree, const jlVector4& x, jlVector4& f, jlVector4& df) {
+		jlVector4 s = c[0].hi, err = c[0].lo;
+		df = jlVector4::ZERO;
+		for (int32 i = 1; i <= degree; ++i) {
+			df = df * x + s;
+			jlVector4 p, pe, se;
+			TwoProd(s, x, p, pe);
+			TwoSum(p, c[i].hi, s, se);
+			err = err * x + (pe + se + c[i].lo);
+		}
+		f = s + err;
+	}
+
+	/// Newton from root on the lanes where it is a root, each step kept only
+	/// where the compensated |f| drops, so it settles within about an ulp.
+	/// residual gets |f| at the result, NO_ROOT where there is no root.
+	jlVector4 Refine(const DoubleFloat *c, int32 degree, const jlVector4& root, int32 steps, jlVector4& residual) {
+		jlComp valid = root.compLess(NO_ROOT);
+		jlVector4 x = Select(valid, root, jlVector4::ZERO);
+		jlVector4 f, df;
+		CompensatedHorner(c, degree, x, f, df);
+		for (int32 s = 0; s < steps; ++s) {
+			jlComp dfNonZero = df.compNotEqual(jlVector4::ZERO);
+			jlVector4 stepped = x - f / Select(dfNonZero, df, jlVector4::ONE);
+			jlVector4 fStepped, dfStepped;
+			CompensatedHorner(c, degree, stepped, fStepped, dfStepped);
+			jlComp better = And(dfNonZero, Abs(fStepped).compLess(Abs(f)));
+			x = Select(better, stepped, x);
+			f = Select(better, fStepped, f);
+			df = Select(better, dfStepped, df);
+		}
+		residual = Select(valid, Abs(f), NO_ROOT);
+		return Select(valid, x, NO_ROOT);
+	}
+
+	/// Largest |f(x)| that rounding the coefficients to float can account
+	/// for, PAIR_TOLERANCE float epsilons of sum |c_i| |x|^i
+	jlVector4 RoundingBound(const DoubleFloat *c, int32 degree, const jlVector4& x) {
+		jlVector4 ax = Abs(x);
+		jlVector4 s = Abs(c[0].hi);
+		for (int32 i = 1; i <= degree; ++i) {
+			s = s * ax + Abs(c[i].hi);
+		}
+		return s * jlSimdFloat(PAIR_TOLERANCE * FLOAT32_EPSILON);
+	}
+
+	/// Where a close real pair of f is lost: the extremum e that Newton on
+	/// f' reaches from start, f(e), and the half width sqrt(-2 f(e) / f''(e))
+	/// of the pair that f(e) + f''(e) (x - e)^2 / 2 puts either side of e.
+	/// real is set where that model has a pair, doubleRoot where f(e) is a
+	/// root to within rounding of the coefficients.
+	struct PairModel {
+		jlVector4 extremum;
+		jlVector4 fx;
+		jlVector4 halfWidth;
+		jlComp real;
+		jlComp doubleRoot;
+	};
+
+	PairModel ModelPair(const DoubleFloat *f, const DoubleFloat *df, const jlVector4& start) {
+		PairModel m;
+		jlVector4 unused, slope, dfx, curvature;
+		m.extremum = Refine(df, 3, start, EXTREMUM_STEPS, unused);
+		CompensatedHorner(f, 4, m.extremum, m.fx, slope);
+		CompensatedHorner(df, 3, m.extremum, dfx, curvature);
+		m.doubleRoot = Abs(m.fx).compLessEqual(RoundingBound(f, 4, m.extremum));
+		jlComp curved = curvature.compNotEqual(jlVector4::ZERO);
+		jlVector4 halfWidthSq = -(m.fx + m.fx) / Select(curved, curvature, jlVector4::ONE);
+		m.real = And(curved, halfWidthSq.compGreater(jlVector4::ZERO));
+		m.halfWidth = jlMath::Sqrt(Select(m.real, halfWidthSq, jlVector4::ZERO));
+		return m;
+	}
+
+	JL_FORCE_INLINE void CompareExchange(jlVector4& lo, jlVector4& hi) {
+		jlVector4 t = lo;
+		lo.setMin(t, hi);
+		hi.setMax(t, hi);
+	}
+
+	/// Sorts count roots per lane and fills the remaining slots and the masks
+	void Finish(jlVector4 *r, int32 count, jlPolynomialRoots& out) {
+		for (int32 i = count; i < 4; ++i) {
+			r[i] = NO_ROOT;
+		}
+		// five exchange network, sorts any four
+		CompareExchange(r[0], r[1]);
+		CompareExchange(r[2], r[3]);
+		CompareExchange(r[0], r[2]);
+		CompareExchange(r[1], r[3]);
+		CompareExchange(r[1], r[2]);
+		for (int32 i = 0; i < 4; ++i) {
+			out.roots[i] = r[i];
+			out.valid[i] = r[i].compLess(NO_ROOT);
+		}
+	}
+}
+
+jlPolynomialRoots jlPolynomial::SolveQuadratic(const jlVector4& a, const jlVector4& b, const jlVector4& c) {
+	jlVector4 r[4];
+	QuadraticRoots(a, b, c, r);
+	jlPolynomialRoots out;
+	Finish(r, 2, out);
+	return out;
+}
+
+jlPolynomialRoots jlPolynomial::SolveCubic(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& d) {
+	const jlVector4 coeffs[4] = { a, b, c, d };
+	jlVector4 r[4];
+	CubicRoots(a, b, c, d, r);
+	for (int32 i = 0; i < 3; ++i) {
+		r[i] = Polish(coeffs, 3, r[i]);
+	}
+	jlPolynomialRoots out;
+	Finish(r, 3, out);
+	return out;
+}
+
+/// With x = y - B / 4 the quartic is y^4 + p y^2 + q y + r, which for any
+/// root m of 8 m^3 + 8 p m^2 + (2 p^2 - 8 r) m - q^2 equals
+/// (y^2 + p / 2 + m)^2 - 2 m (y - q / 4m)^2.  The largest root is never
+/// negative, when it is 0 q is too and the quartic is quadratic in y^2.
+jlPolynomialRoots jlPolynomial::SolveQuartic(const jlVector4& a, const jlVector4& b, const jlVector4& c, const jlVector4& d, const jlVector4& e) {
+	jlComp isQuartic = a.compNotEqual(jlVector4::ZERO);
+	jlVector4 lead = Select(isQuartic, a, jlVector4::ONE);
+	// the depressed coefficients are small differences of terms up to B^4,
+	// with roots clustered away from 0 float loses all of r, so form them
+	// in double-float and round once
+	DoubleFloat B = Div(b, lead), C = Div(c, lead), D = Div(d, lead), E = Div(e, lead);
+	DoubleFloat B2 = Mul(B, B);
+	DoubleFloat threeB2 = Mul(B2, Splat(3.0f));
+	jlVector4 p = Add(C, Negate(Scale(threeB2, 0.125f))).hi;
+	jlVector4 q = Add(Mul(B, Add(Scale(B2, 0.125f), Negate(Scale(C, 0.5f)))), D).hi;
+	DoubleFloat rd = Add(E, Negate(Scale(Mul(B, D), 0.25f)));
+	rd = Add(rd, Scale(Mul(B2, C), 0.0625f));
+	jlVector4 r = Add(rd, Negate(Scale(Mul(threeB2, B2), 1.0f / 256.0f))).hi;
+	jlVector4 offset = B.hi * jlSimdFloat(0.25f);
+	// largest resolvent root
+	jlPolynomialRoots resolvent = SolveCubic(Splat(8.0f), p * jlSimdFloat(8.0f), p * p * jlSimdFloat(2.0f) - r * jlSimdFloat(8.0f), -(q * q));
+	jlVector4 m = Select(resolvent.valid[1], resolvent.roots[1], resolvent.roots[0]);
+	m = Select(resolvent.valid[2], resolvent.roots[2], m);
+	m.setMax(m, jlVector4::ZERO);
+	jlComp split = m.compGreater(jlVector4::ZERO);
+	jlVector4 s = jlMath::Sqrt(m + m);
+	jlVector4 k = q / (Select(split, s, jlVector4::ONE) * jlSimdFloat(2.0f));
+	jlVector4 base = p * jlSimdFloat(0.5f) + m;
+	jlVector4 y[4];
+	QuadraticRoots(jlVector4::ONE, s, base - k, y);
+	QuadraticRoots(jlVector4::ONE, -s, base + k, y + 2);
+	// biquadratic lanes, y = +-sqrt(z) for z^2 + p z + r
+	jlVector4 z[2];
+	QuadraticRoots(jlVector4::ONE, p, r, z);
+	jlVector4 roots[4];
+	for (int32 i = 0; i < 2; ++i) {
+		jlComp usable = And(z[i].compLess(NO_ROOT), z[i].compGreaterEqual(jlVector4::ZERO));
+		jlVector4 w = jlMath::Sqrt(Select(usable, z[i], jlVector4::ZERO));
+		roots[2 * i] = Select(usable, w, NO_ROOT);
+		roots[2 * i + 1] = Select(usable, -w, NO_ROOT);
+	}
+	jlVector4 cubic[3];
+	CubicRoots(b, c, d, e, cubic);
+	for (int32 i = 0; i < 4; ++i) {
+		jlVector4 yi = Select(split, y[i], roots[i]);
+		jlVector4 x = Select(yi.compLess(NO_ROOT), yi - offset, NO_ROOT);
+		roots[i] = Select(isQuartic, x, (i < 3) ? cubic[i] : NO_ROOT);
+	}
+	// the float pipeline loses a few digits to cancellation, Newton with
+	// f in double-float puts each root back within an ulp or so.  Leading
+	// zeros are harmless to Horner, so lower degree lanes polish the same way.
+	DoubleFloat f[5], df[4];
+	const jlVector4 coeffs[5] = { a, b, c, d, e };
+	for (int32 i = 0; i < 5; ++i) {
+		f[i].hi = coeffs[i];
+		f[i].lo = jlVector4::ZERO;
+	}
+	for (int32 i = 0; i < 4; ++i) {
+		TwoProd(coeffs[i], Splat(static_cast<float32>(4 - i)), df[i].hi, df[i].lo);
+	}
+	jlVector4 residual[4];
+	for (int32 i = 0; i < 4; ++i) {
+		roots[i] = Refine(f, 4, roots[i], ROOT_STEPS, residual[i]);
+	}
+	// a close real pair can come out of the float pipeline complex, or
+	// stuck either side of the extremum between its roots where f' is too
+	// flat for Newton.  The factor's centre leads to that extremum, and the
+	// factor takes the modelled pair, or the double root, when its worst
+	// |f| is smaller than that of the pair it has.
+	jlComp pairable = And(isQuartic, split);
+	for (int32 i = 0; i < 2; ++i) {
+		PairModel m = ModelPair(f, df, s * jlSimdFloat(i ? 0.5f : -0.5f) - offset);
+		jlVector4 lowerResidual, upperResidual;
+		jlVector4 lower = Refine(f, 4, Select(m.real, m.extremum - m.halfWidth, NO_ROOT), ROOT_STEPS, lowerResidual);
+		jlVector4 upper = Refine(f, 4, Select(m.real, m.extremum + m.halfWidth, NO_ROOT), ROOT_STEPS, upperResidual);
+		jlVector4 splitResidual, currentResidual;
+		splitResidual.setMax(lowerResidual, upperResidual);
+		currentResidual.setMax(residual[2 * i], residual[2 * i + 1]);
+		jlVector4 pairResidual = Select(m.doubleRoot, Abs(m.fx), splitResidual);
+		jlComp replace = And(pairable, pairResidual.compLess(currentResidual));
+		roots[2 * i] = Select(replace, Select(m.doubleRoot, m.extremum, lower), roots[2 * i]);
+		roots[2 * i + 1] = Select(replace, Select(m.doubleRoot, m.extremum, upper), roots[2 * i + 1]);
+	}
+	// a pair split across the two factors has no centre to start from, but
+	// a root stuck on it still sits by its extremum, so that root moves to
+	// the modelled root on its own side when that lowers |f|
+	for (int32 i = 0; i < 4; ++i) {
+		jlComp valid = roots[i].compLess(NO_ROOT);
+		jlVector4 x = Select(valid, roots[i], jlVector4::ZERO);
+		jlVector4 fr, slope;
+		CompensatedHorner(f, 4, x, fr, slope);
+		jlComp stuck = And(valid, Abs(fr).compGreater(RoundingBound(f, 4, x)));
+		PairModel m = ModelPair(f, df, x);
+		jlVector4 side = Select(roots[i].compLess(m.extremum), m.extremum - m.halfWidth, m.extremum + m.halfWidth);
+		jlVector4 modelResidual;
+		jlVector4 model = Refine(f, 4, Select(m.real, side, NO_ROOT), ROOT_STEPS, modelResidual);
+		model = Select(m.doubleRoot, m.extremum, model);
+		modelResidual = Select(m.doubleRoot, Abs(m.fx), modelResidual);
+		jlComp replace = And(stuck, modelResidual.compLess(Abs(fr)));
+		roots[i] = Select(replace, model, roots[i]);
+	}
+	jlPolynomialRoots out;
+	Finish(roots, 4, out);
+	return out;
+}
+
+jlVector4 jlPolynomial::Evaluate(const jlVector4 *coeffs, int32 degree, const jlVector4& x) {
+	JL_ASSERT(coeffs != JL_NULL && degree >= 0);
+	jlVector4 f = coeffs[0];
+	for (int32 i = 1; i <= degree; ++i) {
+		f = f * x + coeffs[i];
+	}
+	return f;
+}
@@ -1,4 +1,44 @@
 #include "math/jlQuaternion.h"
 
-const jlQuaternion jlQuaternion::ZERO = jlQuaternion(0.0f, 0.0f, 0.0f, 0.0f);
-const jlQuaternion jlQuaternion::IDENTITY = jlQuaternion(0.0f, 0.0f, 0.0f, 1.0f);
+const jlQuaternion jlQuaternion::ZERO(0.0f, 0.0f, 0.0f, 0.0f);
+const jlQuaternion jlQuaternion::IDENTITY(0.0f, 0.0f, 0.0f, 1.0f);
+
+void jlQuaternion::FromAxisAngles(const jlVector4 *axes, const float32 *angles, jlQuaternion *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (axes != JL_NULL && angles != JL_NULL && out != JL_NULL));
+	jlSimdFloat half = jlSimdFloat(0.5f);
+	jlVector4 s, c;
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		jlVector4 halfTheta; halfTheta.load(angles + i);
+		jlMath::SinCos(halfTheta * half, &s, &c);
+		out[i].vec.setMul(axes[i], s.getElem<0>());
+		out[i].vec.setElem<3>(c.getElem<0>());
+		out[i + 1].vec.setMul(axes[i + 1], s.getElem<1>());
+		out[i + 1].vec.setElem<3>(c.getElem<1>());
+		out[i + 2].vec.setMul(axes[i + 2], s.getElem<2>());
+		out[i + 2].vec.setElem<3>(c.getElem<2>());
+		out[i + 3].vec.setMul(axes[i + 3], s.getElem<3>());
+		out[i + 3].vec.setElem<3>(c.getElem<3>());
+	}
+	if (i < count) {
+		JL_ALIGN_16 float32 rest[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int32 j = i; j < count; ++j) {
+			rest[j - i] = angles[j];
+		}
+		jlVector4 halfTheta; halfTheta.loadAligned(rest);
+		jlMath::SinCos(halfTheta * half, &s, &c);
+		for (int32 j = i; j < count; ++j) {
+			out[j].vec.setMul(axes[j], s.getElem(j - i));
+			out[j].vec.setElem<3>(c.getElem(j - i));
+		}
+	}
+}
+
+void jlQuaternion::FromEulers(const jlVector4 *angles, jlQuaternion *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (angles != JL_NULL && out != JL_NULL));
+	for (int32 i = 0; i < count; ++i) {
+		out[i].setEuler(angles[i]);
+	}
+}
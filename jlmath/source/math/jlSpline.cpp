@@ -0,0 +1,400 @@
+#include "math/jlSpline.h"
+
+namespace {
+	// BASIS[b][i][j] is the weight of control point j in the t^i coefficient
+	const float32 BASIS[4][4][4] = {
+		{ // bezier
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ -3.0f, 3.0f, 0.0f, 0.0f },
+			{ 3.0f, -6.0f, 3.0f, 0.0f },
+			{ -1.0f, 3.0f, -3.0f, 1.0f }
+		},
+		{ // hermite, p0 m0 p1 m1
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ -3.0f, -2.0f, 3.0f, -1.0f },
+			{ 2.0f, 1.0f, -2.0f, 1.0f }
+		},
+		{ // catmull-rom
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ -0.5f, 0.0f, 0.5f, 0.0f },
+			{ 1.0f, -2.5f, 2.0f, -0.5f },
+			{ -0.5f, 1.5f, -1.5f, 0.5f }
+		},
+		{ // uniform b-spline
+			{ 1.0f / 6.0f, 4.0f / 6.0f, 1.0f / 6.0f, 0.0f },
+			{ -0.5f, 0.0f, 0.5f, 0.0f },
+			{ 0.5f, -1.0f, 0.5f, 0.0f },
+			{ -1.0f / 6.0f, 0.5f, -0.5f, 1.0f / 6.0f }
+		}
+	};
+
+	// below this sin(angle) slerp falls back to lerp
+	const float32 SLERP_EPSILON = 1.0e-4f;
+
+	/// Slerps four pairs at once, lane l blends a[l * aStride] to b[l * bStride]
+	/// by t(l).  A stride of 0 repeats one quaternion for every lane.
+	void SlerpLanes(const jlQuaternion *a, int32 aStride, const jlQuaternion *b, int32 bStride, const jlVector4& t, jlQuaternion *out) {
+		JL_ALIGN_16 float32 cosines[4];
+		jlQuaternion target[4];
+		for (int32 l = 0; l < 4; ++l) {
+			target[l] = b[l * bStride];
+			float32 c = a[l * aStride].dot(target[l]);
+			// shortest path, same as jlQuaternion::Slerp
+			if (c < 0.0f) {
+				c = -c;
+				target[l] = -target[l];
+			}
+			cosines[l] = (c < 1.0f) ? c : 1.0f;
+		}
+		jlVector4 c; c.loadAligned(cosines);
+		jlVector4 angle = jlMath::ACos(c);
+		jlVector4 sinAngle = jlMath::Sin(angle);
+		jlVector4 eps = jlVector4(SLERP_EPSILON, SLERP_EPSILON, SLERP_EPSILON, SLERP_EPSILON);
+		jlVector4 safeSin; safeSin.setMax(sinAngle, eps);
+		jlVector4 invSin = jlVector4::ONE / safeSin;
+		jlVector4 s = jlVector4::ONE - t;
+		jlVector4 w0 = jlMath::Sin(s * angle) * invSin;
+		jlVector4 w1 = jlMath::Sin(t * angle) * invSin;
+		// nearly parallel lanes lerp instead
+		jlComp isSmall = sinAngle.compLess(eps);
+		jlComp isLarge = sinAngle.compGreaterEqual(eps);
+		w0.splice(isLarge.getCompMask());
+		w1.splice(isLarge.getCompMask());
+		jlVector4 l0 = s, l1 = t;
+		l0.splice(isSmall.getCompMask());
+		l1.splice(isSmall.getCompMask());
+		w0 += l0;
+		w1 += l1;
+		for (int32 l = 0; l < 4; ++l) {
+			out[l] = a[l * aStride] * w0.getElem(l) + target[l] * w1.getElem(l);
+		}
+	}
+}
+
+void jlCubicSegment::set(Basis basis, const jlVector4& g0, const jlVector4& g1, const jlVector4& g2, const jlVector4& g3) {
+	JL_ASSERT(basis >= BASIS_BEZIER && basis <= BASIS_BSPLINE);
+	const float32 (*m)[4] = BASIS[basis];
+	for (int32 i = 0; i < 4; ++i) {
+		coeff[i] = g0 * jlSimdFloat(m[i][0]) + g1 * jlSimdFloat(m[i][1]) + g2 * jlSimdFloat(m[i][2]) + g3 * jlSimdFloat(m[i][3]);
+	}
+}
+
+void jlCubicSegment::evaluate(const float32 *t, jlVector4 *out, int32 count) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (t != JL_NULL && out != JL_NULL));
+	for (int32 i = 0; i < count; ++i) {
+		out[i] = evaluate(jlSimdFloat(t[i]));
+	}
+}
+
+void jlCubicSegment::derivative(const float32 *t, jlVector4 *out, int32 count) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (t != JL_NULL && out != JL_NULL));
+	for (int32 i = 0; i < count; ++i) {
+		out[i] = derivative(jlSimdFloat(t[i]));
+	}
+}
+
+/// With step h the differences at t are
+///   d1 = p' h + p'' h^2 / 2 + p''' h^3 / 6
+///   d2 = p'' h^2 + p''' h^3
+///   d3 = p''' h^3
+/// and each step adds d1 to the point, d2 to d1 and d3 to d2.
+void jlCubicSegment::evaluateUniform(jlVector4 *out, int32 count, float32 t0, float32 t1) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || out != JL_NULL);
+	if (count == 1) {
+		out[0] = evaluate(jlSimdFloat(t0));
+		return;
+	}
+	const float32 step = (t1 - t0) / (count - 1);
+	const jlSimdFloat h = jlSimdFloat(step);
+	const jlSimdFloat h2 = h * h;
+	const jlSimdFloat h3 = h2 * h;
+	const jlVector4 d3 = coeff[3] * (jlSimdFloat(6.0f) * h3);
+	for (int32 start = 0; start < count; start += FORWARD_DIFFERENCE_RUN) {
+		const jlSimdFloat t = jlSimdFloat(t0 + start * step);
+		jlVector4 p = evaluate(t);
+		jlVector4 second = secondDerivative(t);
+		jlVector4 d1 = derivative(t) * h + second * (jlSimdFloat(0.5f) * h2) + coeff[3] * h3;
+		jlVector4 d2 = second * h2 + d3;
+		int32 end = start + FORWARD_DIFFERENCE_RUN;
+		if (end > count) {
+			end = count;
+		}
+		for (int32 i = start; i < end; ++i) {
+			out[i] = p;
+			p += d1;
+			d1 += d2;
+			d2 += d3;
+		}
+	}
+}
+
+int32 jlCubicSegment::GetSegmentCount(Basis basis, int32 pointCount) {
+	int32 n = 0;
+	switch (basis) {
+	case BASIS_BEZIER:
+		n = (pointCount - 1) / 3;
+		break;
+	case BASIS_HERMITE:
+		n = pointCount / 2 - 1;
+		break;
+	case BASIS_CATMULL_ROM:
+	case BASIS_BSPLINE:
+		n = pointCount - 3;
+		break;
+	}
+	return (n > 0) ? n : 0;
+}
+
+int32 jlCubicSegment::Build(Basis basis, const jlVector4 *points, int32 count, jlCubicSegment *out) {
+	const int32 segments = GetSegmentCount(basis, count);
+	JL_ASSERT(segments == 0 || (points != JL_NULL && out != JL_NULL));
+	const int32 stride = (basis == BASIS_BEZIER) ? 3 : (basis == BASIS_HERMITE) ? 2 : 1;
+	for (int32 i = 0; i < segments; ++i) {
+		const jlVector4 *g = points + i * stride;
+		out[i].set(basis, g[0], g[1], g[2], g[3]);
+	}
+	return segments;
+}
+
+jlArcLengthTable::jlArcLengthTable() : lengths(JL_NULL), samples(0) { }
+
+jlArcLengthTable::~jlArcLengthTable() {
+	release();
+}
+
+jlResult jlArcLengthTable::init(const jlCubicSegment& segment, int32 sampleCount) {
+	JL_ASSERT(!isInit());
+	JL_ASSERT_MSG(sampleCount > 0, "Arc length table needs at least one sample!");
+	if (sampleCount <= 0) {
+		return JL_ERROR;
+	}
+	jlVector4 *points = static_cast<jlVector4 *>(jlAllocAligned((sampleCount + 1) * sizeof(jlVector4), 16));
+	lengths = static_cast<float32 *>(jlAllocAligned((sampleCount + 1) * sizeof(float32), 16));
+	if (!points || !lengths) {
+		if (points) {
+			jlFreeAligned(points);
+		}
+		if (lengths) {
+			jlFreeAligned(lengths);
+			lengths = JL_NULL;
+		}
+		return JL_BAD_ALLOC;
+	}
+	samples = sampleCount;
+	segment.evaluateUniform(points, samples + 1);
+	lengths[0] = 0.0f;
+	for (int32 i = 1; i <= samples; ++i) {
+		lengths[i] = lengths[i - 1] + jlVector4::Distance(points[i - 1], points[i]);
+	}
+	jlFreeAligned(points);
+	return JL_OK;
+}
+
+void jlArcLengthTable::release() {
+	if (lengths) {
+		jlFreeAligned(lengths);
+		lengths = JL_NULL;
+	}
+	samples = 0;
+}
+
+/// Binary search for the bracketing samples, then linear between them
+float32 jlArcLengthTable::getParameter(float32 distance) const {
+	JL_SLOW_ASSERT_MSG(isInit(), "Arc length table used before init!");
+	if (distance <= 0.0f) {
+		return 0.0f;
+	}
+	if (distance >= lengths[samples]) {
+		return 1.0f;
+	}
+	int32 lo = 0, hi = samples;
+	while (hi - lo > 1) {
+		int32 mid = (lo + hi) >> 1;
+		if (lengths[mid] <= distance) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	float32 span = lengths[hi] - lengths[lo];
+	float32 frac = (span > 0.0f) ? (distance - lengths[lo]) / span : 0.0f;
+	return (lo + frac) / samples;
+}
+
+void jlArcLengthTable::getParameters(const float32 *distances, float32 *out, int32 count) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (distances != JL_NULL && out != JL_NULL));
+	for (int32 i = 0; i < count; ++i) {
+		out[i] = getParameter(distances[i]);
+	}
+}
+
+/// The distances are increasing so the bracket only ever moves forward
+void jlArcLengthTable::evaluateEvenly(const jlCubicSegment& segment, jlVector4 *out, int32 count) const {
+	JL_SLOW_ASSERT_MSG(isInit(), "Arc length table used before init!");
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || out != JL_NULL);
+	if (count == 1) {
+		out[0] = segment.evaluate(jlSimdFloat(0.0f));
+		return;
+	}
+	const float32 spacing = lengths[samples] / (count - 1);
+	int32 lo = 0;
+	for (int32 i = 0; i < count; ++i) {
+		float32 distance = (i == count - 1) ? lengths[samples] : i * spacing;
+		while (lo < samples - 1 && lengths[lo + 1] <= distance) {
+			++lo;
+		}
+		float32 span = lengths[lo + 1] - lengths[lo];
+		float32 frac = (span > 0.0f) ? (distance - lengths[lo]) / span : 0.0f;
+		if (frac > 1.0f) {
+			frac = 1.0f;
+		}
+		out[i] = segment.evaluate(jlSimdFloat((lo + frac) / samples));
+	}
+}
+
+jlQuaternionSegment::jlQuaternionSegment() : type(TYPE_SQUAD) {
+	for (int32 i = 0; i < 4; ++i) {
+		control[i] = jlQuaternion::IDENTITY;
+	}
+}
+
+void jlQuaternionSegment::setSquad(const jlQuaternion& prev, const jlQuaternion& q0, const jlQuaternion& q1, const jlQuaternion& next) {
+	// keep the keys in one hemisphere so the tangents see the short arcs
+	jlQuaternion k1 = (q0.dot(q1) < jlSimdFloat(0.0f)) ? -q1 : q1;
+	jlQuaternion k0 = (q0.dot(prev) < jlSimdFloat(0.0f)) ? -prev : prev;
+	jlQuaternion k2 = (k1.dot(next) < jlSimdFloat(0.0f)) ? -next : next;
+	control[0] = q0;
+	control[1] = SquadTangent(k0, q0, k1);
+	control[2] = SquadTangent(q0, k1, k2);
+	control[3] = k1;
+	type = TYPE_SQUAD;
+}
+
+void jlQuaternionSegment::setBezier(const jlQuaternion& q0, const jlQuaternion& q1, const jlQuaternion& q2, const jlQuaternion& q3) {
+	control[0] = q0;
+	for (int32 i = 1; i < 4; ++i) {
+		const jlQuaternion& q = (i == 1) ? q1 : (i == 2) ? q2 : q3;
+		control[i] = (control[i - 1].dot(q) < jlSimdFloat(0.0f)) ? -q : q;
+	}
+	type = TYPE_BEZIER;
+}
+
+jlQuaternion jlQuaternionSegment::evaluate(const jlSimdFloat& t) const {
+	if (type == TYPE_SQUAD) {
+		return Squad(control[0], control[1], control[2], control[3], t);
+	}
+	jlQuaternion r0 = jlQuaternion::Slerp(control[0], control[1], t);
+	jlQuaternion r1 = jlQuaternion::Slerp(control[1], control[2], t);
+	jlQuaternion r2 = jlQuaternion::Slerp(control[2], control[3], t);
+	return jlQuaternion::Slerp(jlQuaternion::Slerp(r0, r1, t), jlQuaternion::Slerp(r1, r2, t), t);
+}
+
+void jlQuaternionSegment::evaluate(const float32 *t, jlQuaternion *out, int32 count) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || (t != JL_NULL && out != JL_NULL));
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		jlVector4 tv; tv.load(t + i);
+		evaluate4(tv, out + i);
+	}
+	if (i < count) {
+		JL_ALIGN_16 float32 rest[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int32 j = i; j < count; ++j) {
+			rest[j - i] = t[j];
+		}
+		jlQuaternion group[4];
+		jlVector4 tv; tv.loadAligned(rest);
+		evaluate4(tv, group);
+		for (int32 j = i; j < count; ++j) {
+			out[j] = group[j - i];
+		}
+	}
+}
+
+void jlQuaternionSegment::evaluateUniform(jlQuaternion *out, int32 count, float32 t0, float32 t1) const {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(count == 0 || out != JL_NULL);
+	const float32 step = (count > 1) ? (t1 - t0) / (count - 1) : 0.0f;
+	JL_ALIGN_16 float32 t[4];
+	jlQuaternion group[4];
+	for (int32 i = 0; i < count; i += 4) {
+		for (int32 l = 0; l < 4; ++l) {
+			t[l] = t0 + (i + l) * step;
+		}
+		jlVector4 tv; tv.loadAligned(t);
+		if (i + 4 <= count) {
+			evaluate4(tv, out + i);
+		} else {
+			evaluate4(tv, group);
+			for (int32 j = i; j < count; ++j) {
+				out[j] = group[j - i];
+			}
+		}
+	}
+}
+
+/// Squad is slerp(slerp(q0, q1, t), slerp(a0, a1, t), 2t(1 - t)), Bezier
+/// is three levels of De Casteljau.  The first level slerps fixed pairs
+/// so the lanes only differ in t.
+void jlQuaternionSegment::evaluate4(const jlVector4& t, jlQuaternion *out) const {
+	if (type == TYPE_SQUAD) {
+		jlQuaternion outer[4], inner[4];
+		SlerpLanes(&control[0], 0, &control[3], 0, t, outer);
+		SlerpLanes(&control[1], 0, &control[2], 0, t, inner);
+		jlVector4 blend = t * (jlVector4::ONE - t) * jlSimdFloat(2.0f);
+		SlerpLanes(outer, 1, inner, 1, blend, out);
+		return;
+	}
+	jlQuaternion r[3][4], s[2][4];
+	for (int32 i = 0; i < 3; ++i) {
+		SlerpLanes(&control[i], 0, &control[i + 1], 0, t, r[i]);
+	}
+	SlerpLanes(r[0], 1, r[1], 1, t, s[0]);
+	SlerpLanes(r[1], 1, r[2], 1, t, s[1]);
+	SlerpLanes(s[0], 1, s[1], 1, t, out);
+}
+
+/// a = q exp(-(log(q^-1 next) + log(q^-1 prev)) / 4)
+jlQuaternion jlQuaternionSegment::SquadTangent(const jlQuaternion& prev, const jlQuaternion& q, const jlQuaternion& next) {
+	jlQuaternion inv = q.unitInverse();
+	jlVector4 sum = Log(inv * next) + Log(inv * prev);
+	return q * Exp(sum * jlSimdFloat(-0.25f));
+}
+
+jlQuaternion jlQuaternionSegment::Squad(const jlQuaternion& q0, const jlQuaternion& a0, const jlQuaternion& a1, const jlQuaternion& q1, const jlSimdFloat& t) {
+	jlSimdFloat blend = jlSimdFloat(2.0f) * t * (jlSimdFloat(1.0f) - t);
+	return jlQuaternion::Slerp(jlQuaternion::Slerp(q0, q1, t), jlQuaternion::Slerp(a0, a1, t), blend);
+}
+
+jlVector4 jlQuaternionSegment::Log(const jlQuaternion& q) {
+	jlVector4 v = q.vec;
+	v.setElem<3>(jlSimdFloat(0.0f));
+	jlSimdFloat sinAngle = v.length3();
+	if (sinAngle < jlSimdFloat(SLERP_EPSILON)) {
+		return v;
+	}
+	jlSimdFloat angle = jlMath::ATan2(sinAngle, q.vec.getElem<3>());
+	return v * (angle / sinAngle);
+}
+
+jlQuaternion jlQuaternionSegment::Exp(const jlVector4& v) {
+	jlVector4 axis = v;
+	axis.setElem<3>(jlSimdFloat(0.0f));
+	jlSimdFloat angle = axis.length3();
+	jlSimdFloat s, c;
+	jlMath::SinCos(angle, &s, &c);
+	jlQuaternion q;
+	if (angle < jlSimdFloat(SLERP_EPSILON)) {
+		q.vec = axis;
+	} else {
+		q.vec = axis * (s / angle);
+	}
+	q.vec.setElem<3>(c);
+	return q;
+}
@@ -0,0 +1,67 @@
+#include "math/jlTrigTable.h"
+
+namespace {
+	const int32 DEFAULT_TABLE_UNBUILT = 0;
+	const int32 DEFAULT_TABLE_BUILDING = 1;
+	const int32 DEFAULT_TABLE_READY = 2;
+
+	volatile int32 defaultTableState = DEFAULT_TABLE_UNBUILT;
+	jlTrigTable * volatile defaultTable = JL_NULL;
+}
+
+jlTrigTable::jlTrigTable() : table(JL_NULL), size(0), mask(0), scale(0.0f) { }
+
+jlTrigTable::~jlTrigTable() {
+	release();
+}
+
+jlResult jlTrigTable::init(int32 sz) {
+	JL_ASSERT(!isInit());
+	JL_ASSERT_MSG(sz >= 4 && (sz & (sz - 1)) == 0, "Trig table size must be a power of two!");
+	if (sz < 4 || (sz & (sz - 1)) != 0) {
+		return JL_ERROR;
+	}
+	// cache line aligned, plus the guard entry for linear filtering
+	table = static_cast<float32 *>(jlAllocAligned((sz + 1) * sizeof(float32), 64));
+	if (!table) {
+		return JL_BAD_ALLOC;
+	}
+	size = sz;
+	mask = sz - 1;
+	scale = static_cast<float32>(sz / (2.0 * 3.14159265358979323846));
+	const float64 step = 2.0 * 3.14159265358979323846 / sz;
+	for (int32 i = 0; i < sz; ++i) {
+		table[i] = static_cast<float32>(::sin(step * i));
+	}
+	table[sz] = table[0];
+	return JL_OK;
+}
+
+void jlTrigTable::release() {
+	if (table) {
+		jlFreeAligned(table);
+		table = JL_NULL;
+	}
+	size = 0;
+	mask = 0;
+	scale = 0.0f;
+}
+
+/// The first thread to swap the state builds the table, any others
+/// spin until it is published. Publishing goes through a second
+/// exchange so the table writes are visible before the ready state.
+const jlTrigTable& jlTrigTable::GetDefault(int32 sz) {
+	if (defaultTableState != DEFAULT_TABLE_READY) {
+		if (JL_ATOMIC_COMPARE_EXCHANGE(&defaultTableState, DEFAULT_TABLE_BUILDING, DEFAULT_TABLE_UNBUILT) == DEFAULT_TABLE_UNBUILT) {
+			jlTrigTable *built = new jlTrigTable();
+			if (JL_FAILED(built->init(sz))) {
+				built->init(DEFAULT_SIZE);
+			}
+			defaultTable = built;
+			JL_ATOMIC_COMPARE_EXCHANGE(&defaultTableState, DEFAULT_TABLE_READY, DEFAULT_TABLE_BUILDING);
+		} else {
+			while (defaultTableState != DEFAULT_TABLE_READY) { }
+		}
+	}
+	return *defaultTable;
+}
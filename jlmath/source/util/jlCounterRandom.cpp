@@ -0,0 +1,252 @@
+#include "util/jlCounterRandom.h"
+#include "util/jlRandom.h"
+#include <cstring>
+
+namespace {
+	const uint32 PHILOX_M0 = 0xD2511F53U;
+	const uint32 PHILOX_M1 = 0xCD9E8D57U;
+	// Weyl sequence key bumps, the golden ratio and sqrt(3) - 1
+	const uint32 PHILOX_W0 = 0x9E3779B9U;
+	const uint32 PHILOX_W1 = 0xBB67AE85U;
+	const int32 PHILOX_ROUNDS = 10;
+	// blocks encrypted together by the bulk fills
+	const int32 PHILOX_LANES = 4;
+}
+
+#if (JL_SIMD_ENABLED) // SIMD version of the Philox rounds
+namespace {
+	/// One block per register for the single draws.  One mul_epu32 gives
+	/// both 64 bit products, lo0 hi0 lo1 hi1, which are reversed into
+	/// hi1 lo1 hi0 lo0 and the odd lanes of the counter and the key are
+	/// xored onto the high halves
+	quadint128 PhiloxBlock(quadint128 x, uint32 k0, uint32 k1) {
+		const quadint128 multiplier = _mm_set_epi32(0, PHILOX_M1, 0, PHILOX_M0);
+		const quadint128 evenMask = _mm_set_epi32(0, -1, 0, -1);
+		for (int32 round = 0; round < PHILOX_ROUNDS; ++round) {
+			const quadint128 roundKey = _mm_set_epi32(0, k1, 0, k0);
+			quadint128 product = _mm_mul_epu32(x, multiplier);
+			quadint128 odd = _mm_and_si128(_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 1)), evenMask);
+			x = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi32(product, _MM_SHUFFLE(0, 1, 2, 3)), odd), roundKey);
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+		return x;
+	}
+
+	/// Low and high words of x times m in all four lanes, one mul_epu32
+	/// for the even lanes and one for the odd
+	JL_FORCE_INLINE void MulHiLo(const quadint128& x, const quadint128& m, quadint128& hi, quadint128& lo) {
+		const quadint128 evenMask = _mm_set_epi32(0, -1, 0, -1);
+		const quadint128 even = _mm_mul_epu32(x, m);
+		const quadint128 odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), m);
+		lo = _mm_or_si128(_mm_and_si128(even, evenMask), _mm_slli_epi64(odd, 32));
+		hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(evenMask, odd));
+	}
+
+	/// PHILOX_LANES blocks from counter c on, held word by word so x0
+	/// is word 0 of all four counters and a round is two MulHiLo.  The
+	/// words are transposed back into blocks on the way out.
+	void PhiloxBlocks(uint64 c, uint32 k0, uint32 k1, uint32 *out) {
+		quadint128 x0 = _mm_set_epi32(static_cast<int32>(c + 3), static_cast<int32>(c + 2), static_cast<int32>(c + 1), static_cast<int32>(c));
+		quadint128 x1 = _mm_set_epi32(static_cast<int32>((c + 3) >> 32), static_cast<int32>((c + 2) >> 32), static_cast<int32>((c + 1) >> 32), static_cast<int32>(c >> 32));
+		quadint128 x2 = _mm_setzero_si128();
+		quadint128 x3 = _mm_setzero_si128();
+		const quadint128 m0 = _mm_set1_epi32(PHILOX_M0);
+		const quadint128 m1 = _mm_set1_epi32(PHILOX_M1);
+		const quadint128 w0 = _mm_set1_epi32(PHILOX_W0);
+		const quadint128 w1 = _mm_set1_epi32(PHILOX_W1);
+		quadint128 key0 = _mm_set1_epi32(k0);
+		quadint128 key1 = _mm_set1_epi32(k1);
+		for (int32 round = 0; round < PHILOX_ROUNDS; ++round) {
+			quadint128 hi0, lo0, hi1, lo1;
+			MulHiLo(x0, m0, hi0, lo0);
+			MulHiLo(x2, m1, hi1, lo1);
+			x0 = _mm_xor_si128(_mm_xor_si128(hi1, x1), key0);
+			x1 = lo1;
+			x2 = _mm_xor_si128(_mm_xor_si128(hi0, x3), key1);
+			x3 = lo0;
+			key0 = _mm_add_epi32(key0, w0);
+			key1 = _mm_add_epi32(key1, w1);
+		}
+		const quadint128 t0 = _mm_unpacklo_epi32(x0, x1);
+		const quadint128 t1 = _mm_unpacklo_epi32(x2, x3);
+		const quadint128 t2 = _mm_unpackhi_epi32(x0, x1);
+		const quadint128 t3 = _mm_unpackhi_epi32(x2, x3);
+		quadint128 *q = reinterpret_cast<quadint128 *>(out);
+		_mm_storeu_si128(q + 0, _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128(q + 1, _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128(q + 2, _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128(q + 3, _mm_unpackhi_epi64(t2, t3));
+	}
+
+	quadint128 MakeCounter(uint64 counter) {
+		return _mm_set_epi32(0, 0, static_cast<int32>(counter >> 32), static_cast<int32>(counter));
+	}
+}
+#else // FPU version of the Philox rounds
+namespace {
+	quadint128 PhiloxBlock(quadint128 x, uint32 k0, uint32 k1) {
+		for (int32 round = 0; round < PHILOX_ROUNDS; ++round) {
+			const uint64 p0 = static_cast<uint64>(PHILOX_M0) * x.v[0];
+			const uint64 p1 = static_cast<uint64>(PHILOX_M1) * x.v[2];
+			const uint32 c1 = x.v[1], c3 = x.v[3];
+			x.v[0] = static_cast<uint32>(p1 >> 32) ^ c1 ^ k0;
+			x.v[1] = static_cast<uint32>(p1);
+			x.v[2] = static_cast<uint32>(p0 >> 32) ^ c3 ^ k1;
+			x.v[3] = static_cast<uint32>(p0);
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+		return x;
+	}
+
+	quadint128 MakeCounter(uint64 counter) {
+		quadint128 x;
+		x.v[0] = static_cast<uint32>(counter);
+		x.v[1] = static_cast<uint32>(counter >> 32);
+		x.v[2] = 0;
+		x.v[3] = 0;
+		return x;
+	}
+
+	void PhiloxBlocks(uint64 c, uint32 k0, uint32 k1, uint32 *out) {
+		for (int32 i = 0; i < PHILOX_LANES; ++i) {
+			quadint128 x = PhiloxBlock(MakeCounter(c + i), k0, k1);
+			memcpy(out + i * jlCounterRandom::BLOCK_SIZE, &x, sizeof(x));
+		}
+	}
+}
+#endif
+
+jlCounterRandom::jlCounterRandom() : key(DEFAULT_SEED), counter(0), idx(BLOCK_SIZE) { }
+
+jlCounterRandom::jlCounterRandom(uint64 k, uint64 c) : key(k), counter(c), idx(BLOCK_SIZE) { }
+
+void jlCounterRandom::seed(uint64 k) {
+	key = k;
+	counter = 0;
+	idx = BLOCK_SIZE;
+}
+
+uint64 jlCounterRandom::getKey() const {
+	return key;
+}
+
+void jlCounterRandom::setCounter(uint64 c) {
+	counter = c;
+	idx = BLOCK_SIZE;
+}
+
+uint64 jlCounterRandom::getCounter() const {
+	return counter;
+}
+
+uint32 jlCounterRandom::randUint32() {
+	if (idx >= BLOCK_SIZE) {
+		quadint128 x = Generate(key, counter++);
+		memcpy(block, &x, sizeof(block));
+		idx = 0;
+	}
+	return block[idx++];
+}
+
+uint32 jlCounterRandom::randUint32(uint32 max) {
+	uint32 rnum;
+	while (!jlRandom::Bounded(randUint32(), max, &rnum)) { }
+	return rnum;
+}
+
+uint32 jlCounterRandom::randUint32(uint32 min, uint32 max) {
+	JL_ASSERT(min <= max);
+	return min + randUint32(max - min);
+}
+
+int32 jlCounterRandom::randInt32() {
+	return static_cast<int32>(randUint32());
+}
+
+int32 jlCounterRandom::randInt32(int32 max) {
+	return static_cast<int32>(randUint32(max));
+}
+
+int32 jlCounterRandom::randInt32(int32 min, int32 max) {
+	JL_ASSERT(min <= max);
+	return static_cast<int32>(randUint32(min, max));
+}
+
+float32 jlCounterRandom::randFloat32() {
+	return jlRandom::ToFloat32(randUint32());
+}
+
+float32 jlCounterRandom::randFloat32(float32 max) {
+	return randFloat32() * max;
+}
+
+float32 jlCounterRandom::randFloat32(float32 min, float32 max) {
+	JL_ASSERT(min <= max);
+	float32 t = randFloat32();
+	return min + (max - min) * t;
+}
+
+void jlCounterRandom::fillUint32(uint32 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	// finish the current block first
+	while (count > 0 && idx < BLOCK_SIZE) {
+		*out++ = block[idx++];
+		--count;
+	}
+	const uint32 k0 = static_cast<uint32>(key), k1 = static_cast<uint32>(key >> 32);
+	const int32 stride = PHILOX_LANES * BLOCK_SIZE;
+	while (count >= stride) {
+		PhiloxBlocks(counter, k0, k1, out);
+		counter += PHILOX_LANES;
+		out += stride;
+		count -= stride;
+	}
+	// the last few whole blocks, the unused ones are generated and dropped
+	if (count >= BLOCK_SIZE) {
+		uint32 tail[PHILOX_LANES * BLOCK_SIZE];
+		const int32 blocks = count / BLOCK_SIZE;
+		PhiloxBlocks(counter, k0, k1, tail);
+		memcpy(out, tail, blocks * BLOCK_SIZE * sizeof(uint32));
+		counter += blocks;
+		out += blocks * BLOCK_SIZE;
+		count -= blocks * BLOCK_SIZE;
+	}
+	while (count > 0) {
+		*out++ = randUint32();
+		--count;
+	}
+}
+
+void jlCounterRandom::fillUint32(uint32 *out, int32 count, uint32 max) {
+	fillUint32(out, count);
+	if (jlRandom::BitsToBounded(out, count, max) > 0) {
+		for (int32 i = 0; i < count; i++) {
+			if (out[i] == max) {
+				out[i] = randUint32(max);
+			}
+		}
+	}
+}
+
+void jlCounterRandom::fillFloat32(float32 *out, int32 count, float32 min, float32 max) {
+	JL_ASSERT(min <= max);
+	fillUint32(reinterpret_cast<uint32 *>(out), count);
+	jlRandom::BitsToFloat32(out, count, min, max);
+}
+
+quadint128 jlCounterRandom::Generate(uint64 k, uint64 c) {
+	return PhiloxBlock(MakeCounter(c), static_cast<uint32>(k), static_cast<uint32>(k >> 32));
+}
+
+uint32 jlCounterRandom::Uint32At(uint64 k, uint64 index) {
+	quadint128 x = Generate(k, index / BLOCK_SIZE);
+	uint32 values[BLOCK_SIZE];
+	memcpy(values, &x, sizeof(values));
+	return values[index % BLOCK_SIZE];
+}
+
+float32 jlCounterRandom::Float32At(uint64 k, uint64 index) {
+	return jlRandom::ToFloat32(Uint32At(k, index));
+}
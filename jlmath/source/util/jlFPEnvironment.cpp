@@ -0,0 +1,70 @@
+#include "util/jlFPEnvironment.h"
+#include <xmmintrin.h>
+#include <cstdio>
+
+namespace {
+	const uint32 MXCSR_FLAGS = 0x003F;
+	const uint32 MXCSR_DAZ = 0x0040;
+	const uint32 MXCSR_ROUNDING_SHIFT = 13;
+	const uint32 MXCSR_ROUNDING = 0x6000;
+	const uint32 MXCSR_FTZ = 0x8000;
+
+	void DefaultReportHandler(const char8 *tag, uint32 exceptions, const char8 *file, int32 line) {
+		printf("FP exceptions in %s (%s%s%s%s%s) File: %s Line: %d\n", tag,
+			(exceptions & jlFPEnvironment::EXCEPTION_INVALID) ? "invalid " : "",
+			(exceptions & jlFPEnvironment::EXCEPTION_DENORMAL) ? "denormal " : "",
+			(exceptions & jlFPEnvironment::EXCEPTION_DIVIDE_BY_ZERO) ? "divide by zero " : "",
+			(exceptions & jlFPEnvironment::EXCEPTION_OVERFLOW) ? "overflow " : "",
+			(exceptions & jlFPEnvironment::EXCEPTION_UNDERFLOW) ? "underflow " : "",
+			file, line);
+	}
+
+	jlFPEnvironment::ReportHandler curReportHandler = DefaultReportHandler;
+}
+
+/// The rounding enum is in MXCSR bit order, nearest, down, up, zero
+jlFPEnvironment::jlFPEnvironment(bool32 flushDenormals, Rounding rounding) : savedControl(_mm_getcsr()) {
+	uint32 control = savedControl & ~(MXCSR_FTZ | MXCSR_DAZ | MXCSR_ROUNDING);
+	if (flushDenormals) {
+		control |= MXCSR_FTZ | MXCSR_DAZ;
+	}
+	control |= static_cast<uint32>(rounding) << MXCSR_ROUNDING_SHIFT;
+	_mm_setcsr(control);
+}
+
+jlFPEnvironment::~jlFPEnvironment() {
+	_mm_setcsr((savedControl & ~MXCSR_FLAGS) | (_mm_getcsr() & MXCSR_FLAGS));
+}
+
+bool32 jlFPEnvironment::IsFlushingDenormals() {
+	return (_mm_getcsr() & (MXCSR_FTZ | MXCSR_DAZ)) == (MXCSR_FTZ | MXCSR_DAZ);
+}
+
+jlFPEnvironment::Rounding jlFPEnvironment::GetRounding() {
+	return static_cast<Rounding>((_mm_getcsr() & MXCSR_ROUNDING) >> MXCSR_ROUNDING_SHIFT);
+}
+
+uint32 jlFPEnvironment::GetExceptions() {
+	return _mm_getcsr() & MXCSR_FLAGS;
+}
+
+void jlFPEnvironment::ClearExceptions() {
+	_mm_setcsr(_mm_getcsr() & ~MXCSR_FLAGS);
+}
+
+uint32 jlFPEnvironment::Sample(const char8 *tag, const char8 *file, int32 line) {
+	uint32 exceptions = GetExceptions() & EXCEPTION_REPORTED;
+	ClearExceptions();
+	if (exceptions && curReportHandler) {
+		curReportHandler(tag, exceptions, file, line);
+	}
+	return exceptions;
+}
+
+void jlFPEnvironment::SetReportHandler(ReportHandler handler) {
+	curReportHandler = handler;
+}
+
+jlFPEnvironment::ReportHandler jlFPEnvironment::GetReportHandler() {
+	return curReportHandler;
+}
@@ -0,0 +1,223 @@
+#include "util/jlFastRandom.h"
+#include "util/jlRandom.h"
+#include "math/jlVector4.h"
+#include <cstring>
+
+namespace {
+	const int32 STATE_WORDS = 4;
+	// xoshiro128 jump polynomial for 2^64 steps, lowest degree first
+	const uint32 JUMP_2_64[STATE_WORDS] = { 0x8764000bU, 0xf542d2d3U, 0x6fa035c3U, 0x77f2db5bU };
+
+	uint64 SplitMix64(uint64 *x) {
+		uint64 z = (*x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+}
+
+#if (JL_SIMD_ENABLED) // SIMD version of the xoshiro128 step
+namespace {
+	void Advance(quadint128 *s) {
+		const quadint128 t = _mm_slli_epi32(s[1], 9);
+		s[2] = _mm_xor_si128(s[2], s[0]);
+		s[3] = _mm_xor_si128(s[3], s[1]);
+		s[1] = _mm_xor_si128(s[1], s[2]);
+		s[0] = _mm_xor_si128(s[0], s[3]);
+		s[2] = _mm_xor_si128(s[2], t);
+		s[3] = _mm_or_si128(_mm_slli_epi32(s[3], 11), _mm_srli_epi32(s[3], 21));
+	}
+
+	// rotl(s0 + s3, 7) + s0 for the four lanes, then steps them
+	void NextOutput(quadint128 *s, uint32 *out) {
+		const quadint128 sum = _mm_add_epi32(s[0], s[3]);
+		const quadint128 result = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(sum, 7), _mm_srli_epi32(sum, 25)), s[0]);
+		_mm_storeu_si128(reinterpret_cast<quadint128 *>(out), result);
+		Advance(s);
+	}
+
+	void Accumulate(quadint128 *acc, const quadint128 *s) {
+		for (int32 k = 0; k < STATE_WORDS; ++k) {
+			acc[k] = _mm_xor_si128(acc[k], s[k]);
+		}
+	}
+}
+#else // FPU version of the xoshiro128 step
+namespace {
+	void Advance(quadint128 *s) {
+		for (int32 l = 0; l < 4; ++l) {
+			const uint32 t = s[1].v[l] << 9;
+			s[2].v[l] ^= s[0].v[l];
+			s[3].v[l] ^= s[1].v[l];
+			s[1].v[l] ^= s[2].v[l];
+			s[0].v[l] ^= s[3].v[l];
+			s[2].v[l] ^= t;
+			s[3].v[l] = (s[3].v[l] << 11) | (s[3].v[l] >> 21);
+		}
+	}
+
+	void NextOutput(quadint128 *s, uint32 *out) {
+		for (int32 l = 0; l < 4; ++l) {
+			const uint32 sum = s[0].v[l] + s[3].v[l];
+			out[l] = ((sum << 7) | (sum >> 25)) + s[0].v[l];
+		}
+		Advance(s);
+	}
+
+	void Accumulate(quadint128 *acc, const quadint128 *s) {
+		for (int32 k = 0; k < STATE_WORDS; ++k) {
+			for (int32 l = 0; l < 4; ++l) {
+				acc[k].v[l] ^= s[k].v[l];
+			}
+		}
+	}
+}
+#endif
+
+jlFastRandom::jlFastRandom() {
+	seed(DEFAULT_SEED);
+}
+
+jlFastRandom::jlFastRandom(uint64 s) {
+	seed(s);
+}
+
+/// splitmix64 fills the words lane by lane, so lane l is the same
+/// xoshiro128 state a scalar generator would get from the same expansion
+void jlFastRandom::seed(uint64 s) {
+	uint32 words[STATE_WORDS][4];
+	for (int32 l = 0; l < 4; ++l) {
+		for (int32 k = 0; k < STATE_WORDS; k += 2) {
+			const uint64 z = SplitMix64(&s);
+			words[k][l] = static_cast<uint32>(z);
+			words[k + 1][l] = static_cast<uint32>(z >> 32);
+		}
+	}
+	memcpy(state, words, sizeof(state));
+	idx = BLOCK_SIZE;
+}
+
+void jlFastRandom::jump() {
+	JL_ALIGN_16 quadint128 acc[STATE_WORDS];
+	memset(acc, 0, sizeof(acc));
+	for (int32 i = 0; i < STATE_WORDS; ++i) {
+		for (int32 b = 0; b < 32; ++b) {
+			if (JUMP_2_64[i] & (1U << b)) {
+				Accumulate(acc, state);
+			}
+			Advance(state);
+		}
+	}
+	memcpy(state, acc, sizeof(state));
+	idx = BLOCK_SIZE;
+}
+
+void jlFastRandom::step(uint32 *out) {
+	NextOutput(state, out);
+}
+
+uint32 jlFastRandom::randUint32() {
+	if (idx >= BLOCK_SIZE) {
+		step(block);
+		idx = 0;
+	}
+	return block[idx++];
+}
+
+uint32 jlFastRandom::randUint32(uint32 max) {
+	uint32 rnum;
+	while (!jlRandom::Bounded(randUint32(), max, &rnum)) { }
+	return rnum;
+}
+
+uint32 jlFastRandom::randUint32(uint32 min, uint32 max) {
+	JL_ASSERT(min <= max);
+	return min + randUint32(max - min);
+}
+
+int32 jlFastRandom::randInt32() {
+	return static_cast<int32>(randUint32());
+}
+
+int32 jlFastRandom::randInt32(int32 max) {
+	return static_cast<int32>(randUint32(max));
+}
+
+int32 jlFastRandom::randInt32(int32 min, int32 max) {
+	JL_ASSERT(min <= max);
+	return static_cast<int32>(randUint32(min, max));
+}
+
+float32 jlFastRandom::randFloat32() {
+	return jlRandom::ToFloat32(randUint32());
+}
+
+float32 jlFastRandom::randFloat32(float32 max) {
+	return randFloat32() * max;
+}
+
+float32 jlFastRandom::randFloat32(float32 min, float32 max) {
+	JL_ASSERT(min <= max);
+	float32 t = randFloat32();
+	return min + (max - min) * t;
+}
+
+jlVector4 jlFastRandom::randVector4() {
+	JL_ALIGN_16 float32 values[BLOCK_SIZE];
+	step(reinterpret_cast<uint32 *>(values));
+	jlRandom::BitsToFloat32(values, BLOCK_SIZE, 0.0f, 1.0f);
+	jlVector4 v;
+	v.loadAligned(values);
+	return v;
+}
+
+jlVector4 jlFastRandom::randVector4(const jlVector4& min, const jlVector4& max) {
+	jlVector4 v = randVector4();
+	v.mul(max - min);
+	v.add(min);
+	return v;
+}
+
+void jlFastRandom::fillUint32(uint32 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	// finish the current block first
+	while (count > 0 && idx < BLOCK_SIZE) {
+		*out++ = block[idx++];
+		--count;
+	}
+	while (count >= BLOCK_SIZE) {
+		step(out);
+		out += BLOCK_SIZE;
+		count -= BLOCK_SIZE;
+	}
+	while (count > 0) {
+		*out++ = randUint32();
+		--count;
+	}
+}
+
+void jlFastRandom::fillUint32(uint32 *out, int32 count, uint32 max) {
+	fillUint32(out, count);
+	if (jlRandom::BitsToBounded(out, count, max) > 0) {
+		for (int32 i = 0; i < count; i++) {
+			if (out[i] == max) {
+				out[i] = randUint32(max);
+			}
+		}
+	}
+}
+
+void jlFastRandom::fillFloat32(float32 *out, int32 count, float32 min, float32 max) {
+	JL_ASSERT(min <= max);
+	fillUint32(reinterpret_cast<uint32 *>(out), count);
+	jlRandom::BitsToFloat32(out, count, min, max);
+}
+
+void jlFastRandom::fillVector4(jlVector4 *out, int32 count, const jlVector4& min, const jlVector4& max) {
+	fillFloat32(reinterpret_cast<float32 *>(out), count * 4);
+	const jlVector4 range = max - min;
+	for (int32 i = 0; i < count; i++) {
+		out[i].mul(range);
+		out[i].add(min);
+	}
+}
@@ -35,6 +35,7 @@ bool8 jlMemoryIsAligned(void *ptr, size_t sz, size_t alignment) {
 	return (((uintptr_t)ptr & (alignment - 1)) == 0) && (((uintptr_t)sz & (alignment - 1)) == 0);
 }
 
+#if (JL_COMPILER == JL_COMPILER_MSVC) || defined(__MINGW32__)
 void * jlAllocAligned(size_t sz, size_t alignment) {
 	return _aligned_malloc(sz, alignment);
 }
@@ -42,3 +43,205 @@ void * jlAllocAligned(size_t sz, size_t alignment) {
 void jlFreeAligned(void *ptr) {
 	_aligned_free(ptr);
 }
+#else
+void * jlAllocAligned(size_t sz, size_t alignment) {
+	// posix_memalign wants at least pointer alignment
+	if (alignment < sizeof(void *)) {
+		alignment = sizeof(void *);
+	}
+	void *ptr = JL_NULL;
+	if (posix_memalign(&ptr, alignment, sz) != 0) {
+		return JL_NULL;
+	}
+	return ptr;
+}
+
+void jlFreeAligned(void *ptr) {
+	free(ptr);
+}
+#endif
+
+namespace {
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	// a free list head is the top block's pointer in the low bits and a
+	// tag in the high bits, bumped by every change so a pop that read a
+	// block which was popped and pushed back in the meantime fails its CAS.
+	// One cache line per list so threads on different classes do not share.
+	struct JL_ALIGN(64) FreeList {
+		volatile uint64 head;
+	};
+
+	const size_t CHUNK_SIZE = 16 * 1024;
+	const size_t CHUNK_ALIGNMENT = 64;
+	// the first line of every chunk links it into the chunk list
+	const size_t CHUNK_HEADER = 64;
+
+	const int32 NUM_CLASSES = 8;
+	// blocks sit at CHUNK_HEADER + i * size in a 64 aligned chunk, so each
+	// class is aligned to the largest power of 2 dividing its size
+	const size_t CLASS_SIZE[NUM_CLASSES] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+	const size_t CLASS_ALIGNMENT[NUM_CLASSES] = { 16, 32, 16, 64, 32, 64, 64, 64 };
+
+	FreeList freeLists[NUM_CLASSES];
+	FreeList chunkList;
+
+	// hits and frees are on the fast path, a second locked add there costs
+	// as much as the CAS, so only debug builds pay for counting them
+#ifdef JL_DEBUG
+#	define JL_MEMORY_COUNT_FAST(counter) JL_ATOMIC_ADD(&(counter), 1)
+#else
+#	define JL_MEMORY_COUNT_FAST(counter)
+#endif
+
+	volatile int32 cacheHits;
+	volatile int32 cacheMisses;
+	volatile int32 cacheFrees;
+	volatile int32 cacheChunks;
+	volatile int32 uncachedAllocs;
+
+	// 32 bit pointers leave a 32 bit tag, 64 bit ones use the 48 bits of
+	// address x64 actually has and a 16 bit tag
+	const int32 TAG_SHIFT = sizeof(void *) == 4 ? 32 : 48;
+	const uint64 POINTER_MASK = (static_cast<uint64>(1) << TAG_SHIFT) - 1;
+
+	uint64 Pack(FreeBlock *block, uint64 tag) {
+		return (tag << TAG_SHIFT) | (static_cast<uint64>(reinterpret_cast<uintptr_t>(block)) & POINTER_MASK);
+	}
+
+	FreeBlock * Top(uint64 head) {
+		return reinterpret_cast<FreeBlock *>(static_cast<uintptr_t>(head & POINTER_MASK));
+	}
+
+	uint64 Tag(uint64 head) {
+		return head >> TAG_SHIFT;
+	}
+
+	// on x86-32 the two halves may come from different heads, but each
+	// half is whole, so top is a block that was on the list and the CAS
+	// rejects the mismatch
+	uint64 Load(FreeList *list) {
+		return list->head;
+	}
+
+	FreeBlock * Pop(FreeList *list) {
+		uint64 head = Load(list);
+		for (;;) {
+			FreeBlock *top = Top(head);
+			if (top == JL_NULL) {
+				return JL_NULL;
+			}
+			// top may already belong to someone else, but chunks are never
+			// unmapped while the cache is live and the CAS rejects a stale next
+			const uint64 next = Pack(top->next, Tag(head) + 1);
+			const uint64 seen = JL_ATOMIC_COMPARE_EXCHANGE64(&list->head, next, head);
+			if (seen == head) {
+				return top;
+			}
+			head = seen;
+		}
+	}
+
+	// pushes the already linked chain first..last in one CAS
+	void Push(FreeList *list, FreeBlock *first, FreeBlock *last) {
+		uint64 head = Load(list);
+		for (;;) {
+			last->next = Top(head);
+			const uint64 next = Pack(first, Tag(head) + 1);
+			const uint64 seen = JL_ATOMIC_COMPARE_EXCHANGE64(&list->head, next, head);
+			if (seen == head) {
+				return;
+			}
+			head = seen;
+		}
+	}
+
+	int32 SizeClass(size_t sz, size_t alignment) {
+		for (int32 c = 0; c < NUM_CLASSES; ++c) {
+			if (CLASS_SIZE[c] >= sz && CLASS_ALIGNMENT[c] >= alignment) {
+				return c;
+			}
+		}
+		return -1;
+	}
+
+	// carves a fresh chunk into blocks of class c, returns one and frees
+	// the rest onto the class list
+	void * Refill(int32 c) {
+		uint8 *chunk = static_cast<uint8 *>(jlAllocAligned(CHUNK_SIZE, CHUNK_ALIGNMENT));
+		if (chunk == JL_NULL) {
+			return JL_NULL;
+		}
+		FreeBlock *header = reinterpret_cast<FreeBlock *>(chunk);
+		Push(&chunkList, header, header);
+		JL_ATOMIC_ADD(&cacheChunks, 1);
+
+		const size_t size = CLASS_SIZE[c];
+		const size_t count = (CHUNK_SIZE - CHUNK_HEADER) / size;
+		uint8 *blocks = chunk + CHUNK_HEADER;
+		for (size_t i = 1; i + 1 < count; ++i) {
+			reinterpret_cast<FreeBlock *>(blocks + i * size)->next = reinterpret_cast<FreeBlock *>(blocks + (i + 1) * size);
+		}
+		Push(&freeLists[c], reinterpret_cast<FreeBlock *>(blocks + size), reinterpret_cast<FreeBlock *>(blocks + (count - 1) * size));
+		return blocks;
+	}
+}
+
+void * jlAllocAlignedCached(size_t sz, size_t alignment) {
+	const int32 c = SizeClass(sz, alignment);
+	if (c < 0) {
+		JL_ATOMIC_ADD(&uncachedAllocs, 1);
+		return jlAllocAligned(sz, alignment);
+	}
+	void *ptr = Pop(&freeLists[c]);
+	if (ptr != JL_NULL) {
+		JL_MEMORY_COUNT_FAST(cacheHits);
+		return ptr;
+	}
+	JL_ATOMIC_ADD(&cacheMisses, 1);
+	return Refill(c);
+}
+
+void jlFreeAlignedCached(void *ptr, size_t sz, size_t alignment) {
+	if (ptr == JL_NULL) {
+		return;
+	}
+	const int32 c = SizeClass(sz, alignment);
+	if (c < 0) {
+		jlFreeAligned(ptr);
+		return;
+	}
+	JL_ASSERT_MSG(jlMemoryIsAligned(ptr, 0, CLASS_ALIGNMENT[c]), "block was not allocated with jlAllocAlignedCached");
+	FreeBlock *block = static_cast<FreeBlock *>(ptr);
+	Push(&freeLists[c], block, block);
+	JL_MEMORY_COUNT_FAST(cacheFrees);
+}
+
+void jlMemoryReleaseCache() {
+	for (int32 c = 0; c < NUM_CLASSES; ++c) {
+		freeLists[c].head = 0;
+	}
+	FreeBlock *chunk;
+	while ((chunk = Pop(&chunkList)) != JL_NULL) {
+		jlFreeAligned(chunk);
+		JL_ATOMIC_ADD(&cacheChunks, -1);
+	}
+}
+
+void jlMemoryGetStats(jlMemoryStats *stats) {
+	JL_ASSERT(stats != JL_NULL);
+	stats->cacheHits = cacheHits;
+	stats->cacheMisses = cacheMisses;
+	stats->cacheFrees = cacheFrees;
+	stats->cacheChunks = cacheChunks;
+	stats->uncachedAllocs = uncachedAllocs;
+}
+
+void jlMemoryResetStats() {
+	cacheHits = 0;
+	cacheMisses = 0;
+	cacheFrees = 0;
+	uncachedAllocs = 0;
+}
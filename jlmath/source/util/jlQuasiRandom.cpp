@@ -0,0 +1,527 @@
+#include "util/jlQuasiRandom.h"
+#include "util/jlRandom.h"
+#include "math/jlVector4.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+	typedef uint32 (*jlDirectionTable)[jlSobol::MAX_DIMENSIONS];
+	typedef const uint32 (*jlConstDirectionTable)[jlSobol::MAX_DIMENSIONS];
+
+	/// Primitive polynomial degree s, its inner coefficients a and the
+	/// initial direction numbers m_1..m_s of one Sobol dimension
+	struct jlSobolPolynomial {
+		int32 degree;
+		uint32 coeffs;
+		uint32 m[8];
+	};
+
+	// new-joe-kuo-6.21201, dimensions 2 to 32, the first is van der Corput
+	const jlSobolPolynomial SOBOL_POLYNOMIALS[jlSobol::MAX_DIMENSIONS - 1] = {
+		{ 1,  0, { 1 } },
+		{ 2,  1, { 1, 3 } },
+		{ 3,  1, { 1, 3, 1 } },
+		{ 3,  2, { 1, 1, 1 } },
+		{ 4,  1, { 1, 1, 3, 3 } },
+		{ 4,  4, { 1, 3, 5, 13 } },
+		{ 5,  2, { 1, 1, 5, 5, 17 } },
+		{ 5,  4, { 1, 1, 5, 5, 5 } },
+		{ 5,  7, { 1, 1, 7, 11, 19 } },
+		{ 5, 11, { 1, 1, 5, 1, 1 } },
+		{ 5, 13, { 1, 1, 1, 3, 11 } },
+		{ 5, 14, { 1, 3, 5, 5, 31 } },
+		{ 6,  1, { 1, 3, 3, 9, 7, 49 } },
+		{ 6, 13, { 1, 1, 1, 15, 21, 21 } },
+		{ 6, 16, { 1, 3, 1, 13, 27, 49 } },
+		{ 6, 19, { 1, 1, 1, 15, 7, 5 } },
+		{ 6, 22, { 1, 3, 1, 15, 13, 25 } },
+		{ 6, 25, { 1, 1, 5, 5, 19, 61 } },
+		{ 7,  1, { 1, 3, 7, 11, 23, 15, 103 } },
+		{ 7,  4, { 1, 3, 7, 13, 13, 15, 69 } },
+		{ 7,  7, { 1, 1, 3, 13, 7, 35, 63 } },
+		{ 7,  8, { 1, 3, 5, 9, 1, 25, 53 } },
+		{ 7, 14, { 1, 3, 1, 13, 9, 35, 107 } },
+		{ 7, 19, { 1, 3, 1, 5, 27, 61, 31 } },
+		{ 7, 21, { 1, 1, 5, 11, 19, 41, 61 } },
+		{ 7, 28, { 1, 3, 5, 3, 3, 13, 69 } },
+		{ 7, 31, { 1, 1, 7, 13, 1, 19, 1 } },
+		{ 7, 32, { 1, 3, 7, 5, 13, 19, 59 } },
+		{ 7, 37, { 1, 1, 3, 9, 25, 29, 41 } },
+		{ 7, 41, { 1, 3, 5, 13, 23, 1, 55 } },
+		{ 7, 42, { 1, 3, 7, 3, 13, 59, 17 } }
+	};
+
+	const uint32 HALTON_PRIMES[jlHalton::MAX_DIMENSIONS] = {
+		2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+		59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+	};
+
+	// the largest float below 1, a rotation can round up to 1 otherwise
+	const float32 BELOW_ONE = 0.99999994f;
+
+	/// Top 24 bits over 2^24, exact in a float and always below 1
+	float32 UnitFromBits(uint32 x) {
+		return static_cast<float32>(x >> 8) * (1.0f / 16777216.0f);
+	}
+
+	int32 TrailingZeros(uint32 x) {
+		JL_ASSERT(x != 0);
+		int32 n = 0;
+		while ((x & 1) == 0) {
+			x >>= 1;
+			++n;
+		}
+		return n;
+	}
+
+	/// Bit j's direction number is m_j shifted to the top for j < s, then
+	/// v_j = v_(j-s) ^ (v_(j-s) >> s) ^ the a-selected v_(j-k)
+	void BuildDirections(jlDirectionTable direction, int32 dimensions) {
+		memset(direction, 0, jlSobol::BITS * jlSobol::MAX_DIMENSIONS * sizeof(uint32));
+		for (int32 j = 0; j < jlSobol::BITS; ++j) {
+			direction[j][0] = 0x80000000U >> j;
+		}
+		for (int32 d = 1; d < dimensions; ++d) {
+			const jlSobolPolynomial& p = SOBOL_POLYNOMIALS[d - 1];
+			const int32 s = p.degree;
+			for (int32 j = 0; j < s; ++j) {
+				direction[j][d] = p.m[j] << (31 - j);
+			}
+			for (int32 j = s; j < jlSobol::BITS; ++j) {
+				uint32 v = direction[j - s][d] ^ (direction[j - s][d] >> s);
+				for (int32 k = 1; k < s; ++k) {
+					if ((p.coeffs >> (s - 1 - k)) & 1) {
+						v ^= direction[j - k][d];
+					}
+				}
+				direction[j][d] = v;
+			}
+		}
+	}
+
+	/// Multiplies every direction number of dimension d by a random lower
+	/// triangular bit matrix with a unit diagonal, digit k of a value adds
+	/// column k into the result and column k only reaches digits below it
+	void ScrambleDirections(jlDirectionTable direction, int32 d, jlRandom& random) {
+		uint32 columns[jlSobol::BITS];
+		for (int32 k = 0; k < jlSobol::BITS; ++k) {
+			const uint32 diagonal = 0x80000000U >> k;
+			columns[k] = diagonal | (random.randUint32() & (diagonal - 1));
+		}
+		for (int32 j = 0; j < jlSobol::BITS; ++j) {
+			const uint32 v = direction[j][d];
+			uint32 scrambled = 0;
+			for (int32 k = 0; k < jlSobol::BITS; ++k) {
+				if (v & (0x80000000U >> k)) {
+					scrambled ^= columns[k];
+				}
+			}
+			direction[j][d] = scrambled;
+		}
+	}
+
+	// one Sobol point of dimension d, x moves on to the next index
+	float32 SobolStep(uint32 *x, uint32 shift, jlConstDirectionTable direction, int32 d, uint32 index) {
+		const float32 value = UnitFromBits(*x ^ shift);
+		*x ^= direction[TrailingZeros(index + 1)][d];
+		return value;
+	}
+
+	float32 KroneckerValue(uint64 x) {
+		return UnitFromBits(static_cast<uint32>(x >> 32));
+	}
+}
+
+#if (JL_SIMD_ENABLED) // SIMD version of the sequence runs
+namespace {
+	quad128 UnitFromBits4(const quadint128& x) {
+		return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), _mm_set1_ps(1.0f / 16777216.0f));
+	}
+
+	/// count points of dimension d from index, x is its value there and the
+	/// value at index + count is returned.  Runs of four start on a
+	/// multiple of four, where the lanes are x ^ {0, v0, v0 ^ v1, v1} and
+	/// the next run is x ^ v1 ^ v_(2 + ctz(q + 1)).
+	uint32 SobolRun(uint32 x, uint32 shift, jlConstDirectionTable direction, int32 d, uint32 index, float32 *out, int32 count) {
+		int32 i = 0;
+		for (; i < count && (index & 3) != 0; ++i, ++index) {
+			out[i] = SobolStep(&x, shift, direction, d, index);
+		}
+		const uint32 v0 = direction[0][d], v1 = direction[1][d];
+		const quadint128 lanes = _mm_set_epi32(v1, v0 ^ v1, v0, 0);
+		quadint128 xs = _mm_xor_si128(_mm_set1_epi32(x ^ shift), lanes);
+		for (; i + 4 <= count; i += 4, index += 4) {
+			_mm_storeu_ps(out + i, UnitFromBits4(xs));
+			const uint32 step = v1 ^ direction[TrailingZeros(index + 4)][d];
+			xs = _mm_xor_si128(xs, _mm_set1_epi32(step));
+			x ^= step;
+		}
+		for (; i < count; ++i, ++index) {
+			out[i] = SobolStep(&x, shift, direction, d, index);
+		}
+		return x;
+	}
+
+	// dimensions 0 to 3 of count points, one xor of a direction row per point
+	void SobolVectors(const uint32 *current, const uint32 *shift, jlConstDirectionTable direction, uint32 index, jlVector4 *out, int32 count) {
+		quadint128 x = _mm_load_si128(reinterpret_cast<const quadint128 *>(current));
+		const quadint128 s = _mm_load_si128(reinterpret_cast<const quadint128 *>(shift));
+		for (int32 i = 0; i < count; ++i, ++index) {
+			_mm_store_ps(reinterpret_cast<float32 *>(out + i), UnitFromBits4(_mm_xor_si128(x, s)));
+			x = _mm_xor_si128(x, _mm_load_si128(reinterpret_cast<const quadint128 *>(direction[TrailingZeros(index + 1)])));
+		}
+	}
+
+	// the high words of the four 64 bit positions in a and b
+	quad128 KroneckerValues4(const quadint128& a, const quadint128& b) {
+		const quadint128 high = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+		return UnitFromBits4(high);
+	}
+
+	/// count points of one dimension from position x, four at a time as
+	/// two pairs of 64 bit lanes that each step by four alpha
+	void KroneckerRun(uint64 x, uint64 alpha, float32 *out, int32 count) {
+		JL_ALIGN_16 uint64 start[4] = { x, x + alpha, x + 2 * alpha, x + 3 * alpha };
+		const uint64 alpha4 = 4 * alpha;
+		JL_ALIGN_16 uint64 step[2] = { alpha4, alpha4 };
+		quadint128 a = _mm_load_si128(reinterpret_cast<const quadint128 *>(start));
+		quadint128 b = _mm_load_si128(reinterpret_cast<const quadint128 *>(start + 2));
+		const quadint128 inc = _mm_load_si128(reinterpret_cast<const quadint128 *>(step));
+		int32 i = 0;
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(out + i, KroneckerValues4(a, b));
+			a = _mm_add_epi64(a, inc);
+			b = _mm_add_epi64(b, inc);
+		}
+		x += static_cast<uint64>(i) * alpha;
+		for (; i < count; ++i, x += alpha) {
+			out[i] = KroneckerValue(x);
+		}
+	}
+
+	void KroneckerVectors(const uint64 *start, const uint64 *alpha, jlVector4 *out, int32 count) {
+		quadint128 a = _mm_load_si128(reinterpret_cast<const quadint128 *>(start));
+		quadint128 b = _mm_load_si128(reinterpret_cast<const quadint128 *>(start + 2));
+		const quadint128 incA = _mm_load_si128(reinterpret_cast<const quadint128 *>(alpha));
+		const quadint128 incB = _mm_load_si128(reinterpret_cast<const quadint128 *>(alpha + 2));
+		for (int32 i = 0; i < count; ++i) {
+			_mm_store_ps(reinterpret_cast<float32 *>(out + i), KroneckerValues4(a, b));
+			a = _mm_add_epi64(a, incA);
+			b = _mm_add_epi64(b, incB);
+		}
+	}
+}
+#else // FPU version of the sequence runs
+namespace {
+	uint32 SobolRun(uint32 x, uint32 shift, jlConstDirectionTable direction, int32 d, uint32 index, float32 *out, int32 count) {
+		for (int32 i = 0; i < count; ++i, ++index) {
+			out[i] = SobolStep(&x, shift, direction, d, index);
+		}
+		return x;
+	}
+
+	void SobolVectors(const uint32 *current, const uint32 *shift, jlConstDirectionTable direction, uint32 index, jlVector4 *out, int32 count) {
+		uint32 x[4] = { current[0], current[1], current[2], current[3] };
+		for (int32 i = 0; i < count; ++i, ++index) {
+			float32 *values = reinterpret_cast<float32 *>(out + i);
+			const uint32 *row = direction[TrailingZeros(index + 1)];
+			for (int32 l = 0; l < 4; ++l) {
+				values[l] = UnitFromBits(x[l] ^ shift[l]);
+				x[l] ^= row[l];
+			}
+		}
+	}
+
+	void KroneckerRun(uint64 x, uint64 alpha, float32 *out, int32 count) {
+		for (int32 i = 0; i < count; ++i, x += alpha) {
+			out[i] = KroneckerValue(x);
+		}
+	}
+
+	void KroneckerVectors(const uint64 *start, const uint64 *alpha, jlVector4 *out, int32 count) {
+		uint64 x[4] = { start[0], start[1], start[2], start[3] };
+		for (int32 i = 0; i < count; ++i) {
+			float32 *values = reinterpret_cast<float32 *>(out + i);
+			for (int32 l = 0; l < 4; ++l) {
+				values[l] = KroneckerValue(x[l]);
+				x[l] += alpha[l];
+			}
+		}
+	}
+}
+#endif
+
+jlSobol::jlSobol() {
+	init(1);
+}
+
+jlSobol::jlSobol(int32 d) {
+	init(d);
+}
+
+void jlSobol::init(int32 d) {
+	JL_ASSERT_MSG(d >= 1 && d <= MAX_DIMENSIONS, "Sobol dimensions must be 1 to MAX_DIMENSIONS!");
+	dimensions = d;
+	BuildDirections(direction, dimensions);
+	memset(shift, 0, sizeof(shift));
+	setIndex(0);
+}
+
+void jlSobol::randomize(jlRandom& random) {
+	BuildDirections(direction, dimensions);
+	for (int32 d = 0; d < dimensions; ++d) {
+		ScrambleDirections(direction, d, random);
+		shift[d] = random.randUint32();
+	}
+	setIndex(index);
+}
+
+int32 jlSobol::getDimensions() const {
+	return dimensions;
+}
+
+uint32 jlSobol::getIndex() const {
+	return index;
+}
+
+void jlSobol::setIndex(uint32 i) {
+	index = i;
+	const uint32 gray = i ^ (i >> 1);
+	for (int32 d = 0; d < MAX_DIMENSIONS; ++d) {
+		uint32 x = 0;
+		for (int32 j = 0; j < BITS; ++j) {
+			if ((gray >> j) & 1) {
+				x ^= direction[j][d];
+			}
+		}
+		current[d] = x;
+	}
+}
+
+void jlSobol::next(float32 *out) {
+	JL_ASSERT(index < UINT32_MAX);
+	const uint32 *row = direction[TrailingZeros(index + 1)];
+	for (int32 d = 0; d < dimensions; ++d) {
+		out[d] = UnitFromBits(current[d] ^ shift[d]);
+		current[d] ^= row[d];
+	}
+	++index;
+}
+
+jlVector4 jlSobol::nextVector4() {
+	JL_ALIGN_16 float32 values[MAX_DIMENSIONS] = { 0.0f };
+	next(values);
+	jlVector4 v;
+	v.loadAligned(values);
+	return v;
+}
+
+void jlSobol::fillVector4(jlVector4 *out, int32 count) {
+	JL_ASSERT(count >= 0 && static_cast<uint32>(count) < UINT32_MAX - index);
+	SobolVectors(current, shift, direction, index, out, count);
+	// the other dimensions jump to the end rather than stepping
+	setIndex(index + count);
+}
+
+void jlSobol::fillSoA(float32 *out, int32 count) {
+	JL_ASSERT(count >= 0 && static_cast<uint32>(count) < UINT32_MAX - index);
+	for (int32 d = 0; d < dimensions; ++d) {
+		current[d] = SobolRun(current[d], shift[d], direction, d, index, out + d * count, count);
+	}
+	index += count;
+}
+
+jlHalton::jlHalton() {
+	init(1);
+}
+
+jlHalton::jlHalton(int32 d) {
+	init(d);
+}
+
+void jlHalton::init(int32 d) {
+	JL_ASSERT_MSG(d >= 1 && d <= MAX_DIMENSIONS, "Halton dimensions must be 1 to MAX_DIMENSIONS!");
+	dimensions = d;
+	for (int32 k = 0; k < dimensions; ++k) {
+		// enough digits that every uint32 index fits, base^digits <= 131 * 2^32
+		const uint64 base = HALTON_PRIMES[k];
+		uint64 power = 1;
+		while (power <= UINT32_MAX) {
+			power *= base;
+		}
+		topWeight[k] = power / base;
+		scale[k] = 1.0 / static_cast<float64>(power);
+		offset[k] = 0.0;
+	}
+	setIndex(0);
+}
+
+void jlHalton::randomize(jlRandom& random) {
+	for (int32 d = 0; d < dimensions; ++d) {
+		offset[d] = random.randUint32() * (1.0 / 4294967296.0);
+	}
+}
+
+int32 jlHalton::getDimensions() const {
+	return dimensions;
+}
+
+uint32 jlHalton::getIndex() const {
+	return index;
+}
+
+void jlHalton::setIndex(uint32 i) {
+	index = i;
+	for (int32 d = 0; d < dimensions; ++d) {
+		const uint32 base = HALTON_PRIMES[d];
+		memset(digits[d], 0, sizeof(digits[d]));
+		numerator[d] = 0;
+		uint64 weight = topWeight[d];
+		for (uint32 n = i, j = 0; n > 0; n /= base, ++j, weight /= base) {
+			digits[d][j] = static_cast<uint8>(n % base);
+			numerator[d] += digits[d][j] * weight;
+		}
+	}
+}
+
+float32 jlHalton::value(int32 d) const {
+	float64 x = static_cast<float64>(numerator[d]) * scale[d] + offset[d];
+	if (x >= 1.0) x -= 1.0;
+	const float32 f = static_cast<float32>(x);
+	return (f < 1.0f) ? f : BELOW_ONE;
+}
+
+/// Adds one to the index digits, each carry takes (base - 1) of its
+/// weight back off the numerator and the digit that stops it adds one
+void jlHalton::step(int32 d) {
+	const uint32 top = HALTON_PRIMES[d] - 1;
+	uint64 weight = topWeight[d];
+	int32 j = 0;
+	while (digits[d][j] == top) {
+		digits[d][j] = 0;
+		numerator[d] -= top * weight;
+		weight /= HALTON_PRIMES[d];
+		++j;
+		JL_ASSERT(j < MAX_DIGITS);
+	}
+	++digits[d][j];
+	numerator[d] += weight;
+}
+
+void jlHalton::next(float32 *out) {
+	JL_ASSERT(index < UINT32_MAX);
+	for (int32 d = 0; d < dimensions; ++d) {
+		out[d] = value(d);
+		step(d);
+	}
+	++index;
+}
+
+jlVector4 jlHalton::nextVector4() {
+	JL_ALIGN_16 float32 values[MAX_DIMENSIONS] = { 0.0f };
+	next(values);
+	jlVector4 v;
+	v.loadAligned(values);
+	return v;
+}
+
+void jlHalton::fillVector4(jlVector4 *out, int32 count) {
+	JL_ALIGN_16 float32 values[MAX_DIMENSIONS] = { 0.0f };
+	for (int32 i = 0; i < count; ++i) {
+		next(values);
+		out[i].loadAligned(values);
+	}
+}
+
+void jlHalton::fillSoA(float32 *out, int32 count) {
+	JL_ASSERT(count >= 0 && static_cast<uint32>(count) < UINT32_MAX - index);
+	for (int32 i = 0; i < count; ++i) {
+		for (int32 d = 0; d < dimensions; ++d) {
+			out[d * count + i] = value(d);
+			step(d);
+		}
+	}
+	index += count;
+}
+
+jlKronecker::jlKronecker() {
+	init(2);
+}
+
+jlKronecker::jlKronecker(int32 d) {
+	init(d);
+}
+
+/// phi by Newton from 2, which is above the root and where the
+/// polynomial is convex, so the iterates fall monotonically onto it
+void jlKronecker::init(int32 d) {
+	JL_ASSERT_MSG(d >= 1 && d <= MAX_DIMENSIONS, "Kronecker dimensions must be 1 to MAX_DIMENSIONS!");
+	dimensions = d;
+	float64 phi = 2.0;
+	for (int32 it = 0; it < 64; ++it) {
+		const float64 f = pow(phi, d + 1) - phi - 1.0;
+		const float64 df = (d + 1) * pow(phi, d) - 1.0;
+		phi -= f / df;
+	}
+	memset(alpha, 0, sizeof(alpha));
+	memset(offset, 0, sizeof(offset));
+	float64 a = 1.0;
+	for (int32 k = 0; k < dimensions; ++k) {
+		a /= phi;
+		// 0.64 fixed point, a is below 1 so the product fits
+		alpha[k] = static_cast<uint64>(a * 18446744073709551616.0);
+	}
+	index = 0;
+}
+
+void jlKronecker::randomize(jlRandom& random) {
+	for (int32 d = 0; d < dimensions; ++d) {
+		offset[d] = (static_cast<uint64>(random.randUint32()) << 32) | random.randUint32();
+	}
+}
+
+int32 jlKronecker::getDimensions() const {
+	return dimensions;
+}
+
+uint32 jlKronecker::getIndex() const {
+	return index;
+}
+
+void jlKronecker::setIndex(uint32 i) {
+	index = i;
+}
+
+void jlKronecker::next(float32 *out) {
+	for (int32 d = 0; d < dimensions; ++d) {
+		out[d] = KroneckerValue(offset[d] + index * alpha[d]);
+	}
+	++index;
+}
+
+jlVector4 jlKronecker::nextVector4() {
+	JL_ALIGN_16 float32 values[MAX_DIMENSIONS] = { 0.0f };
+	next(values);
+	jlVector4 v;
+	v.loadAligned(values);
+	return v;
+}
+
+void jlKronecker::fillVector4(jlVector4 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ALIGN_16 uint64 start[4];
+	for (int32 d = 0; d < 4; ++d) {
+		// unused dimensions have no alpha or offset and stay at 0
+		start[d] = offset[d] + index * alpha[d];
+	}
+	KroneckerVectors(start, alpha, out, count);
+	index += count;
+}
+
+void jlKronecker::fillSoA(float32 *out, int32 count) {
+	JL_ASSERT(count >= 0);
+	for (int32 d = 0; d < dimensions; ++d) {
+		KroneckerRun(offset[d] + index * alpha[d], alpha[d], out + d * count, count);
+	}
+	index += count;
+}
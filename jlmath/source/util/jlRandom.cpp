@@ -1,8 +1,17 @@
 #include "util/jlRandom.h"
+#include "util/jlDistribution.h"
+#include <cstring>
 
 namespace {
 	const uint8 JL_RANDOM_FLAGS_NONE = 0;
 	const uint8 JL_RANDOM_FLAGS_OWNS_BUFFER = 1;
+	// buffer and backBuffer are exchanged from how they were allocated
+	const uint8 JL_RANDOM_FLAGS_SWAPPED = 2;
+
+	// quads of the back buffer generated per BACK_STEP_DRAWS draws, one
+	// quad per four draws keeps it exactly one buffer ahead
+	const int32 BACK_STEP_QUADS = 4;
+	const int32 BACK_STEP_DRAWS = 16;
 
 	const uint32 MSK1 = 0xdfffffefU;
 	const uint32 MSK2 = 0xddfecb7fU;
@@ -17,6 +26,62 @@ namespace {
 	const uint32 PARITY2 = 0x00000000U;
 	const uint32 PARITY3 = 0x00000000U;
 	const uint32 PARITY4 = 0xc98e126aU;
+
+	// x^(2^128) mod the characteristic polynomial of the SFMT19937 state
+	// transition, lowest degree first, four coefficients per hex digit
+	const char8 JUMP_2_128[] =
+		"c5ecf0b605bcbebf05a6ae430dc3cd1777acaff2b99fe5221eaa2a2c8acf0ea0b9617d0b4a5e8f94828b6710c0f365e69b690be81b206e04f64a9994b013dc1e"
+		"046fb5e182b3d794fdd3d01d73d1c2aaaa03ce4398cce92cc67ed20c031a607fdca6dce456b8268481c80bcf740a810c5d73dcab943e05e8a2adfe5f81d9f118"
+		"435ceef77fbe3d9d58baa17378e24001fea40b87181de63568f4342c05ddd174a617d1452cfcb4fd1df0dc94802ce7b8c04f21ced8cd34d29771f5cb25471704"
+		"d2bfc8abc2acc47f10d9f72f781556c62e4a089f44c63d4a2d7b3541fe07c197c0bd10178c2a81fa7888d0ddc777502f8dda122e3bf335e365f0e70be77f0383"
+		"bf2d0b5ba5c1ab9cd94288e59f086262c42bde8f832819e9fa1467661d68ff8ed3edd81c8aa6c268a72bcafbc3ab20c1ecb1799988abf25a6b9b4262bf93fbd2"
+		"ef44fe16e6a2702e57b8d1f0468a58a85cc74f2a75d18b3373cfc47cfd028f70ea8e6a5ef2e871b929b47f4fd1ffe3be9c4c89ac6c2c135fd1f410c8e0e9e55e"
+		"4a75891f00e3a48f6a4a48b1e12f9032675e4942c502241e3d75b34fe803d6cd4e33709cb2632a4fe42c7a94d1a57b166f1a9d19e58bc7d904740df1bca2481a"
+		"01e6f390d647353dd18dc1ba77ac5334e3e0037413f2f41d33941ecfdd1cbdf0cbe4ad3c08ac47ec03c440971327b1631a8742ef3fa2d2fa7e76af3de0216f52"
+		"d7f44d0efcaf927f54b673a0ade6910f7fb86da9ef4f3715d84fcd2159b3133371bdbf6e888276e238e3b03ee0c255000ae8914736f597f7222c1764eb1b13a9"
+		"447c406257b23e707576b0456b76fc414a75620093e8f7017ac980a867f1221c1eb0979d14032c0838d976cf5d139b1c5a610ab09f117776c2167b201056b7f0"
+		"cc246232d183c207ae38dd8d0fccc302b034bcdeb4976b2b8864cc5fc2f162b72b55f3ee9cd28fd4f271063d4a58e3a66698d56487651dbf7a135b383adb7166"
+		"1d188f6c39521381dbc3b2bd01041f2ebd396f9f76511cffc7ef7897903bdee6c086e193c541ebb401dca2d28d779000a2d69740e8f6560477c23b01920175c3"
+		"8604150200ecce4d4ccfd0a6cb6f4f2bf2ab37a3072d4e613356307338ee2e6767b6a83ec6cda267bb1994e099af4067d67d95341a1ca150f7196db5e2209969"
+		"b3d432179a3d8da93f71825bc7b385d960f4b881b30aa6a4cf16a2672eda09b3efea2ed7cbcf77ed405f1aa175c59f5f619a54cc0a437ba97cd8d041a5ca0e75"
+		"534b2e9c61d5ee2e1570945fe276921e18308db9f3a9805d798611f7f496d2b958b6eb4e946d572c471c619565832d20d0e82eae1eef9e1a2472c6c851250c08"
+		"aae4d403558e1fde9c399e324a5e8dede8ca57b4492afda60cea0996508a3567a01a5e6e822bca9ec8ac223bc0534c311ed07eae4bcaed013776ba0bbdb22b8b"
+		"c038b61cb431c8079201e0f8304a439fb8dc1d71050e4d6c93b154a152def253ad808a11dea33c6d797c94ac0eac9b518096ccb85081c2c02a89e32624e700cd"
+		"1ccfa7eb90592afaf886d4f61f1a378ab44f29dd73dfe5ab7a23a8f31a9b6f12639c81d3db851abff93938a60f61b659a481f286ba10339e0409f39885f58b42"
+		"e255ad89d0484763459e03a04097d2427444f59e3d49206f784ef676914f4a4e11b66635881ab05accd0020559a780ebd53999974dae64cfedc4ee856ae2d3b3"
+		"cd5d40337d33115dea8376f07da698f20c11dc86d8203d0d12bf3ae973bfec0700d2337961e1c4c9448cb5730d9457afb1d8891301f3264fd30cba095db3f527"
+		"907c80fca305ea8b9ca2adcdb0e2b2781839a1ebcb7ff5b627ddfcf72170118606e5742be995af9d5e0f31798640f32d6e09438cc75737d6876daa5c0eea191c"
+		"6aceff45d66b5beceda17833b2968b1e9454612f85a93c239c96a96eead57a36da005c661e1ac83427e5724b06b7423e99731bd126719998e17ab3be9d2c1410"
+		"02533c84cd27ff029cea709f5c585dc1194bcb6df9663a7b1c6adca72895bc2f42bf8019f52975398d8d68e64b76796e93187ebb1d92a10387c5d41687d8bace"
+		"bf2705904783edd71b1b652f4acf1185289441b21ddb079de827dad3adfc68a1832a2ef50d9b4b324392267dd3ed9094eb442c4306758ba07225268026010bf5"
+		"82ce2563dc4de2b6ad0c8b0aac39003f4b0ec473854125038a77be70ec8d41301c56e970d8aef57ce13f0619f882edc582d78248178adf5576466b0215ae8b89"
+		"9d95df9b6753c87fdc3a54ed8a90923dce88b89f371235ca1d0f4c0d6737ee8db168f7ef4aea9c3bdf06d9e96236333b7ee207bdf4c3603c55be04a890837a04"
+		"1f3a8e6ec6e3f91e57a94504098e341ec44a3236608d439cd0b5840d7f1f2c589fb356f378c66439dc97ee5b176050a208bc813a2db4b023dbc5298a013aefc5"
+		"6792d62c245ff9d18228d53ae155918d0a6ccf61131cc5cdf34deb4545eb48a0f5b7e486b146af6699a756fac06e9a331a8fa944a5b0046321a40635a709bf2b"
+		"9bbff44d907d83924dc0d908ee1d21c60100ddb448687928ed760783568ec89d65fdbd077d5312683ca526d413f4bee45e814a160854b7329c83fe490a242595"
+		"fbf3b85f32b4715f1034c9737d7fab25b4b29b4c90c9919df8377c5111cfdbb43e6ad9e467ff48d0d85de6457131a4b4ca6a69e3de7d09691a9b5da24dda54f3"
+		"fdc5f5c316ddcc99842cce8af4440034f4bf6236fae7092d41a027880b8e29371a476451997d52ec9bc428308e171499e29fd008f7a9dceff044deb0e7164e77"
+		"4b248e472ef5f38893e7f71bfbfb4728e6063ba1111df7b978e81313388f5b6bc1111ca35885810ed57cc6fce9a8f53c7cf40cc360ef836bc73a937a19791174"
+		"66b2e1ab4a11cbc0be9c0741d12d5d1f7c7333f7d34ec9d8734541f0544a7242895a40eec2d46e606d751b275ac6b7d208bb5cd112dedea4652a38b134ad0617"
+		"71b9ba842108e77ad0149d3fb265a277a770d9083825b7876e8c30a1f83dec6d54da4da61dbeadf706e6a8d18d4e00fcd19985cb61c3e25439cfa68ba1f007b4"
+		"3a4d79c1f2ae8566318e0d0c0ac6e312fd9af2760258a16c1c2e864ec053ce4970520e1780c9ffa218fcbeeb803e553f29ed66da093b8498ca20e030c9dab6d2"
+		"ab214837468cc65c3a122222d482917c2ef4aae56e8b0f7625997cc5e726ae9b110ab111b123e71e123ba0b2847481d324d6f5568878613ab22aa7fe23ac40b0"
+		"4c82d9c118803804aa014d7b60d1d05c5bd4ff07e44cdedf09f8dbd3738366d87301460db172acba11fcdba924ed7bc0debeabc4ea9ed658d12abc8d529f8b9b"
+		"c736b07968db946a80c9a6e0d5ba9b412742aaa0675b09844685059cd00ff7ab088813ed6db4460004d48f61f905c373d223a7363bcc5bbcb6d02bc711ac954b"
+		"0a694c7bc40dbbb9eeef50282e63c56088786a70b1fc8720aeb993451c33a533e3703ce76e2eb8450796109cff8c2d4ba3f2e1dcd6d9397608ac967baa41b564";
+
+	int32 HexValue(char8 c) {
+		if (c >= '0' && c <= '9') {
+			return c - '0';
+		}
+		if (c >= 'a' && c <= 'f') {
+			return c - 'a' + 10;
+		}
+		if (c >= 'A' && c <= 'F') {
+			return c - 'A' + 10;
+		}
+		return -1;
+	}
 }
 
 #if (JL_SIMD_ENABLED)
@@ -25,12 +90,18 @@ namespace {
 	#define JL_RANDOM_UINT32_PTR(BUFFER) (&(BUFFER[0].v[0]))
 #endif
 
-#define JL_RANDOM_SIZE_AS_UINT32(SIZE) SIZE * 4
+#define JL_RANDOM_SIZE_AS_UINT32(SIZE) ((SIZE) * 4)
 
 
-jlRandom::jlRandom() : buffer(JL_NULL), size(0), idx(0), flags(JL_RANDOM_FLAGS_NONE) { }
+jlRandom::jlRandom() : buffer(JL_NULL), backBuffer(JL_NULL), backProgress(0), size(0), idx(0), nextStep(0), flags(JL_RANDOM_FLAGS_NONE) { }
 
 jlRandom::~jlRandom() {
+	if (flags & JL_RANDOM_FLAGS_SWAPPED) {
+		quadint128 *swap = buffer;
+		buffer = backBuffer;
+		backBuffer = swap;
+	}
+	if (backBuffer) jlFreeAligned(backBuffer);
 	if (getOwnsBuffer()) jlFreeAligned(buffer);
 }
 
@@ -41,6 +112,9 @@ bool32 jlRandom::isInit() const {
 void jlRandom::init(int32 sz) {
 	JL_ASSERT(!isInit());
 	JL_ASSERT(sz > 0);
+	if (sz < STATE_SIZE) {
+		sz = STATE_SIZE;
+	}
 	buffer = static_cast<quadint128 *>(jlAllocAligned(sz * sizeof(quadint128), 16));
 	size = sz;
 	flags = JL_RANDOM_FLAGS_OWNS_BUFFER;
@@ -48,21 +122,125 @@ void jlRandom::init(int32 sz) {
 
 void jlRandom::init(quadint128 *allocatedBuffer, int32 sz) {
 	JL_ASSERT(!isInit());
-	JL_ASSERT(sz > 0 && allocatedBuffer != JL_NULL);
+	JL_ASSERT_MSG(sz >= STATE_SIZE && allocatedBuffer != JL_NULL, "Random buffer must hold at least STATE_SIZE quads!");
 	buffer = allocatedBuffer;
 	size = sz;
 	flags = JL_RANDOM_FLAGS_NONE;
 }
 
+/// The state is the last STATE_SIZE quads of the buffer, the values
+/// before it are only outputs and get filled by the first draw
 void jlRandom::seed(uint32 s) {
-	uint32 *rptr = JL_RANDOM_UINT32_PTR(buffer);
+	uint32 *rptr = JL_RANDOM_UINT32_PTR(buffer) + JL_RANDOM_SIZE_AS_UINT32(size - STATE_SIZE);
 	rptr[0] = s;
-	int32 N32 = JL_RANDOM_SIZE_AS_UINT32(size);
+	const int32 N32 = JL_RANDOM_SIZE_AS_UINT32(STATE_SIZE);
 	for (int32 i = 1; i < N32; i++) {
 		rptr[i] = 1812433253UL * (rptr[i - 1] ^ rptr[i - 1] >> 30) + i;
 	}
-	idx = N32;
 	updateCertification(rptr);
+	restart();
+}
+
+jlResult jlRandom::setDoubleBuffered(bool32 doubleBuffered) {
+	JL_ASSERT(isInit());
+	if (doubleBuffered && !backBuffer) {
+		backBuffer = static_cast<quadint128 *>(jlAllocAligned(size * sizeof(quadint128), 16));
+		if (!backBuffer) {
+			return JL_BAD_ALLOC;
+		}
+		// fill it now so the first swap is cheap as well
+		GenerateRange(buffer + size - STATE_SIZE, backBuffer, 0, size);
+		backProgress = size;
+	} else if (!doubleBuffered && backBuffer) {
+		// hand the current values back to the buffer that was allocated first
+		if (flags & JL_RANDOM_FLAGS_SWAPPED) {
+			memcpy(backBuffer, buffer, size * sizeof(quadint128));
+			quadint128 *swap = buffer;
+			buffer = backBuffer;
+			backBuffer = swap;
+			flags &= ~JL_RANDOM_FLAGS_SWAPPED;
+		}
+		jlFreeAligned(backBuffer);
+		backBuffer = JL_NULL;
+		backProgress = 0;
+	}
+	nextStep = idx;
+	return JL_OK;
+}
+
+bool32 jlRandom::getDoubleBuffered() const {
+	return backBuffer != JL_NULL;
+}
+
+void jlRandom::swapBuffers() {
+	if (backProgress < size) {
+		GenerateRange(buffer + size - STATE_SIZE, backBuffer, backProgress, size);
+	}
+	quadint128 *swap = buffer;
+	buffer = backBuffer;
+	backBuffer = swap;
+	backProgress = 0;
+	flags ^= JL_RANDOM_FLAGS_SWAPPED;
+}
+
+void jlRandom::restart() {
+	idx = JL_RANDOM_SIZE_AS_UINT32(size);
+	if (backBuffer) {
+		backProgress = 0;
+		swapBuffers();
+		idx = 0;
+	}
+	nextStep = idx;
+}
+
+void jlRandom::jump() {
+	jump(JUMP_2_128);
+}
+
+/// Horner in the state transition, the result is the sum of the states
+/// at every step whose bit is set in the polynomial.  The state is used
+/// as a ring starting at pos so each step only rewrites one quad.
+void jlRandom::jump(const char8 *jumpString) {
+	JL_ASSERT(isInit() && jumpString != JL_NULL);
+	JL_ALIGN_16 quadint128 state[STATE_SIZE];
+	JL_ALIGN_16 quadint128 work[STATE_SIZE];
+	const int32 N32 = JL_RANDOM_SIZE_AS_UINT32(STATE_SIZE);
+	uint32 *state32 = JL_RANDOM_UINT32_PTR(state);
+	uint32 *work32 = JL_RANDOM_UINT32_PTR(work);
+	memcpy(state32, JL_RANDOM_UINT32_PTR(buffer) + JL_RANDOM_SIZE_AS_UINT32(size - STATE_SIZE), N32 * sizeof(uint32));
+	memset(work32, 0, N32 * sizeof(uint32));
+	int32 pos = 0;
+	for (const char8 *c = jumpString; *c != '\0'; ++c) {
+		int32 bits = HexValue(*c);
+		JL_ASSERT_MSG(bits >= 0, "Jump polynomial must be hex digits!");
+		for (int32 j = 0; j < 4; ++j, bits >>= 1) {
+			if (bits & 1) {
+				const int32 offset = JL_RANDOM_SIZE_AS_UINT32(pos);
+				for (int32 i = 0; i < N32; ++i) {
+					work32[i] ^= state32[(i + offset) % N32];
+				}
+			}
+			NextState(state, pos);
+			pos = (pos + 1) % STATE_SIZE;
+		}
+	}
+	memcpy(JL_RANDOM_UINT32_PTR(buffer) + JL_RANDOM_SIZE_AS_UINT32(size - STATE_SIZE), work32, N32 * sizeof(uint32));
+	restart();
+}
+
+void jlRandom::copyState(const jlRandom& src) {
+	JL_ASSERT(isInit() && src.isInit());
+	JL_ASSERT_MSG(size == src.size, "Random buffers must be the same size to copy state!");
+	memcpy(JL_RANDOM_UINT32_PTR(buffer), src.getBuffer32(), JL_RANDOM_SIZE_AS_UINT32(size) * sizeof(uint32));
+	idx = src.idx;
+	nextStep = idx;
+	if (backBuffer) {
+		// a single buffered source has nothing ahead, the next swap generates it
+		backProgress = src.backBuffer ? src.backProgress : 0;
+		if (backProgress > 0) {
+			memcpy(backBuffer, src.backBuffer, backProgress * sizeof(quadint128));
+		}
+	}
 }
 
 void jlRandom::updateCertification(uint32 *ubufferPtr) {
@@ -92,26 +270,46 @@ void jlRandom::updateCertification(uint32 *ubufferPtr) {
     }
 }
 
-uint32 jlRandom::randUint32() {
-	uint32 rnum;
-	if (idx > JL_RANDOM_SIZE_AS_UINT32(size)) {
-		GenerateRandomValues(buffer, size);
+void jlRandom::advance() {
+	const int32 size32 = JL_RANDOM_SIZE_AS_UINT32(size);
+	if (idx >= size32) {
+		if (backBuffer) {
+			swapBuffers();
+		} else {
+			GenerateRandomValues(buffer, size);
+		}
 		idx = 0;
 	}
-	uint32 *rptr = JL_RANDOM_UINT32_PTR(buffer);
-	rnum = rptr[idx++];
-	return rnum;
+	nextStep = size32;
+	if (backBuffer && backProgress < size) {
+		if ((idx & (BACK_STEP_DRAWS - 1)) == 0) {
+			const int32 to = (backProgress + BACK_STEP_QUADS < size) ? backProgress + BACK_STEP_QUADS : size;
+			GenerateRange(buffer + size - STATE_SIZE, backBuffer, backProgress, to);
+			backProgress = to;
+		}
+		const int32 next = (idx | (BACK_STEP_DRAWS - 1)) + 1;
+		if (backProgress < size && next < size32) {
+			nextStep = next;
+		}
+	}
+}
+
+uint32 jlRandom::randUint32() {
+	if (idx >= nextStep) {
+		advance();
+	}
+	return JL_RANDOM_UINT32_PTR(buffer)[idx++];
 }
 
 uint32 jlRandom::randUint32(uint32 max) {
-	float32 t = randFloat32();
-	return static_cast<uint32>(max * t);
+	uint32 rnum;
+	while (!Bounded(randUint32(), max, &rnum)) { }
+	return rnum;
 }
 
 uint32 jlRandom::randUint32(uint32 min, uint32 max) {
 	JL_ASSERT(min <= max);
-	float32 t = randFloat32();
-	return min + static_cast<uint32>((max - min) * t);
+	return min + randUint32(max - min);
 }
 
 int32 jlRandom::randInt32() {
@@ -173,9 +371,23 @@ float32 jlRandom::ToFloat32(uint32 rnum) {
 	return rnum * (1.0f / 4294967296.0f);
 }
 
+/// x * max is spread over 2^32 * max, its top half is the result and the
+/// bottom half says where in the bucket it fell.  Only bottoms below
+/// 2^32 mod max belong to a bucket with one value too many, and the
+/// modulo is only needed once a bottom is below max.
+bool32 jlRandom::Bounded(uint32 x, uint32 max, uint32 *out) {
+	const uint64 m = static_cast<uint64>(x) * max;
+	const uint32 low = static_cast<uint32>(m);
+	if (low < max && low < (0U - max) % max) {
+		return false;
+	}
+	*out = static_cast<uint32>(m >> 32);
+	return true;
+}
+
 #if (JL_SIMD_ENABLED) // SIMD version of GenerateRandomValues
 namespace {
-	quadint128 sseRecursion(quadint128 *a, quadint128 *b, quadint128 c, quadint128 d, quadint128 mask) {
+	quadint128 sseRecursion(const quadint128 *a, const quadint128 *b, quadint128 c, quadint128 d, quadint128 mask) {
 		quadint128 v, x, y, z;
 		x = _mm_load_si128(a);
 		y = _mm_srli_epi32(*b, SR1);
@@ -189,26 +401,170 @@ namespace {
 		z = _mm_xor_si128(z, y);
 		return z;
 	}
+
+	// ORs the top 23 bits of each uint32 under the exponent of 1.0f to get
+	// [1, 2), then maps that to [min, max) in place
+	void UniformFromBits(float32 *data, int32 count, float32 min, float32 max) {
+		const quadint128 one = _mm_set1_epi32(0x3f800000);
+		const quad128 oneF = _mm_set1_ps(1.0f);
+		const quad128 scale = _mm_set1_ps(max - min);
+		const quad128 offset = _mm_set1_ps(min);
+		int32 i = 0;
+		for (; i + 4 <= count; i += 4) {
+			quadint128 bits = _mm_loadu_si128(reinterpret_cast<const quadint128 *>(data + i));
+			quad128 t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(bits, 9), one)), oneF);
+			_mm_storeu_ps(data + i, _mm_add_ps(_mm_mul_ps(t, scale), offset));
+		}
+		for (; i < count; i++) {
+			quadint128 bits = _mm_cvtsi32_si128(reinterpret_cast<const int32 *>(data)[i]);
+			quad128 t = _mm_sub_ss(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(bits, 9), one)), oneF);
+			_mm_store_ss(data + i, _mm_add_ss(_mm_mul_ss(t, scale), offset));
+		}
+	}
+
+	// the high halves of x * max for four lanes from two mul_epu32, lanes
+	// whose low half falls under threshold are set to max instead
+	int32 BoundedFromBits(uint32 *data, int32 count, uint32 max, uint32 threshold) {
+		const quadint128 range = _mm_set1_epi32(max);
+		const quadint128 oddMask = _mm_set_epi32(-1, 0, -1, 0);
+		// no unsigned compare in SSE2, flip the sign bits and compare signed
+		const quadint128 bias = _mm_set1_epi32(0x80000000);
+		const quadint128 biasedThreshold = _mm_set1_epi32(threshold ^ 0x80000000U);
+		int32 rejected = 0;
+		int32 i = 0;
+		for (; i + 4 <= count; i += 4) {
+			quadint128 x = _mm_loadu_si128(reinterpret_cast<const quadint128 *>(data + i));
+			quadint128 even = _mm_mul_epu32(x, range);
+			quadint128 odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), range);
+			quadint128 high = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, oddMask));
+			quadint128 low = _mm_or_si128(_mm_andnot_si128(oddMask, even), _mm_slli_epi64(odd, 32));
+			quadint128 reject = _mm_cmplt_epi32(_mm_xor_si128(low, bias), biasedThreshold);
+			int32 rejectBits = _mm_movemask_ps(_mm_castsi128_ps(reject));
+			if (rejectBits) {
+				high = _mm_or_si128(_mm_andnot_si128(reject, high), _mm_and_si128(reject, range));
+				rejected += (rejectBits & 1) + ((rejectBits >> 1) & 1) + ((rejectBits >> 2) & 1) + (rejectBits >> 3);
+			}
+			_mm_storeu_si128(reinterpret_cast<quadint128 *>(data + i), high);
+		}
+		for (; i < count; i++) {
+			const uint64 m = static_cast<uint64>(data[i]) * max;
+			if (static_cast<uint32>(m) < threshold) {
+				data[i] = max;
+				++rejected;
+			} else {
+				data[i] = static_cast<uint32>(m >> 32);
+			}
+		}
+		return rejected;
+	}
+
+#if JL_AVX2_ENABLED
+	// two consecutive outputs from the pairs at a and b, c is the pair
+	// before them.  The second output's SL1 term is the first output
+	// shifted by SL1, and shifting by SL1 twice clears a 32 bit lane, so
+	// it is the first output's partial sum shifted instead
+	quadint256 avxRecursion(const quadint128 *a, const quadint128 *b, quadint256 c, quadint256 mask) {
+		quadint256 x = _mm256_loadu_si256(reinterpret_cast<const quadint256 *>(a));
+		quadint256 y = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<const quadint256 *>(b)), SR1);
+		quadint256 z = _mm256_xor_si256(x, _mm256_slli_si256(x, SL2));
+		z = _mm256_xor_si256(z, _mm256_and_si256(y, mask));
+		z = _mm256_xor_si256(z, _mm256_srli_si256(c, SR2));
+		quadint256 d = _mm256_permute2x128_si256(c, z, 0x21);
+		return _mm256_xor_si256(z, _mm256_slli_epi32(d, SL1));
+	}
+#endif
 }
 
 void jlRandom::GenerateRandomValues(quadint128 *buffer, int32 size) {
+	JL_ASSERT(size >= STATE_SIZE);
+	GenerateFromState(buffer + size - STATE_SIZE, buffer, size);
+}
+
+#if JL_AVX2_ENABLED
+/// Two quads per step, POS1 is 122 quads back from the end of the state
+/// so both b inputs of a pair are always written before they are read.
+/// STATE_SIZE and N - POS1 are even so pairs never straddle a phase, an
+/// odd count finishes with one SSE2 step.
+void jlRandom::GenerateFromState(const quadint128 *state, quadint128 *out, int32 count) {
+	JL_ASSERT(count >= STATE_SIZE);
+	const int32 N = STATE_SIZE;
+	const int32 pos1 = static_cast<int32>(POS1);
+	int32 i;
+	const quadint256 mask = _mm256_set_epi32(MSK4, MSK3, MSK2, MSK1, MSK4, MSK3, MSK2, MSK1);
+	quadint256 r = _mm256_loadu_si256(reinterpret_cast<const quadint256 *>(&state[N - 2]));
+	for (i = 0; i < N - pos1; i += 2) {
+		r = avxRecursion(&state[i], &state[i + pos1], r, mask);
+		_mm256_storeu_si256(reinterpret_cast<quadint256 *>(&out[i]), r);
+	}
+	for (; i < N; i += 2) {
+		r = avxRecursion(&state[i], &out[i + pos1 - N], r, mask);
+		_mm256_storeu_si256(reinterpret_cast<quadint256 *>(&out[i]), r);
+	}
+	for (; i + 2 <= count; i += 2) {
+		r = avxRecursion(&out[i - N], &out[i + pos1 - N], r, mask);
+		_mm256_storeu_si256(reinterpret_cast<quadint256 *>(&out[i]), r);
+	}
+	if (i < count) {
+		const quadint128 mask4 = _mm256_castsi256_si128(mask);
+		_mm_store_si128(&out[i], sseRecursion(&out[i - N], &out[i + pos1 - N], _mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1), mask4));
+	}
+}
+#else
+/// The first STATE_SIZE outputs come from the state, the rest continue
+/// the recursion on the new outputs.  Every state quad is read before
+/// the output that could overwrite it.
+void jlRandom::GenerateFromState(const quadint128 *state, quadint128 *out, int32 count) {
+	JL_ASSERT(count >= STATE_SIZE);
+	const int32 N = STATE_SIZE;
+	const int32 pos1 = static_cast<int32>(POS1);
 	int32 i;
 	quadint128 r, r1, r2, mask;
 	mask = _mm_set_epi32(MSK4, MSK3, MSK2, MSK1);
-	r1 = _mm_load_si128(&buffer[size - 2]);
-    r2 = _mm_load_si128(&buffer[size - 1]);
-    for (i = 0; i < size - POS1; i++) {
-		r = sseRecursion(&buffer[i], &buffer[i + POS1], r1, r2, mask);
-		_mm_store_si128(&buffer[i], r);
+	r1 = _mm_load_si128(&state[N - 2]);
+	r2 = _mm_load_si128(&state[N - 1]);
+	for (i = 0; i < N - pos1; i++) {
+		r = sseRecursion(&state[i], &state[i + pos1], r1, r2, mask);
+		_mm_store_si128(&out[i], r);
 		r1 = r2;
 		r2 = r;
-    }
-    for (; i < size; i++) {
-		r = sseRecursion(&buffer[i], &buffer[i + POS1 - size], r1, r2, mask);
-		_mm_store_si128(&buffer[i], r);
+	}
+	for (; i < N; i++) {
+		r = sseRecursion(&state[i], &out[i + pos1 - N], r1, r2, mask);
+		_mm_store_si128(&out[i], r);
 		r1 = r2;
 		r2 = r;
-    }
+	}
+	for (; i < count; i++) {
+		r = sseRecursion(&out[i - N], &out[i + pos1 - N], r1, r2, mask);
+		_mm_store_si128(&out[i], r);
+		r1 = r2;
+		r2 = r;
+	}
+}
+#endif
+
+void jlRandom::GenerateRange(const quadint128 *state, quadint128 *out, int32 from, int32 to) {
+	const int32 N = STATE_SIZE;
+	const int32 pos1 = static_cast<int32>(POS1);
+	quadint128 mask = _mm_set_epi32(MSK4, MSK3, MSK2, MSK1);
+	quadint128 r1 = _mm_load_si128((from >= 2) ? &out[from - 2] : &state[N - 2 + from]);
+	quadint128 r2 = _mm_load_si128((from >= 1) ? &out[from - 1] : &state[N - 1]);
+	for (int32 i = from; i < to; i++) {
+		const quadint128 *a = (i < N) ? &state[i] : &out[i - N];
+		const quadint128 *b = (i < N - pos1) ? &state[i + pos1] : &out[i + pos1 - N];
+		quadint128 r = sseRecursion(a, b, r1, r2, mask);
+		_mm_store_si128(&out[i], r);
+		r1 = r2;
+		r2 = r;
+	}
+}
+
+void jlRandom::NextState(quadint128 *state, int32 pos) {
+	const int32 N = STATE_SIZE;
+	quadint128 mask = _mm_set_epi32(MSK4, MSK3, MSK2, MSK1);
+	quadint128 r1 = _mm_load_si128(&state[(pos + N - 2) % N]);
+	quadint128 r2 = _mm_load_si128(&state[(pos + N - 1) % N]);
+	_mm_store_si128(&state[pos], sseRecursion(&state[pos], &state[(pos + POS1) % N], r1, r2, mask));
 }
 
 #else // FPU version of GenerateRandomValues
@@ -253,24 +609,165 @@ namespace {
 		r->v[2] = a->v[2] ^ x.v[2] ^ ((b->v[2] >> SR1) & MSK3) ^ y.v[2] ^ (d->v[2] << SL1);
 		r->v[3] = a->v[3] ^ x.v[3] ^ ((b->v[3] >> SR1) & MSK4) ^ y.v[3] ^ (d->v[3] << SL1);
 	}
+
+	union FloatBits {
+		uint32 u;
+		float32 f;
+	};
+
+	int32 BoundedFromBits(uint32 *data, int32 count, uint32 max, uint32 threshold) {
+		int32 rejected = 0;
+		for (int32 i = 0; i < count; i++) {
+			const uint64 m = static_cast<uint64>(data[i]) * max;
+			if (static_cast<uint32>(m) < threshold) {
+				data[i] = max;
+				++rejected;
+			} else {
+				data[i] = static_cast<uint32>(m >> 32);
+			}
+		}
+		return rejected;
+	}
+
+	void UniformFromBits(float32 *data, int32 count, float32 min, float32 max) {
+		const float32 scale = max - min;
+		for (int32 i = 0; i < count; i++) {
+			FloatBits bits;
+			bits.f = data[i];
+			bits.u = (bits.u >> 9) | 0x3f800000U;
+			data[i] = (bits.f - 1.0f) * scale + min;
+		}
+	}
 }
 
 void jlRandom::GenerateRandomValues(quadint128 *buffer, int32 size) {
+	JL_ASSERT(size >= STATE_SIZE);
+	GenerateFromState(buffer + size - STATE_SIZE, buffer, size);
+}
+
+void jlRandom::GenerateFromState(const quadint128 *state, quadint128 *out, int32 count) {
+	JL_ASSERT(count >= STATE_SIZE);
+	const int32 N = STATE_SIZE;
+	const int32 pos1 = static_cast<int32>(POS1);
+	quadint128 *s = const_cast<quadint128 *>(state);
 	int32 i;
 	quadint128 *r1, *r2;
 
-	r1 = &buffer[size - 2];
-	r2 = &buffer[size - 1];
-	for (i = 0; i < size - POS1; i++) {
-		fpuRecursion(&buffer[i], &buffer[i], &buffer[i + POS1], r1, r2);
+	r1 = &s[N - 2];
+	r2 = &s[N - 1];
+	for (i = 0; i < N - pos1; i++) {
+		fpuRecursion(&out[i], &s[i], &s[i + pos1], r1, r2);
 		r1 = r2;
-		r2 = &buffer[i];
+		r2 = &out[i];
 	}
-	for (; i < size; i++) {
-		fpuRecursion(&buffer[i], &buffer[i], &buffer[i + POS1 - size], r1, r2);
+	for (; i < N; i++) {
+		fpuRecursion(&out[i], &s[i], &out[i + pos1 - N], r1, r2);
 		r1 = r2;
-		r2 = &buffer[i];
+		r2 = &out[i];
 	}
+	for (; i < count; i++) {
+		fpuRecursion(&out[i], &out[i - N], &out[i + pos1 - N], r1, r2);
+		r1 = r2;
+		r2 = &out[i];
+	}
+}
+
+void jlRandom::GenerateRange(const quadint128 *state, quadint128 *out, int32 from, int32 to) {
+	const int32 N = STATE_SIZE;
+	const int32 pos1 = static_cast<int32>(POS1);
+	quadint128 *s = const_cast<quadint128 *>(state);
+	quadint128 *r1 = (from >= 2) ? &out[from - 2] : &s[N - 2 + from];
+	quadint128 *r2 = (from >= 1) ? &out[from - 1] : &s[N - 1];
+	for (int32 i = from; i < to; i++) {
+		quadint128 *a = (i < N) ? &s[i] : &out[i - N];
+		quadint128 *b = (i < N - pos1) ? &s[i + pos1] : &out[i + pos1 - N];
+		fpuRecursion(&out[i], a, b, r1, r2);
+		r1 = r2;
+		r2 = &out[i];
+	}
+}
+
+void jlRandom::NextState(quadint128 *state, int32 pos) {
+	const int32 N = STATE_SIZE;
+	fpuRecursion(&state[pos], &state[pos], &state[(pos + POS1) % N], &state[(pos + N - 2) % N], &state[(pos + N - 1) % N]);
+}
+
+#endif
+
+void jlRandom::fillUint32(uint32 *out, int32 count) {
+	JL_ASSERT(isInit() && count >= 0);
+	const int32 size32 = JL_RANDOM_SIZE_AS_UINT32(size);
+	quadint128 *state = buffer + size - STATE_SIZE;
+	while (count > 0) {
+		if (idx >= size32) {
+			const int32 quads = count / 4;
+			if (backBuffer) {
+				// bulk draws do not advance the back buffer, the swap finishes it
+				swapBuffers();
+				idx = 0;
+				continue;
+			}
+			if (quads >= STATE_SIZE && jlMemoryIsAligned(out, 0, 16)) {
+				// the buffer is spent, continue the recursion in out and keep its tail as the state
+				quadint128 *direct = reinterpret_cast<quadint128 *>(out);
+				GenerateFromState(state, direct, quads);
+				memcpy(state, direct + quads - STATE_SIZE, STATE_SIZE * sizeof(quadint128));
+				out += JL_RANDOM_SIZE_AS_UINT32(quads);
+				count -= JL_RANDOM_SIZE_AS_UINT32(quads);
+				continue;
+			}
+			GenerateRandomValues(buffer, size);
+			idx = 0;
+		}
+		const int32 n = (count < size32 - idx) ? count : size32 - idx;
+		memcpy(out, JL_RANDOM_UINT32_PTR(buffer) + idx, n * sizeof(uint32));
+		out += n;
+		count -= n;
+		idx += n;
+	}
+	nextStep = idx;
+}
+
+void jlRandom::fillUint32(uint32 *out, int32 count, uint32 max) {
+	fillUint32(out, count);
+	if (BitsToBounded(out, count, max) > 0) {
+		for (int32 i = 0; i < count; i++) {
+			if (out[i] == max) {
+				out[i] = randUint32(max);
+			}
+		}
+	}
+}
+
+void jlRandom::fillFloat32(float32 *out, int32 count, float32 min, float32 max) {
+	JL_ASSERT(min <= max);
+	fillUint32(reinterpret_cast<uint32 *>(out), count);
+	UniformFromBits(out, count, min, max);
+}
+
+void jlRandom::BitsToFloat32(float32 *data, int32 count, float32 min, float32 max) {
+	JL_ASSERT(count >= 0 && min <= max);
+	UniformFromBits(data, count, min, max);
+}
+
+int32 jlRandom::BitsToBounded(uint32 *data, int32 count, uint32 max) {
+	JL_ASSERT(count >= 0);
+	if (max == 0) {
+		memset(data, 0, count * sizeof(uint32));
+		return 0;
+	}
+	return BoundedFromBits(data, count, max, (0U - max) % max);
 }
 
-#endif 
+void jlRandom::fillVector4(jlVector4 *out, int32 count, const jlVector4& min, const jlVector4& max) {
+	fillFloat32(reinterpret_cast<float32 *>(out), count * 4);
+	const jlVector4 range = max - min;
+	for (int32 i = 0; i < count; i++) {
+		out[i].mul(range);
+		out[i].add(min);
+	}
+}
+
+void jlRandom::fillUnitVectors(jlVector4 *out, int32 count) {
+	jlDistribution::FillUnitSphere(*this, out, count);
+}
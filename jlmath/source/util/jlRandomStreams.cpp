@@ -0,0 +1,57 @@
+#include "util/jlRandomStreams.h"
+#include <new>
+
+namespace {
+	const int32 CACHE_LINE_SIZE = 64;
+	// quadint128s per cache line
+	const int32 CACHE_LINE_QUADS = CACHE_LINE_SIZE / 16;
+}
+
+jlRandomStreams::jlRandomStreams() : streams(JL_NULL), buffers(JL_NULL), count(0) { }
+
+jlRandomStreams::~jlRandomStreams() {
+	release();
+}
+
+jlResult jlRandomStreams::init(uint32 seed, int32 cnt, int32 bufferSize) {
+	JL_ASSERT(!isInit());
+	JL_ASSERT_MSG(cnt > 0 && bufferSize >= jlRandom::STATE_SIZE, "Random streams need a count and at least STATE_SIZE quads each!");
+	if (cnt <= 0 || bufferSize < jlRandom::STATE_SIZE) {
+		return JL_ERROR;
+	}
+	// round each buffer up to whole cache lines so neighbours never share one
+	const int32 stride = (bufferSize + CACHE_LINE_QUADS - 1) & ~(CACHE_LINE_QUADS - 1);
+	buffers = static_cast<quadint128 *>(jlAllocAligned(cnt * stride * sizeof(quadint128), CACHE_LINE_SIZE));
+	streams = static_cast<Stream *>(jlAllocAligned(cnt * sizeof(Stream), CACHE_LINE_SIZE));
+	if (!buffers || !streams) {
+		if (buffers) jlFreeAligned(buffers);
+		if (streams) jlFreeAligned(streams);
+		buffers = JL_NULL;
+		streams = JL_NULL;
+		return JL_BAD_ALLOC;
+	}
+	for (int32 i = 0; i < cnt; ++i) {
+		new (&streams[i].random) jlRandom();
+		streams[i].random.init(buffers + i * stride, bufferSize);
+	}
+	count = cnt;
+	streams[0].random.seed(seed);
+	for (int32 i = 1; i < cnt; ++i) {
+		streams[i].random.copyState(streams[i - 1].random);
+		streams[i].random.jump();
+	}
+	return JL_OK;
+}
+
+void jlRandomStreams::release() {
+	if (streams) {
+		for (int32 i = 0; i < count; ++i) {
+			streams[i].random.~jlRandom();
+		}
+		jlFreeAligned(streams);
+		jlFreeAligned(buffers);
+		streams = JL_NULL;
+		buffers = JL_NULL;
+	}
+	count = 0;
+}
@@ -0,0 +1,46 @@
+#include "util/jlTimer.h"
+#include <windows.h>
+#if (JL_COMPILER == JL_COMPILER_MSVC)
+	#include <intrin.h>
+#else
+	#include <x86intrin.h>
+#endif
+
+jlTimer::jlTimer() : startTicks(GetTicks()) { }
+
+void jlTimer::start() {
+	startTicks = GetTicks();
+}
+
+int64 jlTimer::getElapsedTicks() const {
+	return GetTicks() - startTicks;
+}
+
+float64 jlTimer::getElapsedSeconds() const {
+	return static_cast<float64>(getElapsedTicks()) / static_cast<float64>(GetTicksPerSecond());
+}
+
+float64 jlTimer::getElapsedMilliseconds() const {
+	return getElapsedSeconds() * 1000.0;
+}
+
+int64 jlTimer::GetTicks() {
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return ticks.QuadPart;
+}
+
+/// The frequency is fixed at boot so it is only queried once
+int64 jlTimer::GetTicksPerSecond() {
+	static int64 ticksPerSecond = 0;
+	if (ticksPerSecond == 0) {
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		ticksPerSecond = frequency.QuadPart;
+	}
+	return ticksPerSecond;
+}
+
+int64 jlTimer::GetCycles() {
+	return static_cast<int64>(__rdtsc());
+}
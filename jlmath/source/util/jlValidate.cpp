@@ -0,0 +1,89 @@
+#include "util/jlValidate.h"
+
+namespace {
+	const uint32 ABS_MASK = 0x7FFFFFFF;
+	const uint32 INF_BITS = 0x7F800000;
+	const uint32 MIN_NORMAL_BITS = 0x00800000;
+
+	JL_FORCE_INLINE uint32 AbsBits(const float32 *x) {
+		return *(const uint32 *) x & ABS_MASK;
+	}
+
+	JL_FORCE_INLINE bool32 IsBad(uint32 a) {
+		return a >= INF_BITS || (a != 0 && a < MIN_NORMAL_BITS);
+	}
+
+	JL_FORCE_INLINE void ClassifyValue(const float32 *values, int32 i, jlValidateReport *report) {
+		uint32 a = AbsBits(values + i);
+		if (IsBad(a)) {
+			if (a > INF_BITS) {
+				report->nanCount++;
+			} else if (a == INF_BITS) {
+				report->infCount++;
+			} else {
+				report->denormalCount++;
+			}
+			if (report->firstBad < 0) {
+				report->firstBad = i;
+			}
+		}
+	}
+}
+
+jlValidateReport jlValidateArray(const float32 *values, int32 count) {
+	JL_ASSERT(count >= 0);
+	JL_ASSERT(values != JL_NULL || count == 0);
+	jlValidateReport report;
+	report.firstBad = -1;
+	report.nanCount = 0;
+	report.infCount = 0;
+	report.denormalCount = 0;
+	int32 i = 0;
+#if (JL_SIMD_ENABLED)
+	// scalar until 16 byte aligned so the main loop can use aligned loads
+	while (i < count && ((uintptr_t)(values + i) & 15) != 0) {
+		ClassifyValue(values, i, &report);
+		++i;
+	}
+	const quadint128 absMask = _mm_set1_epi32(ABS_MASK);
+	const quadint128 inf = _mm_set1_epi32(INF_BITS);
+	const quadint128 minNormal = _mm_set1_epi32(MIN_NORMAL_BITS);
+	const quadint128 zero = _mm_setzero_si128();
+	// the compare masks are -1 per hit, so subtracting them counts
+	quadint128 nans = zero;
+	quadint128 infs = zero;
+	quadint128 denormals = zero;
+	for (; i + 16 <= count; i += 16) {
+		quadint128 bad = zero;
+		for (int32 j = 0; j < 16; j += 4) {
+			quadint128 a = _mm_and_si128(_mm_castps_si128(_mm_load_ps(values + i + j)), absMask);
+			quadint128 isNan = _mm_cmpgt_epi32(a, inf);
+			quadint128 isInf = _mm_cmpeq_epi32(a, inf);
+			quadint128 isDenormal = _mm_andnot_si128(_mm_cmpeq_epi32(a, zero), _mm_cmplt_epi32(a, minNormal));
+			nans = _mm_sub_epi32(nans, isNan);
+			infs = _mm_sub_epi32(infs, isInf);
+			denormals = _mm_sub_epi32(denormals, isDenormal);
+			bad = _mm_or_si128(bad, _mm_or_si128(_mm_or_si128(isNan, isInf), isDenormal));
+		}
+		if (report.firstBad < 0 && _mm_movemask_epi8(bad) != 0) {
+			for (int32 j = 0; j < 16; ++j) {
+				if (IsBad(AbsBits(values + i + j))) {
+					report.firstBad = i + j;
+					break;
+				}
+			}
+		}
+	}
+	JL_ALIGN_16 int32 lanes[12];
+	_mm_store_si128(reinterpret_cast<quadint128 *>(lanes), nans);
+	_mm_store_si128(reinterpret_cast<quadint128 *>(lanes + 4), infs);
+	_mm_store_si128(reinterpret_cast<quadint128 *>(lanes + 8), denormals);
+	report.nanCount += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	report.infCount += lanes[4] + lanes[5] + lanes[6] + lanes[7];
+	report.denormalCount += lanes[8] + lanes[9] + lanes[10] + lanes[11];
+#endif
+	for (; i < count; ++i) {
+		ClassifyValue(values, i, &report);
+	}
+	return report;
+}